@@ -9,7 +9,9 @@
 void exampleGetNext( SNMPpp::SessionHandle &sessionHandle )
 {
 	std::cout << "Perform several iterations of \"getnext\" to walk through the MIB:" << std::endl;
-	SNMPpp::PDU pdu( SNMPpp::PDU::kGetNext );
+
+	// a UniquePDU frees itself when it goes out of scope, even if an exception is thrown
+	SNMPpp::UniquePDU pdu( SNMPpp::PDU::kGetNext );
 	pdu.addNullVar( SNMPpp::OID::kInternet );	// start with this OID
 	
 	for ( size_t idx = 0; idx < 10; idx ++ )
@@ -21,9 +23,6 @@ void exampleGetNext( SNMPpp::SessionHandle &sessionHandle )
 		std::cout << pdu;
 	}
 
-	// always remember to free the PDU once done with it
-	pdu.free();
-
 	return;
 }
 
@@ -0,0 +1,144 @@
+// SNMPpp: https://sourceforge.net/p/snmppp/
+// SNMPpp project uses the MIT license. See LICENSE for details.
+// Copyright (C) 2013 Stephane Charette <stephanecharette@gmail.com>
+
+#pragma once
+
+#include <exception>
+#include <functional>
+#include <map>
+#include <unordered_set>
+#include <SNMPpp/net-snmppp.hpp>
+#include <SNMPpp/Session.hpp>
+#include <SNMPpp/PDU.hpp>
+
+
+namespace SNMPpp
+{
+    /** Send requests without waiting for the replies, and have a callback
+     * invoked once each reply arrives or the request times out.
+     *
+     * SNMPpp::sync() blocks until the agent replies, so a thread can only
+     * ever have one request in flight, and an agent which doesn't answer
+     * stalls the thread for the timeout times the number of retries.  An
+     * AsyncEngine uses net-snmp's asynchronous API instead, so a single
+     * thread can keep many requests outstanding across many sessions:
+     * @code
+     *      SNMPpp::AsyncEngine engine;
+     *      for ( size_t idx = 0; idx < sessions.size(); idx ++ )
+     *      {
+     *          SNMPpp::PDU request( SNMPpp::PDU::kGet );
+     *          request.addNullVars( oids );
+     *          engine.sendAsync( sessions[idx], request,
+     *              [idx]( const int status, SNMPpp::SessionHandle session, const SNMPpp::PDU &response )
+     *              {
+     *                  if ( status == STAT_SUCCESS )
+     *                  {
+     *                      std::cout << "device #" << idx << ":" << std::endl << response;
+     *                  }
+     *              } );
+     *      }
+     *      engine.run();   // returns once every callback has been invoked
+     * @endcode
+     *
+     * Retries and timeouts are handled by net-snmp according to the
+     * settings of each session, exactly as for SNMPpp::sync().
+     *
+     * @note
+     * - An engine is not thread-safe.  Callbacks are invoked from poll() or
+     *   run(), on the thread that calls them.
+     * - The sessions are waited on with `select()`, so their sockets must be
+     *   below `FD_SETSIZE`.  SNMPpp::Reactor has no such limit.
+     * - Closing a session with SNMPpp::closeSession() invokes the callbacks
+     *   of its outstanding requests with `STAT_TIMEOUT`.
+     */
+    class AsyncEngine
+    {
+        public:
+
+            /** Invoked once for every request, with `STAT_SUCCESS`,
+             * `STAT_TIMEOUT` or `STAT_ERROR`.  On success the response is
+             * the PDU received from the agent, which may still contain an
+             * error in `errstat`.  Otherwise the response is empty.
+             *
+             * The response belongs to net-snmp and is freed as soon as the
+             * callback returns.  Use SNMPpp::PDU::clone() to keep it.
+             */
+            typedef std::function< void( const int status, SessionHandle session, const PDU &response ) > Callback;
+
+            /** Destructor.  Requests which are still outstanding are left
+             * with net-snmp, and their callbacks are never invoked.
+             */
+            virtual ~AsyncEngine( void );
+
+            /// Engine without any outstanding requests.
+            AsyncEngine( void );
+
+            AsyncEngine( const AsyncEngine &rhs ) = delete;
+            AsyncEngine &operator=( const AsyncEngine &rhs ) = delete;
+
+            /** Send the request without waiting for the reply.  The callback
+             * is invoked later from poll() or run().  Requests can be sent
+             * from within a callback.
+             * @note The *request* PDU is automatically freed, even when an
+             * exception is thrown.
+             * @return The request ID.
+             * @throw std::invalid_argument if the request or session is NULL.
+             * @throw std::runtime_error if net-snmp cannot send the request.
+             */
+            virtual int sendAsync( SessionHandle &session, PDU &request, const Callback &callback );
+
+            /** Wait up to the given number of milliseconds for replies, read
+             * all of the ones which have arrived, and handle retries and
+             * timeouts.  Use zero to only handle what is ready, or a negative
+             * value to wait until there is something to do.
+             * @return The number of callbacks invoked.
+             * @throw std::runtime_error if `select()` fails.
+             * @throw Any exception thrown by a callback, once net-snmp is done
+             * with the reply.  The other replies are handled by the next call.
+             */
+            virtual size_t poll( const int milliseconds = -1 );
+
+            /** Call poll() until every request has completed.
+             * @see poll() for the exceptions this may throw.
+             */
+            virtual void run( void );
+
+            /// Return the number of requests sent but not yet completed.
+            virtual size_t outstanding( void ) const { return pending.size(); }
+
+            /// Return the number of sessions with at least one outstanding request.
+            virtual size_t activeSessions( void ) const { return sessions.size(); }
+
+        protected:
+
+            /// Everything net-snmp hands back to dispatch() for a single request.
+            struct Request
+            {
+                AsyncEngine *   engine;     ///< NULL once the engine has been destroyed
+                SessionHandle   session;
+                Callback        callback;
+            };
+
+            /// The `netsnmp_callback` given to net-snmp for every request.
+            static int dispatch( int operation, netsnmp_session *session, int reqid, netsnmp_pdu *pdu, void *magic );
+
+            /// Invoke the callback, and forget the request.
+            virtual void complete( Request *request, const int status, netsnmp_pdu *pdu );
+
+            /// Re-throw the exception kept by complete(), if any.  Called once net-snmp is no longer on the stack.
+            virtual void rethrowFailure( void );
+
+            /// Requests which have been sent, but not yet completed.
+            std::unordered_set< Request * > pending;
+
+            /// Number of outstanding requests on each session.
+            std::map< SessionHandle, size_t > sessions;
+
+            /// Number of callbacks invoked, used by poll().
+            size_t completed;
+
+            /// The first exception thrown by a callback, re-thrown by poll().
+            std::exception_ptr failure;
+    };
+};
@@ -0,0 +1,173 @@
+// SNMPpp: https://sourceforge.net/p/snmppp/
+// SNMPpp project uses the MIT license. See LICENSE for details.
+// Copyright (C) 2013 Stephane Charette <stephanecharette@gmail.com>
+
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <SNMPpp/net-snmppp.hpp>
+#include <SNMPpp/OIDView.hpp>
+#include <SNMPpp/Value.hpp>
+#include <SNMPpp/Varbind.hpp>
+#include <SNMPpp/Varlist.hpp>
+#include <SNMPpp/PDU.hpp>
+
+
+namespace SNMPpp
+{
+    /** The varbinds of one or more responses, copied into a few flat arrays
+     * (one per column) instead of a linked list of varbinds.  This is the
+     * layout analytics code wants:  summing a counter over thousands of
+     * rows is a loop over the `kinds()` and `numbers()` arrays, without
+     * following a single pointer or decoding a single varbind.
+     *
+     * The columns are:
+     * - the names, as one buffer of sub-identifiers, with `nameOffsets()`
+     *   giving where each row starts and ends;
+     * - the ASN type and SNMPpp::Value::EKind of each row;
+     * - a fixed-width 64-bit numeric value for each row;
+     * - the octet strings and object identifiers, in a single heap, with
+     *   `valueOffsets()` giving where each row starts and ends.
+     *
+     * The results of a walk are usually appended one response at a time:
+     * @code
+     *      SNMPpp::ColumnarBatch batch;
+     *      SNMPpp::UniquePDU pdu( SNMPpp::getBulk( sessionHandle, ifTable, 50 ) );
+     *      while ( ... )
+     *      {
+     *          batch.append( pdu );
+     *          ...
+     *      }
+     *      uint64_t total = 0;
+     *      for ( size_t row = 0; row < batch.size(); row ++ )
+     *      {
+     *          if ( batch.kind( row ) == SNMPpp::Value::kUnsigned )
+     *          {
+     *              total += batch.numbers()[row];
+     *          }
+     *      }
+     * @endcode
+     *
+     * A batch owns a copy of everything, so the PDUs can be freed as soon
+     * as they have been appended.  Rows are not bounds-checked, the same
+     * as `std::vector::operator[]`.
+     */
+    class ColumnarBatch
+    {
+        public:
+
+            /// Destructor.
+            virtual ~ColumnarBatch( void );
+
+            /// Empty batch.
+            ColumnarBatch( void );
+
+            /// Batch with a copy of every varbind in the varlist.
+            explicit ColumnarBatch( const Varlist &varlist );
+
+            /// Batch with a copy of every varbind in the PDU.
+            explicit ColumnarBatch( const PDU &pdu );
+
+            /** Make room for the given number of rows, sub-identifiers and
+             * heap bytes, so appending that much won't need to grow the
+             * columns.
+             */
+            virtual void reserve( const size_t rows, const size_t subidsPerRow = 16, const size_t heapBytes = 0 );
+
+            /// Remove every row.  The memory is kept, so the batch can be filled again without re-allocating.
+            virtual void clear( void );
+
+            /// Return the number of rows.
+            virtual size_t size( void ) const { return asnTypes.size(); }
+
+            /// Return `TRUE` if the batch has no rows.
+            virtual bool empty( void ) const { return asnTypes.empty(); }
+
+            /** Append a single varbind as a new row.
+             * @throw std::length_error if the names or the heap would go over 4 GiB.
+             */
+            virtual ColumnarBatch &append( const Varbind &vb );
+
+            /// Append every varbind in the varlist, in order.  @see append( const Varbind & )
+            virtual ColumnarBatch &append( const Varlist &varlist );
+
+            /// Append every varbind in the PDU, in order.  An empty PDU is ignored.  @see append( const Varbind & )
+            virtual ColumnarBatch &append( const PDU &pdu );
+
+            /// Return the name of a row without copying it.
+            virtual OIDView name( const size_t row ) const { return OIDView( subids.data() + offsets[row], offsets[row + 1] - offsets[row] ); }
+
+            /// Return the ASN type of a row.
+            virtual int asnType( const size_t row ) const { return asnTypes[row]; }
+
+            /// Return how the value of a row is stored.  @see SNMPpp::Value::EKind
+            virtual Value::EKind kind( const size_t row ) const { return static_cast< Value::EKind >( valueKinds[row] ); }
+
+            /** Return any numeric value as a signed 64-bit integer, or zero
+             * if the row is not numeric.  @see SNMPpp::Value::asSigned()
+             */
+            virtual int64_t asSigned( const size_t row ) const;
+
+            /** Return any numeric value as an unsigned 64-bit integer, or
+             * zero if the row is not numeric.  @see SNMPpp::Value::asUnsigned()
+             */
+            virtual uint64_t asUnsigned( const size_t row ) const;
+
+            /** Return any numeric value as a double, or zero if the row is
+             * not numeric.  @see SNMPpp::Value::asDouble()
+             */
+            virtual double asDouble( const size_t row ) const;
+
+            /// Return the octets of a Value::kBytes row, or NULL for all other kinds.  @see valueLength()
+            virtual const u_char *bytes( const size_t row ) const;
+
+            /// Return the number of octets of a Value::kBytes row, or zero for all other kinds.
+            virtual size_t valueLength( const size_t row ) const;
+
+            /// Copy the octets of a Value::kBytes row into a string.  Other kinds return an empty string.
+            virtual std::string getBytes( const size_t row ) const;
+
+            /// Return the value of a Value::kObjectId row without copying it, or an empty view for all other kinds.
+            virtual OIDView getOIDView( const size_t row ) const;
+
+            /// All of the names, one after the other.  @see nameOffsets()
+            virtual const std::vector< oid > &nameBuffer( void ) const { return subids; }
+
+            /// Where each name starts in nameBuffer().  There is one more offset than there are rows, so row `n` ends where row `n + 1` starts.
+            virtual const std::vector< uint32_t > &nameOffsets( void ) const { return offsets; }
+
+            /// The ASN type of each row.
+            virtual const std::vector< uint8_t > &asnTypeColumn( void ) const { return asnTypes; }
+
+            /// How the value of each row is stored, as a SNMPpp::Value::EKind.
+            virtual const std::vector< uint8_t > &kinds( void ) const { return valueKinds; }
+
+            /** The numeric value of each row.  Value::kSigned rows hold the
+             * value in two's complement, Value::kUnsigned rows hold the value
+             * as-is, and Value::kDouble rows hold the bits of the double.
+             * All other rows are zero.
+             */
+            virtual const std::vector< uint64_t > &numbers( void ) const { return numeric; }
+
+            /** The octet strings and object identifiers.  Object identifiers
+             * are aligned for `oid`, so there can be a few bytes of padding
+             * before them.  @see valueOffsets()
+             */
+            virtual const std::vector< u_char > &heap( void ) const { return values; }
+
+            /// Where each value starts in heap().  There is one more offset than there are rows.
+            virtual const std::vector< uint32_t > &valueOffsets( void ) const { return heapOffsets; }
+
+        protected:
+
+            std::vector< oid >      subids;
+            std::vector< uint32_t > offsets;
+            std::vector< uint8_t >  asnTypes;
+            std::vector< uint8_t >  valueKinds;
+            std::vector< uint64_t > numeric;
+            std::vector< u_char >   values;
+            std::vector< uint32_t > heapOffsets;
+    };
+};
@@ -0,0 +1,48 @@
+// SNMPpp: https://sourceforge.net/p/snmppp/
+// SNMPpp project uses the MIT license. See LICENSE for details.
+// Copyright (C) 2013 Stephane Charette <stephanecharette@gmail.com>
+
+#pragma once
+
+#include <SNMPpp/net-snmppp.hpp>
+#include <SNMPpp/OIDView.hpp>
+
+
+namespace SNMPpp
+{
+    /** Write the value of a varbind as text into a buffer provided by the
+     * caller, without going through net-snmp's `sprint_realloc_value()`.
+     * No memory is allocated, and the text is *not* NUL-terminated.
+     *
+     * The text is the same as what net-snmp would display once the
+     * "TYPE: " prefix and the quotes around strings are removed, with a few
+     * differences since MIBs are never consulted:
+     *
+     * ASN TYPE             |   EXAMPLE
+     * :-----------------   |   :------------------
+     * ASN_INTEGER          |   `-42`
+     * ASN_BOOLEAN          |   `true`
+     * Counter, Gauge       |   `4000000000`
+     * ASN_TIMETICKS        |   `(360000) 1:00:00.00`
+     * ASN_IPADDRESS        |   `192.168.1.254`
+     * ASN_OBJECT_ID        |   `.1.3.6.1.2.1.1` (always numeric)
+     * ASN_OCTET_STR        |   `eth0`, or `00 1A 2B` if not printable
+     * ASN_NULL             |   `NULL`
+     *
+     * @param [in] hint An optional RFC 2579 DISPLAY-HINT such as `"1x:"`
+     * or `"255a"` for OCTET STRING values, or `"d-2"` or `"x"` for integer
+     * values.  Use SNMPpp::displayHint() to get the hint from the MIBs.
+     * Enumeration labels such as `up(1)` are never displayed.
+     *
+     * @return The length of the text.  If this is larger than `len` then
+     * the buffer was too small and only the first `len` characters were
+     * written.  @see SNMPpp::OIDView::format()
+     */
+    size_t formatValue( const netsnmp_variable_list *vl, char *buf, const size_t len, const char *hint = NULL );
+
+    /** Return the DISPLAY-HINT that the loaded MIBs define for the given
+     * OID, or NULL if there isn't one.  This has to search the MIB tree, so
+     * it is best to call it once per column rather than once per value.
+     */
+    const char *displayHint( const OIDView &o );
+};
@@ -4,10 +4,12 @@
 
 #pragma once
 
+#include <vector>
 #include <SNMPpp/net-snmppp.hpp>
 #include <SNMPpp/Session.hpp>
 #include <SNMPpp/OID.hpp>
 #include <SNMPpp/PDU.hpp>
+#include <SNMPpp/UniquePDU.hpp>
 
 
 namespace SNMPpp
@@ -15,7 +17,8 @@ namespace SNMPpp
     /** @file
      * Several C++ helpers for some of the common net-snmp "GET" actions.
      * Remember to free the response PDUs by calling SNMPpp::PDU::free() or
-     * `netsnmp's snmp_pdu_free()`.
+     * `netsnmp's snmp_pdu_free()`, or move them into a SNMPpp::UniquePDU
+     * which frees them automatically.
      */
 
     /** Send a PDU using the given SNMPpp::SessionHandle, and wait for a reply.
@@ -29,6 +32,53 @@ namespace SNMPpp
      */
     SNMPpp::PDU sync( SNMPpp::SessionHandle &session, SNMPpp::PDU &request );
 
+    /** Same as SNMPpp::sync(), but instead of throwing when the request
+     * fails or the agent returns an error, the net-snmp status is returned
+     * and the caller decides what to do.
+     * @return `STAT_SUCCESS`, `STAT_ERROR` or `STAT_TIMEOUT` as returned by
+     * `snmp_sess_synch_response()`.  Use `snmp_sess_error()` for details.
+     * @note
+     * - The *request* PDU is automatically freed before returning.
+     * - The *response* may be set even if the agent returned an error, in
+     *   which case `errstat` and `errindex` describe the problem.  It
+     *   needs to be freed using SNMPpp::PDU::free().
+     * @throw std::invalid_argument if the request or session is NULL.
+     */
+    int trySync( SNMPpp::SessionHandle &session, SNMPpp::PDU &request, SNMPpp::PDU &response );
+
+    /// The largest SNMP message which fits in a single Ethernet frame.  Used to split requests when the session has no message size configured.
+    const size_t kDefaultMaxMessageSize = 1472;
+
+    /// Split requests according to the message sizes configured on the session.  @see SNMPpp::sessionMaxMessageSize()
+    const size_t kSessionMaxMessageSize = static_cast< size_t >( -1 );
+
+    /// The room kept for the message header when splitting requests, which is enough even for SNMPv3 with privacy.
+    const size_t kMessageOverhead = 256;
+
+    /** Estimate the number of bytes needed to BER-encode a varbind with the
+     * given OID.  The `valueSize` is the size of the encoded value
+     * including its type and length, which is 2 for the NULL values used
+     * in requests.
+     */
+    size_t estimateVarbindSize( const SNMPpp::OIDView &o, const size_t valueSize = 2 );
+
+    /** Split a set of OIDs into as few groups as possible, such that the
+     * response to a GET for each group is expected to fit in a message of
+     * `maxMessageSize` bytes.  Since the values aren't known in advance,
+     * each varbind is assumed to need `valueSize` bytes for its value.
+     * The OIDs keep their order, and every group has at least one OID.
+     */
+    std::vector< SNMPpp::VecOID > splitOids( const SNMPpp::SetOID &oids, const size_t maxMessageSize = kDefaultMaxMessageSize, const size_t valueSize = 32 );
+
+    /// Same as splitOids( const SetOID &oids, ... ) but keeps the order and duplicates of the vector.
+    std::vector< SNMPpp::VecOID > splitOids( const SNMPpp::VecOID &oids, const size_t maxMessageSize = kDefaultMaxMessageSize, const size_t valueSize = 32 );
+
+    /** Return the largest message the session is configured to send and
+     * receive, which is the smaller of net-snmp's `sndMsgMaxSize` and
+     * `rcvMsgMaxSize`, or kDefaultMaxMessageSize if neither is set.
+     */
+    size_t sessionMaxMessageSize( const SNMPpp::SessionHandle &session );
+
     /** Alias to SNMPpp::sync() for convenience, and to be consistent with the
      * various other SNMPpp::get...() calls.
      * @see SNMPpp::sync() to see additional exceptions this may throw.
@@ -61,13 +111,33 @@ namespace SNMPpp
      */
     SNMPpp::PDU getNext( SNMPpp::SessionHandle &session, SNMPpp::PDU &request );
 
-    /** Get several specific OIDs at once.
+    /** Get several specific OIDs at once.  Large sets are split across
+     * as many requests as needed so that each response fits in a message
+     * of `maxMessageSize` bytes, and all of the varbinds are then merged
+     * back into a single response PDU, in the same order as the set.  If
+     * the agent still replies with `tooBig`, that request is split in two
+     * and sent again.  The requests are sent one after the other.
+     *
+     * By default the size is the one configured on the session, see
+     * SNMPpp::sessionMaxMessageSize().  With net-snmp's defaults this is
+     * about as large as a UDP datagram, so the OIDs are sent in a single
+     * atomic request unless they cannot possibly fit.  Use a
+     * `maxMessageSize` of zero to send all of the OIDs in a single
+     * request, which will only be split if the agent replies `tooBig`.
+     * Either way, the requests never go over the size the agent is known
+     * to accept, and what is learned is kept in SNMPpp::SessionLimits so
+     * later calls don't have to run into `tooBig` again.
      * @note
      * - The response PDU needs to be freed using SNMPpp::PDU::free().
      * - This will throw if an unexpected problem occurs.
+     * @throw std::runtime_error if a single OID is too big for the agent.
      * @see SNMPpp::sync() to see additional exceptions this may throw.
+     * @see SNMPpp::splitOids()
      */
-    SNMPpp::PDU get( SNMPpp::SessionHandle &session, const SetOID &oids );
+    SNMPpp::PDU get( SNMPpp::SessionHandle &session, const SetOID &oids, const size_t maxMessageSize = kSessionMaxMessageSize );
+
+    /// Same as get( SessionHandle &session, const SetOID &oids, ... ) but keeps the order and duplicates of the vector.
+    SNMPpp::PDU get( SNMPpp::SessionHandle &session, const VecOID &oids, const size_t maxMessageSize = kSessionMaxMessageSize );
 
     /** Getbulk request, starting with the given OID.
      * @note
@@ -79,6 +149,15 @@ namespace SNMPpp
     SNMPpp::PDU getBulk( SNMPpp::SessionHandle &session, const SNMPpp::OID &o, const int maxRepetitions = 50, const int nonRepeaters = 0 );
 
     /** Getbulk request, possibly with multiple starting points.
+     *
+     * `maxRepetitions` is lowered to what the agent is known to answer in
+     * full, as recorded in SNMPpp::SessionLimits.  The limit is kept in
+     * varbinds, so a request with fewer repeating OIDs gets more
+     * repetitions.  If the agent replies
+     * `tooBig`, the request is sent again with fewer repetitions.  A
+     * response with fewer repetitions than requested and no
+     * `endOfMibView` is returned as-is, but also lowers the limit for the
+     * next request.
      * @note
      * - Getbulk requests require SNMPv2 or higher on the server.
      * - The *request* PDU is automatically freed before returning to the
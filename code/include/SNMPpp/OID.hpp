@@ -7,17 +7,25 @@
 #include <map>
 #include <set>
 #include <vector>
+#include <unordered_map>
+#include <unordered_set>
 #include <string>
 #include <ostream>
 #include <SNMPpp/net-snmppp.hpp>
+#include <SNMPpp/SmallVector.hpp>
+#include <SNMPpp/OIDView.hpp>
+#include <SNMPpp/OIDLiteral.hpp>
 
 
 namespace SNMPpp
 {
     /** Wrapper for net-snmp's OID arrays.
      *
-     * These objects are extremely small (just a std::vector) and can easily
-     * be created on the stack or as a member of another class.
+     * These objects are small and can easily be created on the stack or as
+     * a member of another class.  Up to SNMPpp::OID::kInlineSize numeric
+     * values are stored within the object itself, so typical OIDs (such as
+     * everything in MIB-2) never allocate memory on the heap.  Longer OIDs
+     * transparently spill over to the heap.
      *
      * Many other parts of SNMPpp can accept OID objects by reference, and
      * OID includes the necessary operators so they can be used wherever
@@ -27,6 +35,13 @@ namespace SNMPpp
     {
         public:
 
+            /** The number of values which can be stored in the OID before it
+             * needs to allocate memory on the heap.  This is large enough for
+             * the indexes used by the MIB-2 tables, such as the IPv4 address
+             * and port of `tcpConnTable`.
+             */
+            enum { kInlineSize = 20 };
+
             /// An enum to represent some of the common OIDs applications may need.
             enum ECommon
             {
@@ -72,6 +87,12 @@ namespace SNMPpp
             /// Copy an OID from an existing object.
             OID( const OID &oid );
 
+            /** Move an OID.  Long OIDs which are stored on the heap are
+             * transferred instead of copied.  The moved-from OID is left
+             * empty.
+             */
+            OID( OID &&oid ) noexcept;
+
             /** Initialize using a text string with the familiar numeric value.
              * For example:
              * @code
@@ -83,6 +104,12 @@ namespace SNMPpp
             /// Similar to OID( const char * const s ).
             OID( const std::string &s );
 
+            /** Similar to OID( const char * const s ), but the text does not
+             * need to be NUL-terminated.  Only the first `len` characters are
+             * parsed.
+             */
+            OID( const char * const s, const size_t len );
+
             /** Construct an OID from one of the few common locations described by SNMPpp::OID::ECommon.
              * For example:
              * @code
@@ -94,6 +121,16 @@ namespace SNMPpp
             /// Construct an OID using a net-snmp `oid` array.
             OID( const oid * o, const size_t len );
 
+            /** Construct an OID from a fixed-size `oid` array, such as the
+             * static arrays of SNMPpp::OIDLiteral.  The length is known at
+             * compile time.  For example:
+             * @code
+             *      const SNMPpp::OID o( SNMPpp::SysUpTimeOID::value );
+             * @endcode
+             */
+            template < size_t N >
+            OID( const oid ( &o )[ N ] ) { v.assign( o, N ); }
+
             /** Construct an OID from the first OID in the given variable list
              * pointer.  It is perfectly valid to use a NULL pointer.
              *
@@ -103,6 +140,9 @@ namespace SNMPpp
              */
             explicit OID( const netsnmp_variable_list *vl );
 
+            /// Copy the numeric values referenced by a SNMPpp::OIDView.
+            explicit OID( const SNMPpp::OIDView &view );
+
             /// Convert the OID to the familiar numeric format, such as `.1.3.6.1.4.x.x.x`.
             virtual operator std::string( void ) const;
 
@@ -111,6 +151,29 @@ namespace SNMPpp
              */
             virtual std::string to_str( void ) const { return operator std::string(); }
 
+            /** Write the OID in the familiar numeric format into a buffer
+             * provided by the caller, without allocating any memory.  The
+             * text is *not* NUL-terminated.
+             * For example:
+             * @code
+             *      char buffer[100];
+             *      const size_t len = oid1.format( buffer, sizeof(buffer) );
+             *      if ( len <= sizeof(buffer) )
+             *      {
+             *          fwrite( buffer, 1, len, stdout );
+             *      }
+             * @endcode
+             * @return The length of the text.  If this is larger than `len`
+             * then the buffer was too small and the text was truncated.
+             */
+            virtual size_t format( char *buf, const size_t len ) const { return view().format( buf, len ); }
+
+            /** Append the OID in the familiar numeric format to an existing
+             * string.  This is faster than `s += oid1.to_str()` since no
+             * temporary string is created.
+             */
+            virtual std::string &appendTo( std::string &s ) const { return view().appendTo( s ); }
+
             /// Convert the const OID to an array of unsigned longs (aka `oid *`) the way net-snmp needs for most API calls.
             virtual operator const oid *( void ) const;
 
@@ -123,6 +186,18 @@ namespace SNMPpp
             /// Alias to oid* for some of the original net-snmp functions.
             virtual operator const void *( void ) const { return (void*)operator const oid*(); }
 
+            /** Get a lightweight non-owning view of this OID.  The view is
+             * only valid until this OID is modified or destroyed.
+             * @see SNMPpp::OIDView
+             */
+            virtual OIDView view( void ) const { return OIDView( v.data(), v.size() ); }
+
+            /** Hash the numeric values of the OID.  This is what std::hash
+             * uses when OIDs are stored in unordered containers such as
+             * SNMPpp::UnorderedSetOID.  @see SNMPpp::OIDView::hash()
+             */
+            virtual size_t hash( void ) const { return view().hash(); }
+
             /// Clear the OID value in the object (clears the vector).
             virtual OID &clear( void );
 
@@ -189,6 +264,20 @@ namespace SNMPpp
              */
             virtual OID &operator+=( const std::string &s );
 
+            /** Parse the first `len` characters of `s` and append the numeric
+             * values to the current OID.  This is what all of the OID methods
+             * which take text end up calling.  The text is parsed in a single
+             * pass, and parsing stops at the first character which is not
+             * part of a valid OID, so `.1.3.6 junk` is the same as `.1.3.6`.
+             * For example:
+             * @code
+             *      const char *txt = "1.3.6.1.2.1.1.3.0 = Timeticks: (123) 0:00:01.23";
+             *      OID oid1;
+             *      oid1.append( txt, 17 );     // == .1.3.6.1.2.1.1.3.0
+             * @endcode
+             */
+            virtual OID &append( const char * const s, const size_t len );
+
             /** Return the value at the specified index into the OID vector.
              * For example:
              * @code
@@ -208,9 +297,22 @@ namespace SNMPpp
             /// Reuse an OID object by setting the numeric values as indicated.
             virtual OID &set( const std::string &s );
 
-            /// Reuse an OID object by setting the numeric values as indicated.
+            /// Reuse an OID object by setting the numeric values as indicated.  No text is parsed.
             virtual OID &set( const SNMPpp::OID::ECommon &location );
 
+            /** Return a view of the pre-computed numeric values for one of the
+             * common locations.  The view references static memory, so it is
+             * valid for the lifetime of the application.  The view is empty
+             * for SNMPpp::OID::kInvalid and SNMPpp::OID::kEmpty.
+             */
+            static OIDView common( const SNMPpp::OID::ECommon location );
+
+            /// Alias for SNMPpp::OID::set().
+            virtual OID &operator=( const OID &rhs ) { return set( rhs ); }
+
+            /// Move the numeric values from `rhs`, which is left empty.  @see OID( OID &&oid )
+            virtual OID &operator=( OID &&rhs ) noexcept;
+
             /// Alias for SNMPpp::OID::set().
             virtual OID &operator=( const std::string &s ) { return set( s ); }
 
@@ -310,8 +412,23 @@ namespace SNMPpp
 
         protected:
 
-            std::vector < oid > v;
+            SmallVector < oid, kInlineSize > v;
     };
+};
+
+
+namespace std
+{
+    /// Allow SNMPpp::OID to be used as the key in std::unordered_map and std::unordered_set.
+    template <> struct hash< SNMPpp::OID >
+    {
+        size_t operator()( const SNMPpp::OID &o ) const { return o.hash(); }
+    };
+};
+
+
+namespace SNMPpp
+{
 
     /// A std::set of OIDs.
     typedef std::set   <OID> SetOID;
@@ -321,6 +438,21 @@ namespace SNMPpp
 
     /// A std::map where the OID is the key and the value is a net-snmp variable list.  This is used by SNMPpp::PDU and SNMPpp::Varlist.
     typedef std::map < SNMPpp::OID, netsnmp_variable_list *> MapOidVarList;
+
+    /** A std::unordered_set of OIDs.  Lookups are O(1) instead of the
+     * O(log n) of SNMPpp::SetOID, but the OIDs are not kept in order.
+     */
+    typedef std::unordered_set <OID> UnorderedSetOID;
+
+    /// Same as SNMPpp::MapOidVarList, but using a hash table.  @see SNMPpp::Varlist::getMap( SNMPpp::UnorderedMapOidVarList &m ) const
+    typedef std::unordered_map < SNMPpp::OID, netsnmp_variable_list *> UnorderedMapOidVarList;
+
+    /** Same as SNMPpp::OID::operator+( const oid o ), but used when the
+     * OID on the left is a temporary.  The temporary is re-used instead of
+     * copied, so expressions such as `o.parent() + 5` or `o + 1 + 2` only
+     * create a single OID.
+     */
+    OID operator+( OID &&lhs, const oid rhs );
 };
 
 
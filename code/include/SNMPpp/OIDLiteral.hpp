@@ -0,0 +1,56 @@
+// SNMPpp: https://sourceforge.net/p/snmppp/
+// SNMPpp project uses the MIT license. See LICENSE for details.
+// Copyright (C) 2013 Stephane Charette <stephanecharette@gmail.com>
+
+#pragma once
+
+#include <SNMPpp/net-snmppp.hpp>
+#include <SNMPpp/OIDView.hpp>
+
+
+namespace SNMPpp
+{
+    /** An OID which is known at compile time.  The numeric values are
+     * stored in a static array built by the compiler, so using the OID
+     * costs nothing at runtime:  there is no text to parse and no memory to
+     * allocate.
+     *
+     * For example:
+     * @code
+     *      typedef SNMPpp::OIDLiteral< 1, 3, 6, 1, 2, 1, 2, 2, 1, 10 > IfInOctets;
+     *
+     *      // pass the static array directly to net-snmp
+     *      snmp_add_null_var( pdu, IfInOctets::value, IfInOctets::length );
+     *
+     *      // compare against varbinds without creating an OID
+     *      if ( SNMPpp::OIDView( vl ).isChildOf( IfInOctets::view() ) ) ...
+     *
+     *      // or create a normal OID when one is needed
+     *      const SNMPpp::OID o( IfInOctets::value );
+     * @endcode
+     */
+    template < oid First, oid... Rest >
+    struct OIDLiteral
+    {
+        /// The number of numeric values in the OID.
+        static constexpr size_t length = 1 + sizeof...( Rest );
+
+        /// The numeric values of the OID.
+        static constexpr oid value[ 1 + sizeof...( Rest ) ] = { First, Rest... };
+
+        /// Return a view of the static array.
+        static OIDView view( void ) { return OIDView( value, length ); }
+    };
+
+    template < oid First, oid... Rest > constexpr size_t    OIDLiteral< First, Rest... >::length;
+    template < oid First, oid... Rest > constexpr oid       OIDLiteral< First, Rest... >::value[];
+
+    /// Well-known OIDs which are needed by SNMPpp itself and by many applications. @{
+    typedef OIDLiteral< 1, 3, 6, 1 >                        InternetOID;            ///< .1.3.6.1
+    typedef OIDLiteral< 1, 3, 6, 1, 2, 1 >                  Mib2OID;                ///< .1.3.6.1.2.1
+    typedef OIDLiteral< 1, 3, 6, 1, 4 >                     PrivateEnterpriseOID;   ///< .1.3.6.1.4
+    typedef OIDLiteral< 1, 3, 6, 1, 4, 1 >                  EnterprisesOID;         ///< .1.3.6.1.4.1
+    typedef OIDLiteral< 1, 3, 6, 1, 2, 1, 1, 3, 0 >         SysUpTimeOID;           ///< .1.3.6.1.2.1.1.3.0
+    typedef OIDLiteral< 1, 3, 6, 1, 6, 3, 1, 1, 4, 1, 0 >   SnmpTrapOID;            ///< .1.3.6.1.6.3.1.1.4.1.0
+    /// @}
+};
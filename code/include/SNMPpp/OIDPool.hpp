@@ -0,0 +1,138 @@
+// SNMPpp: https://sourceforge.net/p/snmppp/
+// SNMPpp project uses the MIT license. See LICENSE for details.
+// Copyright (C) 2013 Stephane Charette <stephanecharette@gmail.com>
+
+#pragma once
+
+#include <stdint.h>
+#include <mutex>
+#include <vector>
+#include <unordered_map>
+#include <SNMPpp/OIDView.hpp>
+#include <SNMPpp/OID.hpp>
+
+
+namespace SNMPpp
+{
+    /** A pool of de-duplicated OIDs.  Applications which need to remember
+     * the same OIDs over and over again (for example, `ifInOctets.N` for
+     * thousands of devices) can intern the OIDs and store the small integer
+     * handle instead of a complete SNMPpp::OID.
+     *
+     * Every OID in the pool is stored as a link to its parent, so all OIDs
+     * share the memory used by their common prefixes.  Storing a new OID
+     * such as `ifInOctets.12` when `ifInOctets.11` is already in the pool
+     * costs a single node.
+     *
+     * Within the same pool, two handles are equal if and only if the OIDs
+     * are equal, so comparing interned OIDs is a single integer comparison.
+     * Note that the numeric order of handles does *not* match the order of
+     * the OIDs.
+     *
+     * For example:
+     * @code
+     *      SNMPpp::OIDPool &pool = SNMPpp::OIDPool::global();
+     *      const SNMPpp::OIDPool::Handle h1 = pool.intern( SNMPpp::OID( ".1.3.6.1.2.1.2.2.1.10.12" ) );
+     *      const SNMPpp::OIDPool::Handle h2 = pool.intern( SNMPpp::OIDView( vl ) );
+     *      if ( h1 == h2 ) ...
+     *      std::cout << pool.resolve( h1 ) << std::endl;
+     * @endcode
+     *
+     * @note OIDPool is thread-safe.  OIDs can be interned and resolved
+     * from several threads at the same time.  OIDs are never removed from
+     * the pool, so a handle remains valid for as long as the pool exists.
+     */
+    class OIDPool
+    {
+        public:
+
+            /// Interned OIDs are referenced through a 32-bit handle.
+            typedef uint32_t Handle;
+
+            /// The handle of the empty OID.  This is always valid in every pool.
+            static const Handle kEmpty = 0;
+
+            /// Returned by find() when an OID is not in the pool.
+            static const Handle kNotFound = 0xFFFFFFFF;
+
+            /// Destructor.
+            virtual ~OIDPool( void );
+
+            /// Constructor.  The new pool only contains the empty OID.
+            OIDPool( void );
+
+            /** Return the pool shared by the entire application.  This is
+             * created the first time it is needed and is never destroyed.
+             */
+            static OIDPool &global( void );
+
+            /** Add an OID to the pool (if it isn't already there) and return
+             * its handle.
+             * @throw std::invalid_argument if a numeric value does not fit in 32 bits, which is not valid in SNMP.
+             * @throw std::length_error if the pool is full, which would require more than 4 billion different nodes.
+             */
+            virtual Handle intern( const SNMPpp::OIDView &o );
+
+            /// Same as intern( const SNMPpp::OIDView &o ).
+            virtual Handle intern( const SNMPpp::OID &o ) { return intern( o.view() ); }
+
+            /// Return the handle of an OID which was previously interned, or SNMPpp::OIDPool::kNotFound.
+            virtual Handle find( const SNMPpp::OIDView &o ) const;
+
+            /// Same as find( const SNMPpp::OIDView &o ).
+            virtual Handle find( const SNMPpp::OID &o ) const { return find( o.view() ); }
+
+            /// Return the OID which corresponds to the handle.
+            /// @throw std::invalid_argument if the handle is not valid in this pool.
+            virtual OID resolve( const Handle h ) const;
+
+            /** Copy the numeric values of the OID into a buffer provided by
+             * the caller.  This does not allocate any memory.
+             * @return The length of the OID.  If this is larger than `len`
+             * then nothing was copied and the call should be repeated with a
+             * larger buffer.
+             * @throw std::invalid_argument if the handle is not valid in this pool.
+             */
+            virtual size_t resolve( const Handle h, oid *buf, const size_t len ) const;
+
+            /// Return the number of numeric values in the OID.
+            /// @throw std::invalid_argument if the handle is not valid in this pool.
+            virtual size_t length( const Handle h ) const;
+
+            /// Return the handle of the immediate parent.  The parent of SNMPpp::OIDPool::kEmpty is itself.
+            /// @throw std::invalid_argument if the handle is not valid in this pool.
+            virtual Handle parent( const Handle h ) const;
+
+            /** Same rules as SNMPpp::OID::isChildOf(), but without having
+             * to resolve either of the OIDs.
+             * @throw std::invalid_argument if either of the handles is not valid in this pool.
+             */
+            virtual bool isChildOf( const Handle child, const Handle h ) const;
+
+            /// Return the number of nodes in the pool.  This is the number of unique OIDs and parts of OIDs that have been interned.
+            virtual size_t size( void ) const;
+
+            /// Return an estimate of the number of bytes of memory used by the pool.
+            virtual size_t memoryUsage( void ) const;
+
+        protected:
+
+            /// Every node stores a single numeric value and a link to the node of the parent OID.
+            struct Node
+            {
+                Handle      parent;
+                uint32_t    value;
+                uint32_t    depth;
+            };
+
+            /// Must be called with the mutex already locked.
+            void validate( const Handle h ) const;
+
+            /// Key used to find the child of a node:  the parent handle in the top 32 bits, and the numeric value in the bottom 32 bits.
+            static uint64_t makeKey( const Handle p, const oid o ) { return ( static_cast<uint64_t>( p ) << 32 ) | static_cast<uint32_t>( o ); }
+
+            mutable std::mutex                      mutex;
+            std::vector< Node >                     nodes;
+            std::unordered_map< uint64_t, Handle >  children;
+    };
+};
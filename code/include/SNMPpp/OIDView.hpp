@@ -0,0 +1,123 @@
+// SNMPpp: https://sourceforge.net/p/snmppp/
+// SNMPpp project uses the MIT license. See LICENSE for details.
+// Copyright (C) 2013 Stephane Charette <stephanecharette@gmail.com>
+
+#pragma once
+
+#include <string>
+#include <ostream>
+#include <functional>
+#include <SNMPpp/net-snmppp.hpp>
+
+
+namespace SNMPpp
+{
+    /** A read-only view of an OID which does not own the memory it refers
+     * to.  This is nothing more than a pointer and a length, so it can be
+     * used to compare the name of a net-snmp varbind against an OID without
+     * copying any of the numeric values.
+     *
+     * For example:
+     * @code
+     *      SNMPpp::OID o( ".1.3.6.1.2.1.1.3.0" );
+     *      for ( netsnmp_variable_list *p = vl; p != NULL; p = p->next_variable )
+     *      {
+     *          if ( SNMPpp::OIDView( p ) == o.view() ) ...
+     *      }
+     * @endcode
+     *
+     * @note The view is only valid for as long as the memory it references
+     * (such as the SNMPpp::OID or the netsnmp_variable_list) exists and is
+     * not modified.
+     */
+    class OIDView
+    {
+        public:
+
+            /// Empty view.
+            OIDView( void ) : ptr( NULL ), length( 0 ) { return; }
+
+            /// View of a net-snmp `oid` array.
+            OIDView( const oid *o, const size_t len ) : ptr( o ), length( o == NULL ? 0 : len ) { return; }
+
+            /** View of the name of a net-snmp varbind.  It is perfectly valid
+             * to use a NULL pointer, which results in an empty view.
+             */
+            explicit OIDView( const netsnmp_variable_list *vl ) :
+                ptr   ( vl == NULL ? NULL : vl->name        ),
+                length( vl == NULL ? 0    : vl->name_length )
+            {
+                return;
+            }
+
+            /// Return the address of the first numeric value, or NULL if the view is empty.
+            const oid *data( void ) const { return ptr; }
+
+            /// Return the number of numeric values in the view.
+            size_t size( void ) const { return length; }
+
+            /// Return `TRUE` if the view is completely empty.
+            bool empty( void ) const { return length == 0; }
+
+            /// Return the value at the specified index.  Unlike SNMPpp::OID::operator[]() the index is not checked.
+            oid operator[]( const size_t idx ) const { return ptr[idx]; }
+
+            /// Comparison operators, using the same ordering as SNMPpp::OID. @{
+            bool operator==( const OIDView &rhs ) const;
+            bool operator!=( const OIDView &rhs ) const { return ! operator==( rhs ); }
+            bool operator< ( const OIDView &rhs ) const { return compare( rhs ) <  0; }
+            bool operator<=( const OIDView &rhs ) const { return compare( rhs ) <= 0; }
+            bool operator> ( const OIDView &rhs ) const { return compare( rhs ) >  0; }
+            bool operator>=( const OIDView &rhs ) const { return compare( rhs ) >= 0; }
+            /// @}
+
+            /// Return a negative value, zero, or a positive value if this view sorts before, the same as, or after `rhs`.
+            int compare( const OIDView &rhs ) const;
+
+            /// Same rules as SNMPpp::OID::isChildOf().
+            bool isChildOf( const OIDView &rhs ) const;
+
+            /// Same rules as SNMPpp::OID::isParentOf().
+            bool isParentOf( const OIDView &rhs ) const { return rhs.isChildOf( *this ); }
+
+            /** Hash the numeric values.  Two views (or OIDs) with the same
+             * values always return the same hash, regardless of where the
+             * values are stored.
+             */
+            size_t hash( void ) const;
+
+            /** Write the OID in the familiar numeric format (such as
+             * `.1.3.6.1.4`) into a buffer provided by the caller.  No
+             * memory is allocated, and the text is *not* NUL-terminated.
+             * @return The length of the text.  If this is larger than `len`
+             * then the buffer was too small and only the first `len`
+             * characters were written.
+             */
+            size_t format( char *buf, const size_t len ) const;
+
+            /// Append the OID in the familiar numeric format to the end of `s`.  @see format()
+            std::string &appendTo( std::string &s ) const;
+
+            /// Convert the OID to the familiar numeric format, such as `.1.3.6.1.4`.
+            std::string to_str( void ) const { std::string s; return appendTo( s ); }
+
+        protected:
+
+            const oid * ptr;
+            size_t      length;
+    };
+};
+
+
+/// Can be used to log or display an OID view.  This does not allocate any memory.
+std::ostream &operator<<( std::ostream &os, const SNMPpp::OIDView &o );
+
+
+namespace std
+{
+    /// Allow SNMPpp::OIDView to be used as the key in std::unordered_map and std::unordered_set.
+    template <> struct hash< SNMPpp::OIDView >
+    {
+        size_t operator()( const SNMPpp::OIDView &v ) const { return v.hash(); }
+    };
+};
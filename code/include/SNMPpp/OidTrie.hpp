@@ -0,0 +1,308 @@
+// SNMPpp: https://sourceforge.net/p/snmppp/
+// SNMPpp project uses the MIT license. See LICENSE for details.
+// Copyright (C) 2013 Stephane Charette <stephanecharette@gmail.com>
+
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <SNMPpp/OIDView.hpp>
+#include <SNMPpp/OID.hpp>
+
+
+namespace SNMPpp
+{
+    /** A container which stores values keyed by OID as a tree, where each
+     * level of the tree is one numeric value of the OID.
+     *
+     * Unlike SNMPpp::MapOidVarList or a std::map keyed by SNMPpp::OID, this
+     * makes it cheap to ask which registered OID is the closest parent of
+     * an arbitrary OID.  For example, to dispatch the varbinds of a walk or
+     * a trap to handlers registered for various subtrees:
+     * @code
+     *      SNMPpp::OidTrie<Handler *> handlers;
+     *      handlers.insert( SNMPpp::OID( ".1.3.6.1.2.1.2"  ), &interfacesHandler );
+     *      handlers.insert( SNMPpp::OID( ".1.3.6.1.2.1.25" ), &hostResourcesHandler );
+     *      ...
+     *      for ( netsnmp_variable_list *p = vl; p != NULL; p = p->next_variable )
+     *      {
+     *          Handler **h = handlers.longestPrefix( SNMPpp::OIDView( p ) );
+     *          if ( h ) (*h)->process( p );
+     *      }
+     * @endcode
+     *
+     * Finding the longest prefix costs a single descent of the tree no
+     * matter how many OIDs have been inserted, instead of calling
+     * SNMPpp::OID::isChildOf() once per registered OID.
+     *
+     * @note OidTrie is not thread-safe.  Concurrent reads are fine, but
+     * insert(), erase() and clear() must not run at the same time as any
+     * other call.
+     */
+    template < typename T >
+    class OidTrie
+    {
+        public:
+
+            /// Create an empty trie.
+            OidTrie( void ) : count( 0 ) { return; }
+
+            /// Return the number of OIDs which have a value in the trie.
+            size_t size( void ) const { return count; }
+
+            /// Return `TRUE` if no values have been inserted.
+            bool empty( void ) const { return count == 0; }
+
+            /// Remove all values.
+            void clear( void )
+            {
+                root.children.clear();
+                root.value.reset();
+                count = 0;
+            }
+
+            /** Store a value for the given OID.  If the OID already has a
+             * value, it is replaced.
+             * @return A reference to the value stored in the trie.
+             */
+            T &insert( const SNMPpp::OIDView &key, const T &value )
+            {
+                Node *node = &root;
+                for ( size_t idx = 0; idx < key.size(); idx ++ )
+                {
+                    node = node->findOrCreateChild( key[idx] );
+                }
+
+                if ( node->value )
+                {
+                    *node->value = value;
+                }
+                else
+                {
+                    node->value.reset( new T( value ) );
+                    count ++;
+                }
+
+                return *node->value;
+            }
+
+            /// Same as insert( const SNMPpp::OIDView &key, const T &value ).
+            T &insert( const SNMPpp::OID &key, const T &value ) { return insert( key.view(), value ); }
+
+            /** Remove the value stored for the given OID.  Values stored for
+             * children of the OID are not affected.
+             * @return `TRUE` if a value was removed.
+             */
+            bool erase( const SNMPpp::OIDView &key )
+            {
+                // remember the path so branches which become empty can be pruned
+                std::vector< Node * > path;
+                path.reserve( key.size() + 1 );
+                Node *node = &root;
+                path.push_back( node );
+                for ( size_t idx = 0; idx < key.size(); idx ++ )
+                {
+                    node = node->findChild( key[idx] );
+                    if ( node == NULL )
+                    {
+                        return false;
+                    }
+                    path.push_back( node );
+                }
+
+                if ( ! node->value )
+                {
+                    return false;
+                }
+                node->value.reset();
+                count --;
+
+                for ( size_t idx = key.size(); idx > 0; idx -- )
+                {
+                    Node *child = path[idx];
+                    if ( child->value || ! child->children.empty() )
+                    {
+                        break;
+                    }
+                    path[idx - 1]->eraseChild( key[idx - 1] );
+                }
+
+                return true;
+            }
+
+            /// Same as erase( const SNMPpp::OIDView &key ).
+            bool erase( const SNMPpp::OID &key ) { return erase( key.view() ); }
+
+            /// Return a pointer to the value stored for exactly this OID, or `NULL` if there is no such value.
+            T *find( const SNMPpp::OIDView &key )
+            {
+                return const_cast< T * >( static_cast< const OidTrie * >( this )->find( key ) );
+            }
+
+            /// Return a pointer to the value stored for exactly this OID, or `NULL` if there is no such value.
+            const T *find( const SNMPpp::OIDView &key ) const
+            {
+                const Node *node = &root;
+                for ( size_t idx = 0; node != NULL && idx < key.size(); idx ++ )
+                {
+                    node = node->findChild( key[idx] );
+                }
+
+                return ( node == NULL ? NULL : node->value.get() );
+            }
+
+            /// Same as find( const SNMPpp::OIDView &key ).  @{
+            T *         find( const SNMPpp::OID &key )       { return find( key.view() ); }
+            const T *   find( const SNMPpp::OID &key ) const { return find( key.view() ); }
+            /// @}
+
+            /** Find the value stored for the longest OID which is either the
+             * same as `key` or a parent of `key`.  For example, if values
+             * were inserted for `.1.3.6.1.2.1` and `.1.3.6.1.2.1.2`, then
+             * looking up `.1.3.6.1.2.1.2.2.1.10.3` returns the value for
+             * `.1.3.6.1.2.1.2`.
+             * @param [in] key The OID to look up.
+             * @param [out] matchedLength If not `NULL`, set to the number of
+             * numeric values in the OID which matched.
+             * @return `NULL` if no value is stored for `key` or any of its parents.
+             */
+            T *longestPrefix( const SNMPpp::OIDView &key, size_t *matchedLength = NULL )
+            {
+                return const_cast< T * >( static_cast< const OidTrie * >( this )->longestPrefix( key, matchedLength ) );
+            }
+
+            /// Same as the non-const version of longestPrefix().
+            const T *longestPrefix( const SNMPpp::OIDView &key, size_t *matchedLength = NULL ) const
+            {
+                const T *best   = root.value.get();
+                size_t bestLen  = 0;
+                const Node *node = &root;
+                for ( size_t idx = 0; idx < key.size(); idx ++ )
+                {
+                    node = node->findChild( key[idx] );
+                    if ( node == NULL )
+                    {
+                        break;
+                    }
+                    if ( node->value )
+                    {
+                        best    = node->value.get();
+                        bestLen = idx + 1;
+                    }
+                }
+
+                if ( matchedLength != NULL )
+                {
+                    *matchedLength = ( best == NULL ? 0 : bestLen );
+                }
+
+                return best;
+            }
+
+            /// Same as longestPrefix( const SNMPpp::OIDView &key, size_t *matchedLength ).  @{
+            T *         longestPrefix( const SNMPpp::OID &key, size_t *matchedLength = NULL )       { return longestPrefix( key.view(), matchedLength ); }
+            const T *   longestPrefix( const SNMPpp::OID &key, size_t *matchedLength = NULL ) const { return longestPrefix( key.view(), matchedLength ); }
+            /// @}
+
+            /** Call `f( const SNMPpp::OID &key, const T &value )` for every
+             * value stored at `prefix` or below it, in the same order as
+             * SNMPpp::SetOID would sort the OIDs.  Use an empty prefix to
+             * visit every value in the trie.
+             * For example:
+             * @code
+             *      trie.forEach( SNMPpp::OID( ".1.3.6.1.2.1.2.2" ).view(),
+             *          []( const SNMPpp::OID &o, const int &i ) { std::cout << o << "=" << i << std::endl; } );
+             * @endcode
+             */
+            template < typename F >
+            void forEach( const SNMPpp::OIDView &prefix, F f ) const
+            {
+                const Node *node = &root;
+                for ( size_t idx = 0; node != NULL && idx < prefix.size(); idx ++ )
+                {
+                    node = node->findChild( prefix[idx] );
+                }
+
+                if ( node != NULL )
+                {
+                    std::vector< oid > path( prefix.data(), prefix.data() + prefix.size() );
+                    visit( node, path, f );
+                }
+            }
+
+            /// Same as forEach( const SNMPpp::OIDView &prefix, F f ).
+            template < typename F >
+            void forEach( const SNMPpp::OID &prefix, F f ) const { forEach( prefix.view(), f ); }
+
+        protected:
+
+            struct Node
+            {
+                /// Children are kept sorted by their numeric value so they can be found with a binary search.
+                typedef std::pair< oid, std::unique_ptr< Node > > Child;
+
+                std::vector< Child >    children;
+                std::unique_ptr< T >    value;
+
+                static bool lessThan( const Child &lhs, const oid rhs ) { return lhs.first < rhs; }
+
+                const Node *findChild( const oid o ) const
+                {
+                    typename std::vector< Child >::const_iterator iter = std::lower_bound( children.begin(), children.end(), o, lessThan );
+                    if ( iter == children.end() || iter->first != o )
+                    {
+                        return NULL;
+                    }
+
+                    return iter->second.get();
+                }
+
+                Node *findChild( const oid o )
+                {
+                    return const_cast< Node * >( static_cast< const Node * >( this )->findChild( o ) );
+                }
+
+                Node *findOrCreateChild( const oid o )
+                {
+                    typename std::vector< Child >::iterator iter = std::lower_bound( children.begin(), children.end(), o, lessThan );
+                    if ( iter == children.end() || iter->first != o )
+                    {
+                        iter = children.insert( iter, Child( o, std::unique_ptr< Node >( new Node ) ) );
+                    }
+
+                    return iter->second.get();
+                }
+
+                void eraseChild( const oid o )
+                {
+                    typename std::vector< Child >::iterator iter = std::lower_bound( children.begin(), children.end(), o, lessThan );
+                    if ( iter != children.end() && iter->first == o )
+                    {
+                        children.erase( iter );
+                    }
+                }
+            };
+
+            template < typename F >
+            static void visit( const Node *node, std::vector< oid > &path, F &f )
+            {
+                if ( node->value )
+                {
+                    const SNMPpp::OID key( path.empty() ? NULL : &path[0], path.size() );
+                    f( key, static_cast< const T & >( *node->value ) );
+                }
+
+                for ( size_t idx = 0; idx < node->children.size(); idx ++ )
+                {
+                    path.push_back( node->children[idx].first );
+                    visit( node->children[idx].second.get(), path, f );
+                    path.pop_back();
+                }
+            }
+
+            Node    root;
+            size_t  count;
+    };
+};
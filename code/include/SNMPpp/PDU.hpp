@@ -5,6 +5,7 @@
 #pragma once
 
 #include <map>
+#include <memory>
 #include <string>
 #include <SNMPpp/net-snmppp.hpp>
 #include <SNMPpp/OID.hpp>
@@ -63,6 +64,26 @@ namespace SNMPpp
             /// Inherit a PDU from net-snmp.  It is valid for `p` to be NULL.
             PDU( netsnmp_pdu *p );
 
+            /** Copy the PDU object.  Both objects reference the same net-snmp
+             * structure, which must only be freed once.  Use clone() to make
+             * a deep copy.  The source is left untouched, and both objects
+             * keep appending in O(1): each one only trusts where it last saw
+             * the end of the varlist if the other one hasn't appended to or
+             * replaced the varbinds since.
+             */
+            PDU( const PDU &rhs );
+
+            /** Move the PDU object.  The moved-from object is cleared, so only
+             * the new object references the net-snmp structure.
+             */
+            PDU( PDU &&rhs ) noexcept;
+
+            /// Copy the PDU object.  The previous net-snmp structure is *not* freed.  @see PDU( const PDU &rhs )
+            virtual PDU &operator=( const PDU &rhs );
+
+            /// Move the PDU object.  The previous net-snmp structure is *not* freed.  @see PDU( PDU &&rhs )
+            virtual PDU &operator=( PDU &&rhs ) noexcept;
+
             /// Free up the underlying net-snmp structure using `snmp_free_pdu()`.
             virtual void free( void );
 
@@ -87,8 +108,11 @@ namespace SNMPpp
              */
             virtual PDU clone( void ) const;
 
-            /// Convert the PDU to a net-snmp pointer for passing into the net-snmp API.
-            virtual operator netsnmp_pdu*( void ) { return pdu; }
+            /** Convert the PDU to a net-snmp pointer for passing into the
+             * net-snmp API.  Since net-snmp may then replace the variable
+             * list, the position of the last varbind is forgotten.
+             */
+            virtual operator netsnmp_pdu*( void ) { tail = NULL; head = NULL; return pdu; }
 
             /// Get access to the varlist for this PDU.  This will throw if the PDU is empty.
             virtual const SNMPpp::Varlist varlist( void ) const;
@@ -96,12 +120,31 @@ namespace SNMPpp
             /// Get access to the varlist for this PDU.  This will throw if the PDU is empty.
             virtual SNMPpp::Varlist varlist( void );
 
+            /** Index the OIDs in the variable list so lookups by OID run in
+             * O(1).  The Varlist objects returned by varlist() share the
+             * index, so for example `pdu.varlist().getLong( o )` no longer
+             * needs to walk the linked list.  Typically called once on a
+             * response before reading many values out of it.  Adding OIDs
+             * or replacing the variable list drops the index.
+             * @see SNMPpp::Varlist::buildIndex()
+             */
+            virtual PDU &buildIndex( void );
+
             /// Get access to the varlist for this PDU.  This will throw if the PDU is empty.
             virtual operator netsnmp_variable_list *( void );
 
-            /// Get access to a specific varlist for this PDU.
+            /// Get access to a specific varlist for this PDU.  Runs in O(n).  @see begin()
             virtual netsnmp_variable_list * operator[]( const size_t idx );
 
+            /** Iterate through the varbinds of this PDU.  Unlike varlist(),
+             * this does not throw if the PDU is empty.
+             * @see SNMPpp::Varlist::begin()
+             */
+            virtual Varlist::const_iterator begin( void ) const { return Varlist::const_iterator( pdu == NULL ? NULL : pdu->variables ); }
+
+            /// The end of the varbinds.  @see begin()
+            virtual Varlist::const_iterator end( void ) const { return Varlist::const_iterator(); }
+
             /// Free the existing variable list and use this one instead.
             virtual PDU &setVarlist( Varlist &vl );
 
@@ -114,7 +157,10 @@ namespace SNMPpp
             virtual size_t size( void ) const;
 
             /// Return `TRUE` if the variable list contains the given OID.
-            virtual bool contains( const SNMPpp::OID &o ) const;
+            virtual bool contains( const SNMPpp::OID &o ) const { return contains( o.view() ); }
+
+            /// Return `TRUE` if the variable list contains the given OID.
+            virtual bool contains( const SNMPpp::OIDView &o ) const;
 
             /// Return the first OID object in the variable list.
             virtual SNMPpp::OID firstOID( void ) const;
@@ -150,8 +196,22 @@ namespace SNMPpp
             virtual PDU &addNullVars( const SNMPpp::VecOID &v );
 
         protected:
+
+            /** Return a Varlist which remembers where the variable list
+             * ends, so that the add*() methods run in O(1).  Must be
+             * followed by endAppend().
+             * @throw std::logic_error if the PDU is NULL.
+             */
+            virtual Varlist beginAppend( void );
+
+            /// Store the variable list after it has been appended to.  @see beginAppend()
+            virtual void endAppend( Varlist &vl );
+
             EType type;
             netsnmp_pdu *pdu; // beware -- this pointer *can* be null if a PDU hasn't been defined or if it has been clear()
+            netsnmp_variable_list *tail; // last varbind, or NULL if not yet known, see beginAppend()
+            netsnmp_variable_list *head; // first varbind when the tail was remembered, since copies may replace the varbinds
+            std::shared_ptr< const VarlistIndex > index; // optional, see buildIndex()
     };
 };
 
@@ -0,0 +1,121 @@
+// SNMPpp: https://sourceforge.net/p/snmppp/
+// SNMPpp project uses the MIT license. See LICENSE for details.
+// Copyright (C) 2013 Stephane Charette <stephanecharette@gmail.com>
+
+#pragma once
+
+#include <SNMPpp/net-snmppp.hpp>
+#include <SNMPpp/Session.hpp>
+#include <SNMPpp/OID.hpp>
+#include <SNMPpp/PDU.hpp>
+#include <SNMPpp/UniquePDU.hpp>
+
+
+namespace SNMPpp
+{
+    /** A request which is built once and then sent over and over again,
+     * typically to poll the same OIDs every few seconds from one or many
+     * devices.
+     *
+     * Since net-snmp frees every request PDU it sends, a normal polling
+     * loop has to build the same request from scratch each time.  A
+     * PreparedRequest keeps a private copy of the request, and each
+     * call to send() hands net-snmp a clone of it.  Cloning copies the
+     * varbinds as they are, so the OIDs are never parsed, sorted or
+     * converted to SNMPpp::OID objects again.
+     *
+     * For example:
+     * @code
+     *      const SNMPpp::PreparedRequest request( oids );
+     *      while ( true )
+     *      {
+     *          for ( size_t idx = 0; idx < sessions.size(); idx ++ )
+     *          {
+     *              SNMPpp::UniquePDU response = request.send( sessions[idx] );
+     *              ...
+     *          }
+     *          sleep( 5 );
+     *      }
+     * @endcode
+     *
+     * PreparedRequest cannot be copied, only moved.  A const
+     * PreparedRequest can be sent from several threads at the same time.
+     */
+    class PreparedRequest
+    {
+        public:
+
+            /// Destructor.  Frees the private copy of the request.
+            virtual ~PreparedRequest( void );
+
+            /** Prepare a request for the given OIDs.
+             * @throw std::invalid_argument if there are no OIDs.
+             * @throw std::runtime_error if the PDU cannot be created.
+             */
+            PreparedRequest( const SNMPpp::SetOID &oids, const PDU::EType t = PDU::kGet );
+
+            /** Prepare a request for the given OIDs.  Unlike a SetOID, the
+             * order and duplicates in the vector are kept.
+             * @throw std::invalid_argument if there are no OIDs.
+             * @throw std::runtime_error if the PDU cannot be created.
+             */
+            PreparedRequest( const SNMPpp::VecOID &oids, const PDU::EType t = PDU::kGet );
+
+            /** Prepare a request based on an existing PDU, which can
+             * include values such as for SNMPpp::PDU::kSet.  The PDU is
+             * cloned, so the caller remains responsible for freeing it.
+             * @throw std::invalid_argument if the PDU is empty.
+             */
+            explicit PreparedRequest( const PDU &pdu );
+
+            /// Take over the request prepared by `rhs`, which is then empty.
+            PreparedRequest( PreparedRequest &&rhs ) noexcept;
+
+            PreparedRequest( const PreparedRequest &rhs ) = delete;
+            PreparedRequest &operator=( const PreparedRequest &rhs ) = delete;
+
+            /// Free the current request, and take over the one prepared by `rhs`.
+            virtual PreparedRequest &operator=( PreparedRequest &&rhs ) noexcept;
+
+            /** For SNMPpp::PDU::kGetBulk requests, set the number of
+             * repetitions and non-repeaters.  These are the same as the
+             * parameters to SNMPpp::getBulk().
+             * @throw std::logic_error if the request is not a kGetBulk.
+             */
+            virtual PreparedRequest &setBulk( const int maxRepetitions, const int nonRepeaters = 0 );
+
+            /// Get the type of the request.
+            virtual PDU::EType getType( void ) const { return prepared.getType(); }
+
+            /// Return the number of OIDs in the request.
+            virtual size_t size( void ) const { return prepared.size(); }
+
+            /// Returns `TRUE` if the request has been moved away.
+            virtual bool empty( void ) const { return prepared.empty(); }
+
+            /// Get access to the varbinds of the request, for example to match them against a response.
+            virtual const Varlist varlist( void ) const { return prepared.varlist(); }
+
+            /** Return a new request PDU, ready to be sent through net-snmp
+             * or SNMPpp::sync().  Each request gets its own request ID, so
+             * a late reply to a previous request is never mistaken for the
+             * reply to this one.  The caller owns the PDU, but as usual,
+             * net-snmp frees it once it has been sent.
+             * @throw std::logic_error if the request has been moved away.
+             * @throw std::runtime_error if the PDU cannot be cloned.
+             */
+            virtual PDU makeRequest( void ) const;
+
+            /** Send the request using the given SNMPpp::SessionHandle, and
+             * wait for a reply.  The response PDU needs to be freed using
+             * SNMPpp::PDU::free(), or moved into a SNMPpp::UniquePDU.
+             * @see makeRequest() and SNMPpp::sync() for the exceptions this may throw.
+             */
+            virtual PDU send( SNMPpp::SessionHandle &session ) const;
+
+        protected:
+
+            /// Private copy of the request, which is never sent.
+            UniquePDU prepared;
+    };
+};
@@ -0,0 +1,129 @@
+// SNMPpp: https://sourceforge.net/p/snmppp/
+// SNMPpp project uses the MIT license. See LICENSE for details.
+// Copyright (C) 2013 Stephane Charette <stephanecharette@gmail.com>
+
+#pragma once
+
+#include <stdint.h>
+#include <functional>
+#include <queue>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <SNMPpp/net-snmppp.hpp>
+#include <SNMPpp/AsyncEngine.hpp>
+
+
+namespace SNMPpp
+{
+    /** An SNMPpp::AsyncEngine which waits on its sessions with `epoll`
+     * instead of `select()`, for polling thousands of agents from a single
+     * thread.
+     *
+     * SNMPpp::AsyncEngine::poll() asks every active session for its socket
+     * and its next timeout, so each call costs as much as the number of
+     * sessions, and sockets above `FD_SETSIZE` cannot be used at all.  The
+     * reactor instead:
+     * - adds the socket of a session to `epoll` when the session sends its
+     *   first request, and removes it once the session has nothing left
+     *   outstanding;
+     * - only reads from the sessions `epoll` reports as readable;
+     * - keeps the next retry or timeout of each session in a priority queue,
+     *   so only the sessions which are due are given to `snmp_sess_timeout()`.
+     *
+     * The cost of a call to poll() therefore depends on the traffic, not on
+     * the number of sessions.  The reactor is used exactly like an
+     * SNMPpp::AsyncEngine:
+     * @code
+     *      SNMPpp::Reactor reactor;
+     *      for ( size_t idx = 0; idx < sessions.size(); idx ++ )
+     *      {
+     *          SNMPpp::PDU request( SNMPpp::PDU::kGet );
+     *          request.addNullVars( oids );
+     *          reactor.sendAsync( sessions[idx], request, callback );
+     *      }
+     *      reactor.run();
+     * @endcode
+     *
+     * @note `epoll` is only available on Linux.  Elsewhere the constructor
+     * throws, and SNMPpp::AsyncEngine should be used instead.
+     */
+    class Reactor : public AsyncEngine
+    {
+        public:
+
+            /// Destructor.  Closes the `epoll` descriptor.  @see AsyncEngine::~AsyncEngine()
+            virtual ~Reactor( void );
+
+            /** Create a reactor which handles up to `eventsPerWait` readable
+             * sockets per call to `epoll_wait()`.
+             * @throw std::runtime_error if `epoll` is not available.
+             */
+            explicit Reactor( const int eventsPerWait = 1024 );
+
+            Reactor( const Reactor &rhs ) = delete;
+            Reactor &operator=( const Reactor &rhs ) = delete;
+
+            /** Same as SNMPpp::AsyncEngine::sendAsync(), but also adds the
+             * socket of the session to `epoll` and schedules its timeout.
+             * @throw std::runtime_error if the socket cannot be added to `epoll`.
+             * @see AsyncEngine::sendAsync() for the other exceptions this may throw.
+             */
+            virtual int sendAsync( SessionHandle &session, PDU &request, const Callback &callback );
+
+            /** Same as SNMPpp::AsyncEngine::poll(), but waits with
+             * `epoll_wait()`.
+             * @throw std::runtime_error if `epoll_wait()` fails.
+             * @see AsyncEngine::poll() for the other exceptions this may throw.
+             */
+            virtual size_t poll( const int milliseconds = -1 );
+
+        protected:
+
+            /// Same as AsyncEngine::complete(), and removes the socket from `epoll` once the session is idle.
+            virtual void complete( Request *request, const int status, netsnmp_pdu *pdu );
+
+            /// Remove the socket of an idle session from `epoll`.
+            virtual void unregister( SessionHandle session );
+
+            /// Ask net-snmp when the session next needs attention, and add that to the timers.
+            virtual void schedule( SessionHandle session );
+
+            /// Call `snmp_sess_timeout()` for the sessions which are due.
+            virtual void expireTimers( void );
+
+            /// Read from a session which `epoll` reported as readable.
+            virtual void read( SessionHandle session, const int fd );
+
+            /// Milliseconds since an arbitrary point, which never goes backwards.
+            static int64_t now( void );
+
+            /// What the reactor knows about a session with outstanding requests.
+            struct Registration
+            {
+                int     fd;         ///< the socket added to `epoll`
+                int64_t deadline;   ///< when the session is next due, or zero if not scheduled
+            };
+
+            /// A timer, ordered so the earliest deadline comes first.
+            typedef std::pair< int64_t, SessionHandle > Timer;
+
+            /// Sessions with outstanding requests.
+            std::unordered_map< SessionHandle, Registration > registrations;
+
+            /// Deadlines of the sessions.  Deadlines which no longer match the registration are ignored.
+            std::priority_queue< Timer, std::vector< Timer >, std::greater< Timer > > timers;
+
+            /// Descriptor returned by `epoll_create1()`.
+            int epfd;
+
+            /// Buffer for `epoll_wait()`, with room for `maxEvents` of `struct epoll_event`.
+            std::vector< char > events;
+
+            /// Size of the buffer, in events.
+            int maxEvents;
+
+            /// Used to give a single socket to `snmp_sess_read2()` and `snmp_sess_select_info2()`, since an `fd_set` cannot hold sockets above `FD_SETSIZE`.
+            netsnmp_large_fd_set fdset;
+    };
+};
@@ -13,10 +13,24 @@
 #include <SNMPpp/Version.hpp>
 #include <SNMPpp/net-snmppp.hpp>
 #include <SNMPpp/Session.hpp>
+#include <SNMPpp/OIDView.hpp>
+#include <SNMPpp/OIDLiteral.hpp>
 #include <SNMPpp/OID.hpp>
+#include <SNMPpp/OidTrie.hpp>
+#include <SNMPpp/OIDPool.hpp>
+#include <SNMPpp/Value.hpp>
+#include <SNMPpp/Format.hpp>
+#include <SNMPpp/Varbind.hpp>
+#include <SNMPpp/VarbindArena.hpp>
 #include <SNMPpp/Varlist.hpp>
 #include <SNMPpp/PDU.hpp>
+#include <SNMPpp/UniquePDU.hpp>
+#include <SNMPpp/ColumnarBatch.hpp>
 #include <SNMPpp/Get.hpp>
+#include <SNMPpp/PreparedRequest.hpp>
+#include <SNMPpp/AsyncEngine.hpp>
+#include <SNMPpp/Reactor.hpp>
+#include <SNMPpp/SharedTransport.hpp>
 #include <SNMPpp/Trap.hpp>
 
 
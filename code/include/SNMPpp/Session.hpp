@@ -5,6 +5,7 @@
 #pragma once
 
 #include <SNMPpp/net-snmppp.hpp>
+#include <stddef.h>
 #include <mutex>
 #include <string>
 
@@ -28,8 +29,7 @@ namespace SNMPpp
     /** Open a net-snmp session and return a session handle.  The session
      * handle will be needed for all other net-snmp calls.  Any previous value
      * in "handle" will be blindly overwritten, so don't re-use handles unless
-     * you've remembered to call either `snmp_sess_close()` or
-     * SNMPpp::closeSession().
+     * you've remembered to call SNMPpp::closeSession().
      * @note
      * - Handles must be freed when no longer needed.
      * - Handles are not the same as `struct snmp_session`!
@@ -38,8 +38,72 @@ namespace SNMPpp
     void openSession( SessionHandle &sessionHandle, const std::string &server = "udp:127.0.0.1:161", const std::string &community = "public", const int version = SNMP_VERSION_2c, const int retryAttempts = 3, const int timeout = 1000000 );
     void openSessionV3( SessionHandle &sessionHandle, const std::string &server = "udp:127.0.0.1:161", const std::string &authUser = "guest", const std::string &authPassword = "", const std::string &privPassword = "", const std::string &secLevel = "authPriv", const std::string &authProtocol = "SHA1", const std::string &privProtocol = "AES", const int retryAttempts = 3, const int timeout = 1000000 );
 
-    /** Sessions must be closed when no longer needed.  This can be done by
-     * calling `snmp_sess_close()` directly, or SNMPpp::closeSession().
+    /** Sessions must be closed when no longer needed.  This also forgets the
+     * SNMPpp::SessionLimits learned for the session, which is why sessions
+     * opened by SNMPpp should not be closed with `snmp_sess_close()`.
      */
     void closeSession( SessionHandle &sessionHandle );
+
+    /** What has been learned about how much an agent accepts in a single
+     * message.  Agents answer `tooBig` (or silently truncate GETBULK
+     * responses) when a response doesn't fit, and the limit varies widely
+     * between devices.  Every time a request succeeds or fails, the known
+     * good and known bad sizes are narrowed down, so the size used for the
+     * next request is a binary search between the two.
+     *
+     * SNMPpp::get() with many OIDs and SNMPpp::getBulk() use and update the
+     * limits of their session automatically.  Use getSessionLimits() and
+     * setSessionLimits() to inspect them, or to start a new session with
+     * the limits already learned for the same type of device.
+     *
+     * Message sizes are estimates made with SNMPpp::estimateVarbindSize(),
+     * and include SNMPpp::kMessageOverhead.  GETBULK repetitions are
+     * counted in repeated varbinds, which is max-repetitions times the
+     * number of OIDs which repeat, so what is learned while walking a wide
+     * table also applies to a narrow one.  A value of zero means nothing
+     * is known yet.
+     */
+    struct SessionLimits
+    {
+        /// Largest message the agent is known to have answered.
+        size_t goodMessageSize;
+
+        /// Smallest message the agent is known to have refused with `tooBig`.
+        size_t tooBigMessageSize;
+
+        /// Largest number of repeated varbinds the agent is known to have answered in full with GETBULK.
+        int goodRepetitions;
+
+        /// Smallest number of repeated varbinds the agent is known to have refused or truncated with GETBULK.
+        int tooBigRepetitions;
+
+        /// Nothing known.
+        SessionLimits( void ) : goodMessageSize( 0 ), tooBigMessageSize( 0 ), goodRepetitions( 0 ), tooBigRepetitions( 0 ) { return; }
+
+        /** Return the message size to use for the next request, which is
+         * never more than `requested`.  A `requested` size of zero means
+         * there is no limit other than what has been learned.
+         */
+        size_t messageSize( const size_t requested ) const;
+
+        /** Return the GETBULK max-repetitions to use for the next request
+         * with the given number of repeating OIDs, which is never more
+         * than `requested`, and never less than 1.
+         */
+        int repetitions( const int requested, const int repeaters = 1 ) const;
+
+        /// Remember that a message of the given size was answered, or refused with `tooBig`.
+        void learnMessageSize( const size_t size, const bool tooBig );
+
+        /// Remember that GETBULK with the given max-repetitions and number of repeating OIDs was answered in full, or refused or truncated.
+        void learnRepetitions( const int repetitions, const bool tooBig, const int repeaters = 1 );
+    };
+
+    /// Get the limits learned so far for this session.
+    SessionLimits getSessionLimits( const SessionHandle &sessionHandle );
+
+    /** Replace the limits learned for this session.  Limits are forgotten
+     * by SNMPpp::closeSession().
+     */
+    void setSessionLimits( const SessionHandle &sessionHandle, const SessionLimits &limits );
 };
@@ -8,6 +8,7 @@
 #include <SNMPpp/Session.hpp>
 #include <SNMPpp/OID.hpp>
 #include <SNMPpp/PDU.hpp>
+#include <SNMPpp/UniquePDU.hpp>
 
 #include <string>
 
@@ -16,7 +17,8 @@ namespace SNMPpp
     /** @file
      * Several C++ helpers for some of the common net-snmp "SET" actions.
      * Remember to free the response PDUs by calling SNMPpp::PDU::free() or
-     * `netsnmp's snmp_pdu_free()`.
+     * `netsnmp's snmp_pdu_free()`, or move them into a SNMPpp::UniquePDU
+     * which frees them automatically.
      */
 
     /** Send a PDU using the given SNMPpp::SessionHandle, and wait for a reply.
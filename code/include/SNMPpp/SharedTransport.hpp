@@ -0,0 +1,320 @@
+// SNMPpp: https://sourceforge.net/p/snmppp/
+// SNMPpp project uses the MIT license. See LICENSE for details.
+// Copyright (C) 2013 Stephane Charette <stephanecharette@gmail.com>
+
+#pragma once
+
+#include <stdint.h>
+#include <exception>
+#include <functional>
+#include <queue>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <SNMPpp/net-snmppp.hpp>
+#include <SNMPpp/PDU.hpp>
+#ifndef WIN32
+#include <sys/socket.h>
+#endif
+
+
+namespace SNMPpp
+{
+    /** Poll many SNMPv1 or SNMPv2c agents through one (or a few) UDP
+     * sockets, instead of opening a net-snmp session for each of them.
+     *
+     * Every session opened with SNMPpp::openSession() has its own socket,
+     * transport and internal session state, which adds up to a file
+     * descriptor and a few kilobytes per agent.  A shared transport instead
+     * describes each agent with a small SNMPpp::SharedTransport::Target, and
+     * sends all of the requests from the same sockets.  Replies are matched
+     * to their requests by request ID, and must come from the address the
+     * request was sent to.
+     * @code
+     *      SNMPpp::SharedTransport transport;
+     *      std::vector< size_t > targets;
+     *      for ( size_t idx = 0; idx < servers.size(); idx ++ )
+     *      {
+     *          targets.push_back( transport.addTarget( servers[idx], "public" ) );
+     *      }
+     *      for ( size_t idx = 0; idx < targets.size(); idx ++ )
+     *      {
+     *          SNMPpp::PDU request( SNMPpp::PDU::kGet );
+     *          request.addNullVars( oids );
+     *          transport.sendAsync( targets[idx], request,
+     *              []( const int status, const size_t target, const SNMPpp::PDU &response )
+     *              {
+     *                  // ...
+     *              } );
+     *      }
+     *      transport.run();
+     * @endcode
+     *
+     * Requests are encoded with `snmp_build()` and replies decoded with
+     * `snmp_parse()`, so the PDUs are exactly the ones net-snmp would send;
+     * only the sockets, the retries and the timeouts are handled here.
+     *
+     * Requests are not sent by sendAsync() itself, but queued until the
+     * next call to flush() or poll().  The queue is then sent with
+     * `sendmmsg()`, and replies are read with `recvmmsg()`, so a burst of
+     * requests to many agents (and the burst of replies which follows)
+     * costs a handful of system calls instead of one per datagram.
+     *
+     * On kernels with `io_uring`, and when SNMPpp is built with liburing
+     * (`SNMPPP_HAVE_LIBURING`), the transport can use SNMPpp::SharedTransport::kIoUring
+     * instead: each socket then has a single multishot receive which keeps
+     * filling buffers registered with the kernel, and the requests queued
+     * before poll() are submitted in the same system call as the wait for
+     * replies.  When `io_uring` is not available, the transport quietly
+     * falls back to `epoll`, so getBackend() tells which one is actually
+     * used.
+     *
+     * @note
+     * - SNMPv3 is not supported, since it needs per-agent engine discovery
+     *   and security state.  Use SNMPpp::openSessionV3() for those agents.
+     * - The sockets are waited on with `epoll`, which is only available on
+     *   Linux.  Elsewhere the constructor throws.
+     * - A transport is not thread-safe.  Callbacks are invoked from poll() or
+     *   run(), on the thread that calls them.
+     */
+    class SharedTransport
+    {
+        public:
+
+            /// How datagrams are sent, received and waited for.
+            enum EBackend
+            {
+                kEpoll      = 0 ,   ///< `sendmmsg()`, `recvmmsg()` and `epoll_wait()`
+                kIoUring    = 1     ///< `io_uring`, falling back to kEpoll when not available
+            };
+
+            /** Invoked once for every request, with `STAT_SUCCESS`,
+             * `STAT_TIMEOUT`, or `STAT_ERROR` if the request could not be
+             * sent.  On success the response is the PDU received
+             * from the agent, which may still contain an error in `errstat`.
+             * Otherwise the response is empty.
+             *
+             * The response is freed as soon as the callback returns.  Use
+             * SNMPpp::PDU::clone() to keep it.
+             */
+            typedef std::function< void( const int status, const size_t target, const PDU &response ) > Callback;
+
+            /** Destructor.  Closes the sockets.  The callbacks of requests
+             * which are still outstanding are never invoked.
+             */
+            virtual ~SharedTransport( void );
+
+            /** Create a transport which spreads its targets over the given
+             * number of sockets per address family.  The sockets are only
+             * opened once a target needs them.
+             *
+             * Up to `datagramsPerCall` datagrams are sent or received with
+             * each call to `sendmmsg()` or `recvmmsg()`.  Every one of them
+             * needs a receive buffer large enough for any UDP datagram, but
+             * the memory of those buffers is only used as replies fill it.
+             * With `io_uring`, this is also the least number of buffers
+             * registered for the replies.
+             * @throw std::runtime_error if `epoll` is not available.
+             */
+            explicit SharedTransport( const size_t socketsPerFamily = 1, const size_t datagramsPerCall = 64, const EBackend preferred = kEpoll );
+
+            SharedTransport( const SharedTransport &rhs ) = delete;
+            SharedTransport &operator=( const SharedTransport &rhs ) = delete;
+
+            /** Describe an agent, using the same parameters as
+             * SNMPpp::openSession().  The server is either `host`,
+             * `host:port`, `udp:host:port` or `udp6:[address]:port`.
+             * @return The index of the target, used with sendAsync().
+             * @throw std::invalid_argument if the transport or version is not supported.
+             * @throw std::runtime_error if the address cannot be resolved, or no socket can be opened.
+             */
+            virtual size_t addTarget( const std::string &server = "udp:127.0.0.1:161", const std::string &community = "public", const int version = SNMP_VERSION_2c, const int retryAttempts = 3, const int timeout = 1000000 );
+
+            /// Return the number of targets added so far.
+            virtual size_t targetCount( void ) const { return targets.size(); }
+
+            /** Queue the request to the target, to be sent by the next call
+             * to flush() or poll().  The callback is invoked later from
+             * poll() or run().  Requests can be sent from within a callback.
+             * @note The *request* PDU is automatically freed, even when an
+             * exception is thrown.
+             * @return The request ID.
+             * @throw std::invalid_argument if the request is NULL or the target does not exist.
+             * @throw std::runtime_error if the request cannot be encoded.
+             */
+            virtual int sendAsync( const size_t target, PDU &request, const Callback &callback );
+
+            /** Send the queued requests and retries, with as few calls to
+             * `sendmmsg()` as possible.  This is done by poll(), so only call
+             * it to get requests on the wire before polling.
+             * @throw Any exception thrown by the callback of a request which
+             * could not be sent, once the whole queue has been handled.
+             */
+            virtual void flush( void );
+
+            /** Send the queued requests, wait up to the given number of
+             * milliseconds for replies, read all of the ones which have
+             * arrived, and handle retries and timeouts.  Use zero to only handle what is ready, or a negative
+             * value to wait until there is something to do.
+             * @return The number of callbacks invoked.
+             * @throw std::runtime_error if `epoll_wait()` fails.
+             * @throw Any exception thrown by a callback, once the replies
+             * which have already been read are handled.
+             */
+            virtual size_t poll( const int milliseconds = -1 );
+
+            /** Call poll() until every request has completed.
+             * @see poll() for the exceptions this may throw.
+             */
+            virtual void run( void );
+
+            /// Return the number of requests sent but not yet completed.
+            virtual size_t outstanding( void ) const { return pending.size(); }
+
+            /// Return the number of sockets opened so far.
+            virtual size_t socketCount( void ) const;
+
+            /// Return the backend actually used, which is kEpoll if `io_uring` was asked for but is not available.
+            virtual EBackend getBackend( void ) const { return backend; }
+
+            /// Return the number of datagrams dropped because they could not be parsed, or did not match an outstanding request.
+            virtual size_t dropped( void ) const { return discarded; }
+
+        protected:
+
+            /// Everything needed to send a request to an agent.
+            struct Target
+            {
+                struct sockaddr_storage address;
+                socklen_t               addressLength;
+                uint32_t                socket;     ///< index in `sockets`
+                int                     version;
+                int                     retries;
+                int                     timeout;    ///< in milliseconds
+                std::string             community;
+            };
+
+            /// A request waiting for its reply.
+            struct Request
+            {
+                size_t                  target;
+                Callback                callback;
+                std::vector< u_char >   packet;     ///< the encoded request, sent again on retries
+                int                     retries;    ///< retries left
+                int64_t                 deadline;   ///< when the request is next retried or times out
+            };
+
+            /// A timer, ordered so the earliest deadline comes first.
+            typedef std::pair< int64_t, int > Timer;
+
+            /// Return the socket for the given address family, opening it if needed.
+            virtual uint32_t socketFor( const int family );
+
+            /// Send the queued requests and retries.  With `io_uring`, `submit` may be `false` when waitRing() is about to submit them.
+            virtual void sendQueued( const bool submit );
+
+            /// Send up to `batchSize` of the queued requests on a socket, which must all still be outstanding.
+            /// Returns `false` once the socket buffer is full; the unsent requests are left to their retry timers.
+            virtual bool transmit( const uint32_t socket, const int *reqids, const size_t count );
+
+            /// Read every datagram waiting on the socket.
+            virtual void receive( const uint32_t socket );
+
+            /// Decode a datagram, and complete the request it answers.
+            virtual void handleDatagram( u_char *data, const size_t length, const struct sockaddr *from, const socklen_t fromLength );
+
+            /// Retry or time out the requests which are due.
+            virtual void expireTimers( void );
+
+            /// Invoke the callback, and forget the request.
+            virtual void complete( const int reqid, const int status, netsnmp_pdu *pdu );
+
+            /// Re-throw the exception kept by complete(), if any.
+            virtual void rethrowFailure( void );
+
+            /// The `io_uring` state, which only exists when built with liburing.
+            struct Ring;
+
+            /// Set up `io_uring` and its receive buffers.  @return `false` if it is not available.
+            virtual bool startRing( void );
+
+            /// Tear down `io_uring`, cancelling whatever it still has in flight.
+            virtual void stopRing( void );
+
+            /// Start the multishot receive of a socket.  It is submitted with the next requests, or the next wait.
+            virtual void armRing( const uint32_t socket );
+
+            /// Queue the requests in `io_uring`, and submit them unless they are left for the next wait.
+            virtual void transmitRing( const std::vector< int > &reqids, const bool submit );
+
+            /// Submit, wait up to the given number of milliseconds for completions, and handle all of them.
+            virtual void waitRing( const int milliseconds );
+
+            /// Milliseconds since an arbitrary point, which never goes backwards.
+            static int64_t now( void );
+
+            /// Return `true` if the datagram came from the address of the target.
+            static bool sameAddress( const Target &target, const struct sockaddr *from, const socklen_t fromLength );
+
+            /// Agents added with addTarget().
+            std::vector< Target > targets;
+
+            /// The socket descriptors, two per slot (IPv4 then IPv6), or -1 when not yet opened.
+            std::vector< int > sockets;
+
+            /// Next slot given to a target, so targets are spread over the sockets.
+            size_t nextSlot;
+
+            /// Requests which have been sent, but not yet completed, by request ID.
+            std::unordered_map< int, Request > pending;
+
+            /// Deadlines of the requests.  Deadlines which no longer match the request are ignored.
+            std::priority_queue< Timer, std::vector< Timer >, std::greater< Timer > > timers;
+
+            /// Descriptor returned by `epoll_create1()`.  The sockets are always added, so the transport can fall back to `epoll`.
+            int epfd;
+
+            /// The backend in use.
+            EBackend backend;
+
+            /// NULL unless `io_uring` was asked for, and is available.
+            Ring *ring;
+
+            /// Session used for `snmp_build()` and `snmp_parse()`; the version and community come from the PDU.
+            netsnmp_session session;
+
+            /// Buffer given to `snmp_build()`, which may grow it with `realloc()`.
+            u_char *buffer;
+
+            /// Size of `buffer`.
+            size_t bufferSize;
+
+            /// Requests to send with the next call to flush(), by request ID.
+            std::vector< int > outbox;
+
+            /// Most datagrams sent or received by a single system call.
+            size_t batchSize;
+
+            /// Buffers for `batchSize` incoming datagrams of up to 64 KiB each, from `malloc()` so untouched pages are never committed.
+            u_char *datagrams;
+
+            /// Headers given to `sendmmsg()` and `recvmmsg()`, with room for `batchSize` of `struct mmsghdr`.
+            std::vector< char > headers;
+
+            /// Buffer descriptors for the headers, with room for `batchSize` of `struct iovec`.
+            std::vector< char > vectors;
+
+            /// Where each of the incoming datagrams came from.
+            std::vector< struct sockaddr_storage > sources;
+
+            /// Number of callbacks invoked, used by poll().
+            size_t completed;
+
+            /// Number of datagrams dropped.
+            size_t discarded;
+
+            /// The first exception thrown by a callback, re-thrown by poll().
+            std::exception_ptr failure;
+    };
+};
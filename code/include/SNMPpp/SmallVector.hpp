@@ -0,0 +1,217 @@
+// SNMPpp: https://sourceforge.net/p/snmppp/
+// SNMPpp project uses the MIT license. See LICENSE for details.
+// Copyright (C) 2013 Stephane Charette <stephanecharette@gmail.com>
+
+#pragma once
+
+#include <new>
+#include <string.h>
+#include <algorithm>
+#include <utility>
+
+
+namespace SNMPpp
+{
+    /** A small subset of std::vector which keeps the first `N` elements
+     * inside the object itself, and only allocates memory on the heap once
+     * more than `N` elements are stored.
+     *
+     * This is used by SNMPpp::OID so that typical OIDs can be created,
+     * copied, and destroyed without ever calling `new` or `delete`.
+     *
+     * @note `T` must be a trivially copyable type (such as net-snmp's `oid`)
+     * since elements are moved around with `memcpy()`.
+     */
+    template < typename T, size_t N >
+    class SmallVector
+    {
+        public:
+
+            typedef T           value_type;
+            typedef T *         iterator;
+            typedef const T *   const_iterator;
+
+            /// Destructor.
+            ~SmallVector( void )
+            {
+                release();
+            }
+
+            /// Create an empty vector.  This does not allocate any memory.
+            SmallVector( void ) :
+                ptr( inlineBuffer ),
+                count( 0 ),
+                capacity( N )
+            {
+                return;
+            }
+
+            /// Copy an existing vector.  Only allocates if `rhs` has more than `N` elements.
+            SmallVector( const SmallVector &rhs ) :
+                ptr( inlineBuffer ),
+                count( 0 ),
+                capacity( N )
+            {
+                assign( rhs.ptr, rhs.count );
+            }
+
+            /** Move an existing vector.  If `rhs` is using the heap then
+             * the buffer is stolen instead of copied, and `rhs` is left
+             * empty.
+             */
+            SmallVector( SmallVector &&rhs ) noexcept :
+                ptr( inlineBuffer ),
+                count( 0 ),
+                capacity( N )
+            {
+                steal( rhs );
+            }
+
+            /// Copy an existing vector.
+            SmallVector &operator=( const SmallVector &rhs )
+            {
+                if ( &rhs != this )
+                {
+                    assign( rhs.ptr, rhs.count );
+                }
+
+                return *this;
+            }
+
+            /// Move an existing vector.  @see SmallVector( SmallVector &&rhs )
+            SmallVector &operator=( SmallVector &&rhs ) noexcept
+            {
+                if ( &rhs != this )
+                {
+                    release();
+                    count = 0;
+                    steal( rhs );
+                }
+
+                return *this;
+            }
+
+            /// Replace the content of the vector with `len` elements copied from `p`.
+            void assign( const T *p, const size_t len )
+            {
+                count = 0;
+                reserve( len );
+                if ( len > 0 )
+                {
+                    memcpy( ptr, p, len * sizeof(T) );
+                }
+                count = len;
+            }
+
+            /// Make certain the vector can store at least `len` elements without re-allocating.
+            void reserve( const size_t len )
+            {
+                if ( len > capacity )
+                {
+                    T *p = static_cast<T *>( ::operator new( len * sizeof(T) ) );
+                    if ( count > 0 )
+                    {
+                        memcpy( p, ptr, count * sizeof(T) );
+                    }
+                    release();
+                    ptr         = p;
+                    capacity    = len;
+                }
+            }
+
+            /// Append an element to the end of the vector.
+            void push_back( const T &t )
+            {
+                // `t` may be one of our own elements, which growing would free
+                const T copy = t;
+                if ( count == capacity )
+                {
+                    reserve( 2 * capacity );
+                }
+                ptr[ count ++ ] = copy;
+            }
+
+            /// Grow or shrink the vector.  New elements are zero-initialized.
+            void resize( const size_t len )
+            {
+                reserve( len );
+                if ( len > count )
+                {
+                    memset( ptr + count, 0, ( len - count ) * sizeof(T) );
+                }
+                count = len;
+            }
+
+            /// Remove all elements.  Heap memory (if any) is kept for re-use.
+            void clear( void ) { count = 0; }
+
+            /// Exchange the content of two vectors.
+            void swap( SmallVector &rhs )
+            {
+                SmallVector tmp( std::move( rhs ) );
+                rhs     = std::move( *this );
+                *this   = std::move( tmp );
+            }
+
+            size_t size     ( void ) const { return count;          }
+            bool   empty    ( void ) const { return count == 0;     }
+
+            /// Return `TRUE` if the elements are stored in the object itself rather than on the heap.
+            bool   isInline ( void ) const { return ptr == inlineBuffer; }
+
+            T *         data    ( void )        { return ptr; }
+            const T *   data    ( void ) const  { return ptr; }
+            iterator        begin( void )       { return ptr; }
+            iterator        end  ( void )       { return ptr + count; }
+            const_iterator  begin( void ) const { return ptr; }
+            const_iterator  end  ( void ) const { return ptr + count; }
+
+            T &         operator[]( const size_t idx )       { return ptr[idx]; }
+            const T &   operator[]( const size_t idx ) const { return ptr[idx]; }
+
+            /// Comparison operators, using the same lexicographical rules as std::vector. @{
+            bool operator==( const SmallVector &rhs ) const { return count == rhs.count && std::equal( begin(), end(), rhs.begin() ); }
+            bool operator!=( const SmallVector &rhs ) const { return ! operator==( rhs ); }
+            bool operator< ( const SmallVector &rhs ) const { return std::lexicographical_compare( begin(), end(), rhs.begin(), rhs.end() ); }
+            bool operator> ( const SmallVector &rhs ) const { return rhs.operator<( *this ); }
+            bool operator<=( const SmallVector &rhs ) const { return ! rhs.operator<( *this ); }
+            bool operator>=( const SmallVector &rhs ) const { return ! operator<( rhs ); }
+            /// @}
+
+        protected:
+
+            /// Take the content of `rhs`, which must not be `this`.  Must only be called when `this` is empty and using the inline buffer.
+            void steal( SmallVector &rhs ) noexcept
+            {
+                if ( rhs.ptr != rhs.inlineBuffer )
+                {
+                    ptr             = rhs.ptr;
+                    capacity        = rhs.capacity;
+                    rhs.ptr         = rhs.inlineBuffer;
+                    rhs.capacity    = N;
+                }
+                else if ( rhs.count > 0 )
+                {
+                    memcpy( ptr, rhs.ptr, rhs.count * sizeof(T) );
+                }
+                count       = rhs.count;
+                rhs.count   = 0;
+            }
+
+            /// Free the heap buffer (if there is one) and go back to using the inline buffer.
+            void release( void ) noexcept
+            {
+                if ( ptr != inlineBuffer )
+                {
+                    ::operator delete( ptr );
+                    ptr         = inlineBuffer;
+                    capacity    = N;
+                }
+            }
+
+            T *     ptr;
+            size_t  count;
+            size_t  capacity;
+            T       inlineBuffer[ N ];
+    };
+};
@@ -0,0 +1,85 @@
+// SNMPpp: https://sourceforge.net/p/snmppp/
+// SNMPpp project uses the MIT license. See LICENSE for details.
+// Copyright (C) 2013 Stephane Charette <stephanecharette@gmail.com>
+
+#pragma once
+
+#include <SNMPpp/net-snmppp.hpp>
+#include <SNMPpp/PDU.hpp>
+
+
+namespace SNMPpp
+{
+    /** A PDU which owns the underlying net-snmp structure, and automatically
+     * frees it in the destructor.
+     *
+     * Since UniquePDU derives from SNMPpp::PDU, it can be passed to all of
+     * the usual calls such as SNMPpp::get(), SNMPpp::getNext(),
+     * SNMPpp::getBulk() and SNMPpp::set().  The responses returned by those
+     * calls can be moved directly into a UniquePDU:
+     * @code
+     *      SNMPpp::UniquePDU pdu( SNMPpp::PDU::kGetNext );
+     *      pdu.addNullVar( SNMPpp::OID::kInternet );
+     *      for ( size_t idx = 0; idx < 10; idx ++ )
+     *      {
+     *          pdu = SNMPpp::getNext( sessionHandle, pdu );
+     *          std::cout << pdu;
+     *      }
+     *      // no need to call pdu.free(), even if an exception was thrown
+     * @endcode
+     *
+     * UniquePDU cannot be copied, only moved.  Beware of converting a
+     * UniquePDU to a plain SNMPpp::PDU by value, since both objects would
+     * then reference the same net-snmp structure.  Use release() to give up
+     * ownership instead.
+     */
+    class UniquePDU : public PDU
+    {
+        public:
+
+            /// Destructor.  Frees the net-snmp structure using `snmp_free_pdu()`.
+            virtual ~UniquePDU( void );
+
+            /// Create a PDU of the given type.  @see SNMPpp::PDU::PDU( const EType t )
+            explicit UniquePDU( const EType t );
+
+            /// Take ownership of a PDU from net-snmp.  It is valid for `p` to be NULL.
+            explicit UniquePDU( netsnmp_pdu *p );
+
+            /** Take ownership of the net-snmp structure referenced by `rhs`,
+             * which is then cleared.  This is normally used with the response
+             * returned by calls such as SNMPpp::get().
+             */
+            UniquePDU( PDU &&rhs );
+
+            /// Take ownership from another UniquePDU, which is then cleared.
+            UniquePDU( UniquePDU &&rhs ) noexcept;
+
+            UniquePDU( const UniquePDU &rhs ) = delete;
+            UniquePDU &operator=( const UniquePDU &rhs ) = delete;
+
+            /// Free the current net-snmp structure, and take ownership of the one from `rhs`.
+            virtual UniquePDU &operator=( UniquePDU &&rhs ) noexcept;
+
+            /// Free the current net-snmp structure, and take ownership of the one from `rhs`.
+            virtual UniquePDU &operator=( PDU &&rhs ) noexcept;
+
+            /** Give up ownership of the net-snmp structure.  The caller is
+             * now responsible for freeing the returned PDU, and this object
+             * is cleared.
+             */
+            virtual PDU release( void );
+
+            /** Re-use the net-snmp structure for a new PDU of the given type.
+             * The variables and all other dynamic fields are freed, and the
+             * header is re-initialized exactly like `snmp_pdu_create()` would
+             * do, including a new request ID.  This saves a `free()` and a
+             * `malloc()` per request in tight polling loops.
+             *
+             * If the PDU is empty, or holds SNMPv3 security state which only
+             * net-snmp can release, then a new PDU is created instead.
+             * @throw std::runtime_error if a new PDU cannot be created.
+             */
+            virtual UniquePDU &recycle( const EType t );
+    };
+};
@@ -0,0 +1,109 @@
+// SNMPpp: https://sourceforge.net/p/snmppp/
+// SNMPpp project uses the MIT license. See LICENSE for details.
+// Copyright (C) 2013 Stephane Charette <stephanecharette@gmail.com>
+
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include <SNMPpp/net-snmppp.hpp>
+#include <SNMPpp/OIDView.hpp>
+
+
+namespace SNMPpp
+{
+    /** The value of a varbind, decoded directly from the net-snmp structure
+     * without going through text.  Every ASN type is folded into one of a
+     * few kinds, so numeric values can be consumed without caring whether
+     * the agent sent a Counter32, a Gauge32 or a Counter64:
+     * @code
+     *      for ( const SNMPpp::Varbind &vb : pdu )
+     *      {
+     *          const SNMPpp::Value v = vb.getValue();
+     *          if ( v.isNumeric() )
+     *          {
+     *              metrics.record( vb.name(), v.asDouble() );
+     *          }
+     *      }
+     * @endcode
+     *
+     * Values are 16 bytes and never allocate memory.  Strings and OIDs
+     * point into the varbind, so they are only valid for as long as the
+     * varbind has not been freed.
+     */
+    class Value
+    {
+        public:
+
+            /// How the value is stored.
+            enum EKind
+            {
+                kNone       = 0 ,   ///< `ASN_NULL`, noSuchObject, noSuchInstance, endOfMibView, or an unknown type
+                kSigned         ,   ///< `ASN_INTEGER`, signed 64-bit integers, and `ASN_BOOLEAN` as 1 for true and 0 for false
+                kUnsigned       ,   ///< Counter32, Gauge32, TimeTicks, UInteger32 and Counter64
+                kDouble         ,   ///< Opaque float and double
+                kBytes          ,   ///< `ASN_OCTET_STR`, IpAddress, Opaque, and other octet strings
+                kObjectId           ///< `ASN_OBJECT_ID`
+            };
+
+            /// Empty value.
+            Value( void );
+
+            /// Decode the value of a varbind.  A NULL pointer results in an empty value.
+            explicit Value( const netsnmp_variable_list *vl );
+
+            /// Return how the value is stored.
+            EKind getKind( void ) const { return static_cast<EKind>( kind ); }
+
+            /// Return the original ASN type of the varbind.
+            int asnType( void ) const { return asn; }
+
+            /// Return `TRUE` if the varbind did not have a value.
+            bool empty( void ) const { return kind == kNone; }
+
+            /// Return `TRUE` if the value is kSigned, kUnsigned or kDouble.
+            bool isNumeric( void ) const { return kind == kSigned || kind == kUnsigned || kind == kDouble; }
+
+            /** Return any numeric value as a signed 64-bit integer.
+             * @throw std::logic_error if the value is not numeric.
+             */
+            int64_t asSigned( void ) const;
+
+            /** Return any numeric value as an unsigned 64-bit integer.
+             * @throw std::logic_error if the value is not numeric.
+             */
+            uint64_t asUnsigned( void ) const;
+
+            /** Return any numeric value as a double.
+             * @throw std::logic_error if the value is not numeric.
+             */
+            double asDouble( void ) const;
+
+            /// Return the octets of a kBytes value, or NULL for all other kinds.  @see size()
+            const u_char *data( void ) const { return kind == kBytes ? value.bytes : NULL; }
+
+            /// Return the number of octets of a kBytes value, or the number of numeric values of a kObjectId value.
+            size_t size( void ) const { return length; }
+
+            /// Copy the octets of a kBytes value into a string.  @throw std::logic_error if the value is not kBytes.
+            std::string getBytes( void ) const;
+
+            /// Return a kObjectId value without copying it.  @throw std::logic_error if the value is not kObjectId.
+            OIDView getOIDView( void ) const;
+
+        protected:
+
+            union
+            {
+                int64_t         s;
+                uint64_t        u;
+                double          d;
+                const u_char *  bytes;
+                const oid *     objid;
+            } value;
+
+            uint32_t    length;
+            uint8_t     asn;
+            uint8_t     kind;
+    };
+};
@@ -0,0 +1,196 @@
+// SNMPpp: https://sourceforge.net/p/snmppp/
+// SNMPpp project uses the MIT license. See LICENSE for details.
+// Copyright (C) 2013 Stephane Charette <stephanecharette@gmail.com>
+
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include <iterator>
+#include <SNMPpp/net-snmppp.hpp>
+#include <SNMPpp/OIDView.hpp>
+#include <SNMPpp/OID.hpp>
+#include <SNMPpp/Value.hpp>
+#include <SNMPpp/Format.hpp>
+
+
+namespace SNMPpp
+{
+    /** A read-only view of a single net-snmp varbind.  Like SNMPpp::OIDView
+     * this is nothing more than a pointer, so creating one never allocates
+     * memory.  These are what SNMPpp::Varlist::begin() iterates over:
+     * @code
+     *      SNMPpp::PDU pdu = SNMPpp::getBulk( sessionHandle, o );
+     *      for ( const SNMPpp::Varbind &vb : pdu )
+     *      {
+     *          if ( vb.asnType() == ASN_INTEGER )
+     *          {
+     *              std::cout << vb.name() << " = " << vb.getLong() << std::endl;
+     *          }
+     *      }
+     * @endcode
+     *
+     * @note The view is only valid for as long as the varbind it references
+     * has not been freed.
+     */
+    class Varbind
+    {
+        public:
+
+            /// View of the given varbind.  Using a NULL pointer is valid, but only empty() and raw() may then be called.
+            explicit Varbind( const netsnmp_variable_list *vl = NULL ) : ptr( vl ) { return; }
+
+            /// Return `TRUE` if the view does not reference a varbind.
+            bool empty( void ) const { return ptr == NULL; }
+
+            /// Return the underlying net-snmp varbind.
+            const netsnmp_variable_list *raw( void ) const { return ptr; }
+
+            /// Return the name of the varbind without copying it.  @see SNMPpp::OIDView
+            OIDView name( void ) const { return OIDView( ptr ); }
+
+            /// Return the ASN type of the varbind.  @see SNMPpp::Varlist::asnType()
+            int asnType( void ) const { return ptr->type; }
+
+            /// Return the net-snmp value structure.  @see valueLength()
+            const netsnmp_vardata &value( void ) const { return ptr->val; }
+
+            /// Return the length in bytes of the value.
+            size_t valueLength( void ) const { return ptr->val_len; }
+
+            /** Retrieve the value of a boolean varbind.
+             * @throw std::invalid_argument if the varbind is not `ASN_BOOLEAN`.
+             */
+            bool getBool( void ) const;
+
+            /** Retrieve the value of a long varbind.
+             * @throw std::invalid_argument if the varbind is not `ASN_INTEGER`.
+             */
+            long getLong( void ) const;
+
+            /** Retrieve the value of a string varbind.
+             * @throw std::invalid_argument if the varbind is not `ASN_OCTET_STR`.
+             */
+            std::string getString( void ) const;
+
+            /** Retrieve the value of an object varbind.
+             * @throw std::invalid_argument if the varbind is not `ASN_OBJECT_ID`.
+             */
+            SNMPpp::OID getOID( void ) const;
+
+            /** Retrieve the value of a Counter32 varbind.
+             * @throw std::invalid_argument if the varbind is not `ASN_COUNTER`.
+             */
+            uint32_t getCounter32( void ) const;
+
+            /** Retrieve the value of a Gauge32 (or Unsigned32) varbind.
+             * @throw std::invalid_argument if the varbind is not `ASN_GAUGE`.
+             */
+            uint32_t getGauge32( void ) const;
+
+            /** Retrieve the value of a TimeTicks varbind, in hundredths of a second.
+             * @see SNMPpp::CentiSeconds
+             * @throw std::invalid_argument if the varbind is not `ASN_TIMETICKS`.
+             */
+            uint32_t getTimeTicks( void ) const;
+
+            /** Retrieve the value of any 32-bit unsigned varbind:  Counter32,
+             * Gauge32, TimeTicks or UInteger32.
+             * @throw std::invalid_argument if the varbind is not one of those types.
+             */
+            unsigned long getUnsigned( void ) const;
+
+            /** Retrieve the value of a Counter64 varbind, including the
+             * Opaque-wrapped and unsigned 64-bit variants.
+             * @throw std::invalid_argument if the varbind is not a 64-bit unsigned type.
+             */
+            uint64_t getCounter64( void ) const;
+
+            /** Retrieve the value of a signed 64-bit varbind, such as the
+             * ones created by SNMPpp::Varlist::addInteger64Var().
+             * @throw std::invalid_argument if the varbind is not a 64-bit signed type.
+             */
+            int64_t getInteger64( void ) const;
+
+            /** Retrieve the value of an IpAddress varbind.  The address is
+             * in network byte order, the same as `in_addr.s_addr`.
+             * @throw std::invalid_argument if the varbind is not `ASN_IPADDRESS`.
+             */
+            uint32_t getIpAddress( void ) const;
+
+            /** Retrieve the value of an Opaque float or double varbind.
+             * @throw std::invalid_argument if the varbind is not a floating point type.
+             */
+            double getDouble( void ) const;
+
+            /// Decode the value regardless of the ASN type.  This never throws.  @see SNMPpp::Value
+            SNMPpp::Value getValue( void ) const { return SNMPpp::Value( ptr ); }
+
+            /** Write the value as text into a buffer provided by the caller.
+             * No memory is allocated.  @see SNMPpp::formatValue()
+             */
+            size_t format( char *buf, const size_t len, const char *hint = NULL ) const { return SNMPpp::formatValue( ptr, buf, len, hint ); }
+
+            /// Append the value as text to the end of `s`.  @see format()
+            std::string &appendTo( std::string &s, const char *hint = NULL ) const;
+
+            /** Convert the value to text, optionally using an RFC 2579
+             * DISPLAY-HINT such as `"1x:"`.  @see SNMPpp::formatValue()
+             * @see SNMPpp::Varlist::asString()
+             */
+            std::string asString( const char *hint = NULL ) const { std::string s; return appendTo( s, hint ); }
+
+            /** Convert the value to text using net-snmp's
+             * `sprint_realloc_value()`.  This is much slower than asString()
+             * but uses everything net-snmp knows from the MIBs, such as
+             * enumeration labels and symbolic OIDs.
+             */
+            std::string asNetSnmpString( void ) const;
+
+        protected:
+
+            /// Throw std::invalid_argument unless the varbind is of the expected type.
+            void verify( const bool isExpectedType, const char *description ) const;
+
+            const netsnmp_variable_list *ptr;
+    };
+
+
+    /** Iterator over the varbinds of a net-snmp variable list.
+     * Dereferencing yields a SNMPpp::Varbind.  Advancing the iterator simply
+     * follows `next_variable`, so a complete pass is O(n) and never
+     * allocates memory.
+     *
+     * The SNMPpp::Varbind is kept in the iterator itself, so a reference to
+     * it only remains valid until the iterator is advanced.  This is why it
+     * is an input iterator, even though the list can be walked many times.
+     * @see SNMPpp::Varlist::begin()
+     * @see SNMPpp::PDU::begin()
+     */
+    class VarbindIterator
+    {
+        public:
+
+            typedef std::input_iterator_tag     iterator_category;
+            typedef Varbind                     value_type;
+            typedef std::ptrdiff_t              difference_type;
+            typedef const Varbind *             pointer;
+            typedef const Varbind &             reference;
+
+            /// Iterator starting at the given varbind.  A NULL pointer is the end iterator.
+            explicit VarbindIterator( const netsnmp_variable_list *vl = NULL ) : current( vl ) { return; }
+
+            reference operator*( void ) const { return current; }
+            pointer operator->( void ) const { return &current; }
+
+            VarbindIterator &operator++( void ) { current = Varbind( current.raw()->next_variable ); return *this; }
+            VarbindIterator operator++( int ) { VarbindIterator tmp( *this ); operator++(); return tmp; }
+
+            bool operator==( const VarbindIterator &rhs ) const { return current.raw() == rhs.current.raw(); }
+            bool operator!=( const VarbindIterator &rhs ) const { return current.raw() != rhs.current.raw(); }
+
+        protected:
+
+            Varbind current;
+    };
+};
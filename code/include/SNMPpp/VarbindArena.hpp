@@ -0,0 +1,116 @@
+// SNMPpp: https://sourceforge.net/p/snmppp/
+// SNMPpp project uses the MIT license. See LICENSE for details.
+// Copyright (C) 2013 Stephane Charette <stephanecharette@gmail.com>
+
+#pragma once
+
+#include <vector>
+#include <SNMPpp/net-snmppp.hpp>
+#include <SNMPpp/OIDView.hpp>
+
+
+namespace SNMPpp
+{
+    /** Keep copies of varbinds cheaply, by allocating them from a few large
+     * blocks of memory instead of calling `malloc()` for every varbind,
+     * name and value.  All of the copies are released at once by reset()
+     * or when the arena is destroyed, instead of one at a time by
+     * `snmp_free_varbind()`.
+     *
+     * The arena does not make requests or responses any cheaper: net-snmp
+     * still allocates the varbinds of every PDU it decodes, and frees them
+     * one at a time.  What it saves is the cost of the copies kept once the
+     * response is freed, such as the results accumulated by a getBulk loop.
+     * A loop which uses each response and then frees it has nothing to gain
+     * from an arena.
+     *
+     * Copies are normally placed in an arena through a SNMPpp::Varlist:
+     * @code
+     *      SNMPpp::VarbindArena arena;
+     *      SNMPpp::Varlist results( arena );
+     *      while ( ... )
+     *      {
+     *          SNMPpp::UniquePDU response = SNMPpp::getBulk( sessionHandle, request, 50 );
+     *          results.addVarbinds( response.begin(), response.end() );
+     *          ...
+     *      }
+     *      // use the results, then release everything in one shot
+     *      arena.reset();
+     * @endcode
+     *
+     * @note Varbinds from an arena must never be given to net-snmp to free.
+     * This rules out placing them in a request PDU, since net-snmp frees
+     * the request once it has been sent.  Copy them into a normal Varlist
+     * first.  An arena is not thread-safe.
+     */
+    class VarbindArena
+    {
+        public:
+
+            /// Destructor.  Releases all of the memory, which invalidates every varbind created by the arena.
+            virtual ~VarbindArena( void );
+
+            /** Create an arena which allocates memory in blocks of the given
+             * size, with a minimum of 16 KiB.  No memory is allocated until
+             * the first varbind is created.  Each varbind uses a little over
+             * 1 KiB since it includes room for a name of up to MAX_OID_LEN
+             * sub-identifiers.
+             */
+            explicit VarbindArena( const size_t bytesPerBlock = 64 * 1024 );
+
+            VarbindArena( const VarbindArena &rhs ) = delete;
+            VarbindArena &operator=( const VarbindArena &rhs ) = delete;
+
+            /** Return `len` bytes of uninitialized memory, aligned for any
+             * type.  Requests larger than a quarter of a block get a block of
+             * their own.
+             * @throw std::runtime_error if the memory cannot be allocated.
+             */
+            virtual void *allocate( const size_t len );
+
+            /** Create a new varbind with the given name and value.  The
+             * result is laid out exactly like the varbinds net-snmp creates
+             * with `snmp_varlist_add_variable()`, so it can be read by
+             * net-snmp and by the rest of SNMPpp.  The varbind is not linked
+             * to any other varbind.
+             * @throw std::runtime_error if the memory cannot be allocated, or
+             * if net-snmp rejects the value.
+             */
+            virtual netsnmp_variable_list *create( const OIDView &o, const u_char type, const void *value, const size_t len );
+
+            /// Copy the name and value of a single varbind into the arena.  @see create()
+            virtual netsnmp_variable_list *copy( const netsnmp_variable_list *vl ) { return create( OIDView( vl ), vl->type, vl->val.string, vl->val_len ); }
+
+            /** Release every varbind at once.  The blocks are kept so that
+             * the arena can be filled again without calling `malloc()`,
+             * which is what makes an arena cheap to use in a loop.
+             */
+            virtual void reset( void );
+
+            /// The number of bytes handed out since the last reset().
+            virtual size_t bytesUsed( void ) const { return used; }
+
+            /// The number of blocks allocated so far, including the large ones.
+            virtual size_t blockCount( void ) const { return blocks.size() + large.size(); }
+
+        protected:
+
+            /// Size of the regular blocks.
+            const size_t blockSize;
+
+            /// The regular blocks, which are re-used after reset().
+            std::vector< char * > blocks;
+
+            /// Allocations too large for a regular block, which are freed by reset().
+            std::vector< char * > large;
+
+            /// Index into `blocks` of the block currently being filled.
+            size_t current;
+
+            /// Number of bytes used in the current block.
+            size_t offset;
+
+            /// Number of bytes handed out since the last reset().
+            size_t used;
+    };
+};
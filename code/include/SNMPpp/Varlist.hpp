@@ -4,16 +4,39 @@
 
 #pragma once
 
+#include <memory>
+#include <unordered_map>
 #include <SNMPpp/net-snmppp.hpp>
 #include <SNMPpp/OID.hpp>
+#include <SNMPpp/Varbind.hpp>
+#include <SNMPpp/VarbindArena.hpp>
 
 
 namespace SNMPpp
 {
+    /** Hash table of OID -> varbind used by SNMPpp::Varlist::buildIndex().
+     * The keys are views into the names of the varbinds, so the index is
+     * only valid for as long as the varbinds themselves.  When an OID
+     * appears more than once, only the first varbind is indexed, which is
+     * the same one a linear search would find.
+     */
+    struct VarlistIndex
+    {
+        /// The first varbind at the time the index was built.
+        const netsnmp_variable_list *head;
+
+        /// The last varbind at the time the index was built.  Anything appended since is not in the map.
+        const netsnmp_variable_list *tail;
+
+        /// The varbinds, by OID.
+        std::unordered_map< OIDView, netsnmp_variable_list * > map;
+    };
+
     /** Wrapper for net-snmp's snmp_variable_list pointer.
      *
-     * These objects are extremely small (just a pointer) and can easily be
-     * created on the stack or as a member of another class.
+     * These objects are extremely small (a pointer and an optional shared
+     * index) and can easily be created on the stack or as a member of
+     * another class.
      *
      * Many other parts of SNMPpp can accept Varlist objects by reference, and
      * Varlist includes the necessary operators so they can be used wherever
@@ -23,6 +46,10 @@ namespace SNMPpp
     {
         public:
 
+            /// Varlists can only be iterated in one direction, and the varbinds cannot be modified through the iterator.
+            typedef VarbindIterator const_iterator;
+            typedef VarbindIterator iterator;
+
             /** Destructor.
              * @note The destructor does *not* free up the underlying
              * netsnmp_variable_list pointer!  This isn't done automatically
@@ -46,9 +73,56 @@ namespace SNMPpp
              */
             Varlist( netsnmp_variable_list *vl );
 
-            /// Free up the net-snmp structure by calling snmp_free_varbind().  @see clear();
+            /** Create a new object with the given netsnmp_variable_list
+             * pointer and a previously-built index.  This is how
+             * SNMPpp::PDU::varlist() hands out its index.
+             * @see buildIndex()
+             */
+            Varlist( netsnmp_variable_list *vl, const std::shared_ptr< const VarlistIndex > &idx );
+
+            /** Create a new object with the given netsnmp_variable_list
+             * pointer, and a hint to the last varbind in the list so that
+             * appending doesn't need to walk the list.  This is how
+             * SNMPpp::PDU remembers where its varlist ends.
+             * @see back()
+             */
+            Varlist( netsnmp_variable_list *vl, netsnmp_variable_list *last );
+
+            /** Create a new empty object whose varbinds will be allocated
+             * from the given arena instead of by net-snmp.  The arena must
+             * outlive the varbinds.  free() doesn't release anything, the
+             * memory is returned all at once by SNMPpp::VarbindArena::reset().
+             * @note Such a varlist must never be given to net-snmp to free,
+             * for example with SNMPpp::PDU::setVarlist().
+             */
+            explicit Varlist( VarbindArena &a );
+
+            /** Copy the Varlist object.  Both objects reference the same
+             * net-snmp structure, which must only be freed once.
+             */
+            Varlist( const Varlist &rhs );
+
+            /** Move the Varlist object.  The moved-from object is cleared, so
+             * only the new object references the net-snmp structure.
+             */
+            Varlist( Varlist &&rhs ) noexcept;
+
+            /// Copy the Varlist object.  The previous net-snmp structure is *not* freed.  @see Varlist( const Varlist &rhs )
+            virtual Varlist &operator=( const Varlist &rhs );
+
+            /// Move the Varlist object.  The previous net-snmp structure is *not* freed.  @see Varlist( Varlist &&rhs )
+            virtual Varlist &operator=( Varlist &&rhs ) noexcept;
+
+            /** Free up the net-snmp structure by calling snmp_free_varbind().
+             * If the varbinds came from an arena, they are only forgotten,
+             * and the memory is released by SNMPpp::VarbindArena::reset().
+             * @see clear();
+             */
             virtual void free( void );
 
+            /// Return the arena the varbinds are allocated from, or NULL if they are allocated by net-snmp.
+            virtual VarbindArena *getArena( void ) const { return arena; }
+
             /** If a net-snmp function has been called which we know has
              * already freed the netsmp_varlist pointer, call clear() to
              * ensure this C++ wrapper object doesn't keep the pointer to the
@@ -58,13 +132,40 @@ namespace SNMPpp
              * been called.
              * @see free();
              */
-            virtual void clear( void ) { varlist = NULL; }
+            virtual void clear( void ) { varlist = NULL; tail = NULL; index.reset(); }
+
+            /** Build a hash table of all the OIDs in the varlist, so at(),
+             * contains() and all of the getters which take an OID run in
+             * O(1) instead of walking the linked list, including for OIDs
+             * which aren't there.  This is worth doing once after receiving
+             * a response when many values are going to be read out of it.
+             * Copies of this object share the index.
+             *
+             * The index is dropped by the add*() methods, free() and
+             * clear(), and is no longer used once a copy appends to the
+             * varlist.  If the varbinds are modified directly through the
+             * net-snmp pointer, call buildIndex() again or dropIndex().
+             */
+            virtual Varlist &buildIndex( void );
+
+            /// Forget the index built by buildIndex().  Lookups will walk the linked list again.
+            virtual void dropIndex( void ) { index.reset(); }
+
+            /// Return `TRUE` if buildIndex() has been called and the index still matches the varlist, which nothing has been appended to since.
+            virtual bool hasIndex( void ) const { return index && varlist != NULL && index->head == varlist && index->tail != NULL && index->tail->next_variable == NULL; }
+
+            /// Return the index built by buildIndex().  This may be NULL.
+            virtual const std::shared_ptr< const VarlistIndex > &getIndex( void ) const { return index; }
 
             /// Easily convert Varlist to the base net-snmp type for passing into net-snmp API.  Will return NULL if the varlist is empty.
             virtual operator netsnmp_variable_list* ( void ) { return  varlist; }
 
-            /// Easily convert Varlist to the base net-snmp type for passing into net-snmp API.
-            virtual operator netsnmp_variable_list**( void ) { return &varlist; }
+            /** Easily convert Varlist to the base net-snmp type for passing
+             * into net-snmp API.  Since net-snmp may then replace or free
+             * the varbinds, the last varbind remembered by back() is
+             * forgotten.
+             */
+            virtual operator netsnmp_variable_list**( void ) { tail = NULL; return &varlist; }
 
             /** Return the number of variables in this object.  Runs in O(n) as
              * it needs to traverse the entire linked list every time it is
@@ -95,8 +196,20 @@ namespace SNMPpp
             /// Get a map of OID -> net-snmp's varlist for every OID in this varlist.
             virtual MapOidVarList getMap( void ) const;
 
+            /** Get a hash table of OID -> net-snmp's varlist for every OID in
+             * this varlist.  This is usually faster than getMap() both to
+             * build and to query when there are many OIDs.
+             * @see SNMPpp::Varlist::getMap( void ) const
+             */
+            virtual const Varlist &getMap( SNMPpp::UnorderedMapOidVarList &m ) const;
+
             /// See if the given OID is in the varlist.
-            virtual bool contains( const SNMPpp::OID &o ) const;
+            virtual bool contains( const SNMPpp::OID &o ) const { return contains( o.view() ); }
+
+            /** See if the given OID is in the varlist.  This does not copy
+             * the name of any of the varbinds, so no memory is allocated.
+             */
+            virtual bool contains( const SNMPpp::OIDView &o ) const;
 
             virtual Varlist &addBooleanVar( const SNMPpp::OID &o, bool value );
 
@@ -127,19 +240,63 @@ namespace SNMPpp
              */
             virtual Varlist &addNullVars( const SNMPpp::VecOID &v );
 
+            /** Append a copy of a varbind, including its type and value.
+             * This is typically used to keep some of the varbinds from a
+             * response once the response itself has been freed.
+             */
+            virtual Varlist &addVarbind( const SNMPpp::Varbind &vb );
+
+            /** Append a copy of every varbind in the given range.  For
+             * example, to accumulate the results of several requests:
+             * @code
+             *      results.addVarbinds( response.begin(), response.end() );
+             * @endcode
+             * Combined with a SNMPpp::VarbindArena this costs no `malloc()`
+             * at all once the arena has grown to its working size.
+             */
+            virtual Varlist &addVarbinds( const_iterator first, const const_iterator &last );
+
             /** Return the underlying netsnmp_variable_list pointer which
              * describes the given OID object.  The net-snmp type contains
              * everything net-snmp currently knows about an OID, including
              * a pointer to the next variable which is how net-snmp uses this
              * structure to describe both specific OIDs and vectors of OIDs.
              * This method will throw if the requested OID does not exist
-             * in the varlist.
+             * in the varlist.  Runs in O(n), or O(1) after buildIndex().
+             */
+            virtual const netsnmp_variable_list *at( const SNMPpp::OID &o ) const { return at( o.view() ); }
+
+            /// Same as at( const SNMPpp::OID &o ) but without needing a SNMPpp::OID object.
+            virtual const netsnmp_variable_list *at( const SNMPpp::OIDView &o ) const;
+
+            /** Return the last varbind, or NULL if the varlist is empty.  The
+             * last varbind is remembered, so appending to a varlist with
+             * any of the add*() methods runs in O(1) instead of walking the
+             * entire linked list every time, and building a request with N
+             * OIDs is O(N).
              */
-            virtual const netsnmp_variable_list *at( const SNMPpp::OID &o ) const;
+            virtual netsnmp_variable_list *back( void ) const;
 
-            /// Return the [N]th netsnmp_variable_list pointer.
+            /// Return the [N]th netsnmp_variable_list pointer.  Runs in O(n).  @see begin()
             virtual netsnmp_variable_list *operator[]( const size_t idx );
 
+            /** Iterate through the varbinds in the order in which they
+             * appear in the linked list.  This is the fastest way to process
+             * every varbind in a response, since it doesn't need to look up
+             * any OIDs and never allocates memory:
+             * @code
+             *      for ( SNMPpp::Varlist::const_iterator iter = varlist.begin(); iter != varlist.end(); ++ iter )
+             *      {
+             *          std::cout << iter->name() << ": " << iter->asString() << std::endl;
+             *      }
+             * @endcode
+             * @see SNMPpp::Varbind
+             */
+            virtual const_iterator begin( void ) const { return const_iterator( varlist ); }
+
+            /// The end of the varbinds.  @see begin()
+            virtual const_iterator end( void ) const { return const_iterator(); }
+
             /// Return the first OID object in the varlist.  This will throw if the varlist is empty.
             virtual SNMPpp::OID firstOID( void ) const;
 
@@ -201,9 +358,36 @@ namespace SNMPpp
              */
             virtual SNMPpp::OID getOID( const SNMPpp::OID &o ) const;
 
+            /** Retrieve the value of the given Counter32, Gauge32, TimeTicks
+             * or UInteger32 OID.  Unlike getLong(), this accepts all of the
+             * unsigned 32-bit types.
+             * @see SNMPpp::Varbind::getUnsigned()
+             */
+            virtual unsigned long getUnsigned( const SNMPpp::OID &o ) const;
+
+            /** Retrieve the value of the given Counter64 OID.
+             * @see SNMPpp::Varbind::getCounter64()
+             */
+            virtual uint64_t getCounter64( const SNMPpp::OID &o ) const;
+
+            /** Retrieve the value of the given Opaque float or double OID.
+             * @see SNMPpp::Varbind::getDouble()
+             */
+            virtual double getDouble( const SNMPpp::OID &o ) const;
+
+            /** Decode the value of the given OID regardless of its ASN type,
+             * without converting it to text.
+             * @see SNMPpp::Value
+             */
+            virtual SNMPpp::Value getValue( const SNMPpp::OID &o ) const;
+
             /** Convert any of the known basic ASN types to a easy-to-use text
              * string.  E.g., booleans are converted to the text strings
-             * "true" and "false", etc.
+             * "true" and "false", etc.  The text is formatted natively
+             * without consulting the MIBs; use
+             * SNMPpp::Varbind::asNetSnmpString() if enumeration labels are
+             * needed.
+             * @see SNMPpp::formatValue()
              * @see SNMPpp::Varlist::asString( void ) const
              */
             virtual std::string asString( const SNMPpp::OID &o ) const;
@@ -258,6 +442,18 @@ namespace SNMPpp
              */
             virtual SNMPpp::OID getOID( void ) const { return getOID( firstOID() ); }
 
+            /// Similar to SNMPpp::Varlist::getUnsigned( const SNMPpp::OID &o ) const but uses the first object in the varlist.
+            virtual unsigned long getUnsigned( void ) const { return getUnsigned( firstOID() ); }
+
+            /// Similar to SNMPpp::Varlist::getCounter64( const SNMPpp::OID &o ) const but uses the first object in the varlist.
+            virtual uint64_t getCounter64( void ) const { return getCounter64( firstOID() ); }
+
+            /// Similar to SNMPpp::Varlist::getDouble( const SNMPpp::OID &o ) const but uses the first object in the varlist.
+            virtual double getDouble( void ) const { return getDouble( firstOID() ); }
+
+            /// Similar to SNMPpp::Varlist::getValue( const SNMPpp::OID &o ) const but uses the first object in the varlist.
+            virtual SNMPpp::Value getValue( void ) const { return getValue( firstOID() ); }
+
             /** Similar to SNMPpp::Varlist::asString( const SNMPpp::OID &o ) const
              * but if the varlist contains multiple objects, assumes only the
              * first one is of interest.
@@ -267,8 +463,29 @@ namespace SNMPpp
 
         protected:
 
+            /** Append a new varbind to the end of the varlist.  This is
+             * what all of the add*() methods call.
+             * @throw std::invalid_argument if the OID is empty.
+             * @throw std::runtime_error if net-snmp failed to add the OID.
+             */
+            virtual netsnmp_variable_list *addVariable( const SNMPpp::OIDView &o, const u_char type, const void *value, const size_t len );
+
+            /** Find the first varbind with the given OID, using the index if
+             * there is one.  Returns NULL if the OID is not in the varlist.
+             */
+            virtual netsnmp_variable_list *lookup( const SNMPpp::OIDView &o ) const;
+
             /// This is the basic varlist pointer from net-snmp.  Beware, this pointer will be NULL when a varlist is empty.
             netsnmp_variable_list *varlist;
+
+            /// The last varbind, or NULL if not yet known.  @see back()
+            mutable netsnmp_variable_list *tail;
+
+            /// Optional index built by buildIndex().  @see hasIndex()
+            std::shared_ptr< const VarlistIndex > index;
+
+            /// Where the varbinds are allocated, or NULL if net-snmp allocates them.  @see Varlist( VarbindArena &a )
+            VarbindArena *arena;
     };
 };
 
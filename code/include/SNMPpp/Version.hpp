@@ -0,0 +1,24 @@
+// SNMPpp: https://sourceforge.net/p/snmppp/
+// SNMPpp project uses the MIT license. See LICENSE for details.
+// Copyright (C) 2013 Stephane Charette <stephanecharette@gmail.com>
+
+#pragma once
+
+/** @file Version.hpp
+ * If you get an error about Version.hpp not existing, please note it is
+ * automatically generated by cmake during the build process.  See the file
+ * "doc/getting_started.txt" for instructions on setting up a build
+ * directory which will also create this file with the proper content.
+ *
+ * If you are a developer who has installed a package such as snmppp-dev.deb
+ * or snmppp-dev.rpm and it is missing Version.hpp, please contact whoever
+ * created the broken package, or visit the SNMPpp project web page for help.
+ */
+
+#ifndef LIBSNMPPPVER
+/** The SNMP version \#define is automatically updated by CMake.
+ * @note Do not manually edit this file.  Your changes will be undone.
+ * Instead, see Version.hpp.in.
+ */
+#define LIBSNMPPPVER "0.0.0-0-000000"
+#endif
@@ -0,0 +1,244 @@
+// SNMPpp: https://sourceforge.net/p/snmppp/
+// SNMPpp project uses the MIT license. See LICENSE for details.
+// Copyright (C) 2013 Stephane Charette <stephanecharette@gmail.com>
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#ifndef WIN32
+#include <sys/select.h>
+#endif
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+#include <SNMPpp/AsyncEngine.hpp>
+
+
+SNMPpp::AsyncEngine::~AsyncEngine( void )
+{
+    // net-snmp still references these requests, and will eventually hand
+    // them back to dispatch() when they time out or the session is closed
+    for ( Request *request : pending )
+    {
+        request->engine = NULL;
+    }
+
+    return;
+}
+
+
+SNMPpp::AsyncEngine::AsyncEngine( void ) :
+    completed( 0 )
+{
+    return;
+}
+
+
+int SNMPpp::AsyncEngine::sendAsync( SNMPpp::SessionHandle &session, SNMPpp::PDU &request, const Callback &callback )
+{
+    netsnmp_pdu *pdu = request;
+    if ( pdu == NULL )
+    {
+        /// @throw std::invalid_argument if the PDU is empty.
+        throw std::invalid_argument( "Request PDU must not be NULL." );
+    }
+    if ( session == NULL )
+    {
+        request.free();
+        /// @throw std::invalid_argument if the session handle is NULL.
+        throw std::invalid_argument( "Session handle must not be NULL." );
+    }
+
+    Request *r  = new Request;
+    r->engine   = this;
+    r->session  = session;
+    r->callback = callback;
+
+    const int reqid = snmp_sess_async_send( session, pdu, dispatch, r );
+    if ( reqid == 0 )
+    {
+        // net-snmp only takes ownership of the request once it has been sent
+        delete r;
+        request.free();
+
+        int error1 = 0;
+        int error2 = 0;
+        char *msg  = NULL;
+        snmp_sess_error( session, &error1, &error2, &msg );
+        std::stringstream ss;
+        ss  << "Failed to send. ["
+            << "cliberrno=" << error1 << ", "
+            << "snmperrno=" << error2;
+        if ( msg != NULL && msg[0] != '\0' )
+        {
+            ss << ", " << msg;
+        }
+        ss << "]";
+
+        ::free( msg );
+        /// @throw std::runtime_error if snmp_sess_async_send() fails.
+        throw std::runtime_error( ss.str() );
+    }
+
+    // the request PDU now belongs to net-snmp
+    request.clear();
+    pending.insert( r );
+    sessions[ session ] ++;
+
+    return reqid;
+}
+
+
+int SNMPpp::AsyncEngine::dispatch( int operation, netsnmp_session *session, int reqid, netsnmp_pdu *pdu, void *magic )
+{
+    Request *request = static_cast< Request * >( magic );
+
+    int status = STAT_ERROR;
+    switch ( operation )
+    {
+        case NETSNMP_CALLBACK_OP_RECEIVED_MESSAGE:
+            status = STAT_SUCCESS;
+            break;
+
+        case NETSNMP_CALLBACK_OP_TIMED_OUT:
+            status = STAT_TIMEOUT;
+            pdu = NULL; // this is the request, not a response
+            break;
+
+        case NETSNMP_CALLBACK_OP_SEND_FAILED:
+            status = STAT_ERROR;
+            pdu = NULL;
+            break;
+
+        default:
+            // connection events and retries don't complete the request
+            return 1;
+    }
+
+    if ( request->engine == NULL )
+    {
+        // the engine has been destroyed, so nobody is waiting for this
+        delete request;
+    }
+    else
+    {
+        request->engine->complete( request, status, pdu );
+    }
+
+    return 1;
+}
+
+
+void SNMPpp::AsyncEngine::complete( Request *request, const int status, netsnmp_pdu *pdu )
+{
+    pending.erase( request );
+    std::map< SNMPpp::SessionHandle, size_t >::iterator iter = sessions.find( request->session );
+    if ( iter != sessions.end() && -- iter->second == 0 )
+    {
+        sessions.erase( iter );
+    }
+    completed ++;
+
+    // exceptions must never unwind through net-snmp, so they are kept until poll() returns
+    try
+    {
+        const SNMPpp::PDU response( pdu );
+        request->callback( status, request->session, response );
+    }
+    catch ( ... )
+    {
+        if ( ! failure )
+        {
+            failure = std::current_exception();
+        }
+    }
+    delete request;
+
+    return;
+}
+
+
+size_t SNMPpp::AsyncEngine::poll( const int milliseconds )
+{
+    const size_t before = completed;
+
+    // callbacks may send new requests or close sessions, so work from a copy
+    std::vector< SNMPpp::SessionHandle > handles;
+    handles.reserve( sessions.size() );
+    for ( const auto &iter : sessions )
+    {
+        handles.push_back( iter.first );
+    }
+
+    int numfds = 0;
+    fd_set fds;
+    FD_ZERO( &fds );
+    struct timeval timeout;
+    timeout.tv_sec  = milliseconds < 0 ? 0 : milliseconds / 1000;
+    timeout.tv_usec = milliseconds < 0 ? 0 : milliseconds % 1000 * 1000;
+    int block = milliseconds < 0 ? 1 : 0;
+    for ( size_t idx = 0; idx < handles.size(); idx ++ )
+    {
+        // lowers the timeout to the next retry or timeout of this session
+        snmp_sess_select_info( handles[idx], &numfds, &fds, &timeout, &block );
+    }
+
+    if ( handles.empty() && block )
+    {
+        // nothing to wait for, so waiting forever would never return
+        return 0;
+    }
+
+    const int count = select( numfds, &fds, NULL, NULL, block ? NULL : &timeout );
+    if ( count < 0 && errno != EINTR )
+    {
+        /// @throw std::runtime_error if select() fails.
+        throw std::runtime_error( std::string( "Failed to wait for replies: " ) + strerror( errno ) );
+    }
+
+    for ( size_t idx = 0; idx < handles.size(); idx ++ )
+    {
+        if ( sessions.count( handles[idx] ) == 0 )
+        {
+            // every request on this session has already completed
+            continue;
+        }
+        if ( count > 0 )
+        {
+            snmp_sess_read( handles[idx], &fds );
+        }
+        if ( sessions.count( handles[idx] ) )
+        {
+            snmp_sess_timeout( handles[idx] );
+        }
+    }
+
+    rethrowFailure();
+
+    return completed - before;
+}
+
+
+void SNMPpp::AsyncEngine::rethrowFailure( void )
+{
+    if ( failure )
+    {
+        std::exception_ptr e = failure;
+        failure = std::exception_ptr();
+        /// @throw Any exception thrown by a callback.
+        std::rethrow_exception( e );
+    }
+
+    return;
+}
+
+
+void SNMPpp::AsyncEngine::run( void )
+{
+    while ( ! pending.empty() )
+    {
+        poll( -1 );
+    }
+
+    return;
+}
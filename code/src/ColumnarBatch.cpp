@@ -0,0 +1,289 @@
+// SNMPpp: https://sourceforge.net/p/snmppp/
+// SNMPpp project uses the MIT license. See LICENSE for details.
+// Copyright (C) 2013 Stephane Charette <stephanecharette@gmail.com>
+
+#include <string.h>
+#include <stdexcept>
+#include <SNMPpp/ColumnarBatch.hpp>
+
+
+/// Offsets are 32-bit to keep the columns small, so neither buffer may grow past this.
+static const size_t kMaxOffset = 0xffffffff;
+
+
+/// Round the start of an object identifier value up so it can be read in place.
+static size_t alignForOid( const size_t offset )
+{
+    return ( offset + sizeof(oid) - 1 ) / sizeof(oid) * sizeof(oid);
+}
+
+
+SNMPpp::ColumnarBatch::~ColumnarBatch( void )
+{
+    return;
+}
+
+
+SNMPpp::ColumnarBatch::ColumnarBatch( void )
+{
+    clear();
+
+    return;
+}
+
+
+SNMPpp::ColumnarBatch::ColumnarBatch( const SNMPpp::Varlist &varlist )
+{
+    clear();
+    append( varlist );
+
+    return;
+}
+
+
+SNMPpp::ColumnarBatch::ColumnarBatch( const SNMPpp::PDU &pdu )
+{
+    clear();
+    append( pdu );
+
+    return;
+}
+
+
+void SNMPpp::ColumnarBatch::reserve( const size_t rows, const size_t subidsPerRow, const size_t heapBytes )
+{
+    subids      .reserve( rows * subidsPerRow );
+    offsets     .reserve( rows + 1 );
+    asnTypes    .reserve( rows );
+    valueKinds  .reserve( rows );
+    numeric     .reserve( rows );
+    values      .reserve( heapBytes );
+    heapOffsets .reserve( rows + 1 );
+
+    return;
+}
+
+
+void SNMPpp::ColumnarBatch::clear( void )
+{
+    subids      .clear();
+    offsets     .clear();
+    asnTypes    .clear();
+    valueKinds  .clear();
+    numeric     .clear();
+    values      .clear();
+    heapOffsets .clear();
+
+    // the end of the last row is always there, which is also the start of the next one
+    offsets     .push_back( 0 );
+    heapOffsets .push_back( 0 );
+
+    return;
+}
+
+
+SNMPpp::ColumnarBatch &SNMPpp::ColumnarBatch::append( const SNMPpp::Varbind &vb )
+{
+    const SNMPpp::OIDView o = vb.name();
+    const SNMPpp::Value v = vb.getValue();
+
+    size_t heapSize = values.size();
+    if ( v.getKind() == SNMPpp::Value::kBytes )
+    {
+        heapSize += v.size();
+    }
+    else if ( v.getKind() == SNMPpp::Value::kObjectId )
+    {
+        heapSize = alignForOid( heapSize ) + v.size() * sizeof(oid);
+    }
+
+    if ( subids.size() + o.size() > kMaxOffset || heapSize > kMaxOffset )
+    {
+        /// @throw std::length_error if the names or the heap would go over 4 GiB.
+        throw std::length_error( "Too many varbinds for a single columnar batch." );
+    }
+
+    subids.insert( subids.end(), o.data(), o.data() + o.size() );
+    offsets.push_back( static_cast< uint32_t >( subids.size() ) );
+    asnTypes.push_back( static_cast< uint8_t >( vb.asnType() ) );
+    valueKinds.push_back( static_cast< uint8_t >( v.getKind() ) );
+
+    uint64_t number = 0;
+    switch ( v.getKind() )
+    {
+        case SNMPpp::Value::kSigned:
+            number = static_cast< uint64_t >( v.asSigned() );
+            break;
+
+        case SNMPpp::Value::kUnsigned:
+            number = v.asUnsigned();
+            break;
+
+        case SNMPpp::Value::kDouble:
+        {
+            const double d = v.asDouble();
+            memcpy( &number, &d, sizeof(number) );
+            break;
+        }
+
+        case SNMPpp::Value::kBytes:
+            values.insert( values.end(), v.data(), v.data() + v.size() );
+            break;
+
+        case SNMPpp::Value::kObjectId:
+        {
+            const SNMPpp::OIDView objid = v.getOIDView();
+            values.resize( heapSize );
+            if ( ! objid.empty() )
+            {
+                memcpy( &values[ heapSize - objid.size() * sizeof(oid) ], objid.data(), objid.size() * sizeof(oid) );
+            }
+            break;
+        }
+
+        case SNMPpp::Value::kNone:
+            break;
+    }
+    numeric.push_back( number );
+    heapOffsets.push_back( static_cast< uint32_t >( values.size() ) );
+
+    return *this;
+}
+
+
+SNMPpp::ColumnarBatch &SNMPpp::ColumnarBatch::append( const SNMPpp::Varlist &varlist )
+{
+    for ( SNMPpp::Varlist::const_iterator iter = varlist.begin(); iter != varlist.end(); ++ iter )
+    {
+        append( *iter );
+    }
+
+    return *this;
+}
+
+
+SNMPpp::ColumnarBatch &SNMPpp::ColumnarBatch::append( const SNMPpp::PDU &pdu )
+{
+    for ( SNMPpp::Varlist::const_iterator iter = pdu.begin(); iter != pdu.end(); ++ iter )
+    {
+        append( *iter );
+    }
+
+    return *this;
+}
+
+
+int64_t SNMPpp::ColumnarBatch::asSigned( const size_t row ) const
+{
+    switch ( kind( row ) )
+    {
+        case SNMPpp::Value::kSigned:
+        case SNMPpp::Value::kUnsigned:
+            return static_cast< int64_t >( numeric[row] );
+
+        case SNMPpp::Value::kDouble:
+            return static_cast< int64_t >( asDouble( row ) );
+
+        default:
+            break;
+    }
+
+    return 0;
+}
+
+
+uint64_t SNMPpp::ColumnarBatch::asUnsigned( const size_t row ) const
+{
+    switch ( kind( row ) )
+    {
+        case SNMPpp::Value::kSigned:
+        case SNMPpp::Value::kUnsigned:
+            return numeric[row];
+
+        case SNMPpp::Value::kDouble:
+            return static_cast< uint64_t >( asDouble( row ) );
+
+        default:
+            break;
+    }
+
+    return 0;
+}
+
+
+double SNMPpp::ColumnarBatch::asDouble( const size_t row ) const
+{
+    switch ( kind( row ) )
+    {
+        case SNMPpp::Value::kSigned:
+            return static_cast< double >( static_cast< int64_t >( numeric[row] ) );
+
+        case SNMPpp::Value::kUnsigned:
+            return static_cast< double >( numeric[row] );
+
+        case SNMPpp::Value::kDouble:
+        {
+            double d = 0.0;
+            memcpy( &d, &numeric[row], sizeof(d) );
+            return d;
+        }
+
+        default:
+            break;
+    }
+
+    return 0.0;
+}
+
+
+const u_char *SNMPpp::ColumnarBatch::bytes( const size_t row ) const
+{
+    if ( kind( row ) != SNMPpp::Value::kBytes )
+    {
+        return NULL;
+    }
+
+    return values.data() + heapOffsets[row];
+}
+
+
+size_t SNMPpp::ColumnarBatch::valueLength( const size_t row ) const
+{
+    if ( kind( row ) != SNMPpp::Value::kBytes )
+    {
+        return 0;
+    }
+
+    return heapOffsets[row + 1] - heapOffsets[row];
+}
+
+
+std::string SNMPpp::ColumnarBatch::getBytes( const size_t row ) const
+{
+    const u_char *p = bytes( row );
+    if ( p == NULL )
+    {
+        return "";
+    }
+
+    return std::string( reinterpret_cast< const char * >( p ), valueLength( row ) );
+}
+
+
+SNMPpp::OIDView SNMPpp::ColumnarBatch::getOIDView( const size_t row ) const
+{
+    if ( kind( row ) != SNMPpp::Value::kObjectId )
+    {
+        return SNMPpp::OIDView();
+    }
+
+    // skip the padding, which is always less than the size of one oid
+    const size_t start = alignForOid( heapOffsets[row] );
+    const size_t len = ( heapOffsets[row + 1] - start ) / sizeof(oid);
+    if ( len == 0 )
+    {
+        return SNMPpp::OIDView();
+    }
+
+    return SNMPpp::OIDView( reinterpret_cast< const oid * >( values.data() + start ), len );
+}
@@ -0,0 +1,454 @@
+// SNMPpp: https://sourceforge.net/p/snmppp/
+// SNMPpp project uses the MIT license. See LICENSE for details.
+// Copyright (C) 2013 Stephane Charette <stephanecharette@gmail.com>
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <SNMPpp/Format.hpp>
+#include <SNMPpp/Value.hpp>
+
+
+/** Append text to the caller's buffer, while keeping track of how much
+ * space would have been needed so the caller can try again with a larger
+ * buffer.  This is the same contract as SNMPpp::OIDView::format().
+ */
+class FormatBuffer
+{
+    public:
+
+        FormatBuffer( char *b, const size_t l ) : buf( b ), len( l ), total( 0 ) { return; }
+
+        void put( const char c )
+        {
+            if ( total < len )
+            {
+                buf[total] = c;
+            }
+            total ++;
+
+            return;
+        }
+
+        void put( const char *s, const size_t n )
+        {
+            if ( total + n <= len )
+            {
+                memcpy( buf + total, s, n );
+            }
+            else if ( total < len )
+            {
+                memcpy( buf + total, s, len - total );
+            }
+            total += n;
+
+            return;
+        }
+
+        void put( const char *s ) { put( s, strlen( s ) ); }
+
+        /// Write an unsigned number in base 2, 8, 10 or 16, zero-padded to at least `width` digits.
+        void putUnsigned( uint64_t value, const unsigned base = 10, const size_t width = 1 )
+        {
+            char tmp[64];
+            char * const end = tmp + sizeof(tmp);
+            char *begin = end;
+            do
+            {
+                *--begin = "0123456789abcdef"[ value % base ];
+                value /= base;
+            }
+            while ( value > 0 );
+            while ( size_t( end - begin ) < width )
+            {
+                *--begin = '0';
+            }
+            put( begin, end - begin );
+
+            return;
+        }
+
+        void putSigned( const int64_t value, const unsigned base = 10 )
+        {
+            if ( value < 0 )
+            {
+                put( '-' );
+                putUnsigned( 0 - static_cast<uint64_t>( value ), base );
+            }
+            else
+            {
+                putUnsigned( value, base );
+            }
+
+            return;
+        }
+
+        void putHex( const u_char *data, const size_t n )
+        {
+            for ( size_t idx = 0; idx < n; idx ++ )
+            {
+                if ( idx > 0 )
+                {
+                    put( ' ' );
+                }
+                put( "0123456789ABCDEF"[ data[idx] >> 4   ] );
+                put( "0123456789ABCDEF"[ data[idx] & 0x0f ] );
+            }
+
+            return;
+        }
+
+        /// Account for text which was written directly into the buffer.
+        void skip( const size_t n ) { total += n; }
+
+        size_t size( void ) const { return total; }
+
+    protected:
+
+        char * const    buf;
+        const size_t    len;
+        size_t          total;
+};
+
+
+/// Apply an integer DISPLAY-HINT such as "d-2", "x", "o" or "b".  See RFC 2579, section 3.1.
+static void formatHintedInteger( FormatBuffer &w, const SNMPpp::Value &v, const char *hint )
+{
+    const bool      negative    = ( v.getKind() == SNMPpp::Value::kSigned && v.asSigned() < 0 );
+    const uint64_t  magnitude   = ( negative ? 0 - v.asUnsigned() : v.asUnsigned() );
+
+    const unsigned base = ( hint[0] == 'x' ? 16 : hint[0] == 'o' ? 8 : hint[0] == 'b' ? 2 : 10 );
+    if ( base != 10 )
+    {
+        if ( negative )
+        {
+            w.put( '-' );
+        }
+        w.putUnsigned( magnitude, base );
+        return;
+    }
+
+    // "d" optionally followed by "-n" to insert a decimal point n digits from the right
+    const size_t decimals = ( hint[1] == '-' ? strtoul( hint + 2, NULL, 10 ) : 0 );
+    if ( negative )
+    {
+        w.put( '-' );
+    }
+    if ( decimals == 0 || decimals > 19 )
+    {
+        w.putUnsigned( magnitude );
+        return;
+    }
+
+    uint64_t divisor = 1;
+    for ( size_t idx = 0; idx < decimals; idx ++ )
+    {
+        divisor *= 10;
+    }
+    w.putUnsigned( magnitude / divisor );
+    w.put( '.' );
+    w.putUnsigned( magnitude % divisor, 10, decimals );
+
+    return;
+}
+
+
+/// One part of an OCTET STRING DISPLAY-HINT, such as "1x:" or "*1d.".
+struct OctetSpec
+{
+    bool            repeat;
+    size_t          length;
+    char            format;
+    char            separator;
+    char            terminator;
+};
+
+
+/// Parse the next part of an OCTET STRING DISPLAY-HINT.  Returns false if the hint is invalid.
+static bool parseOctetSpec( const char *&hint, OctetSpec &spec )
+{
+    spec.repeat     = false;
+    spec.length     = 0;
+    spec.format     = 0;
+    spec.separator  = 0;
+    spec.terminator = 0;
+
+    if ( *hint == '*' )
+    {
+        spec.repeat = true;
+        hint ++;
+    }
+    if ( ! isdigit( *hint ) )
+    {
+        return false;
+    }
+    while ( isdigit( *hint ) )
+    {
+        spec.length = spec.length * 10 + ( *hint - '0' );
+        hint ++;
+    }
+    if ( spec.length == 0 || strchr( "xdoat", *hint ) == NULL || *hint == '\0' )
+    {
+        return false;
+    }
+    spec.format = *hint ++;
+
+    if ( *hint != '\0' && *hint != '*' && ! isdigit( *hint ) )
+    {
+        spec.separator = *hint ++;
+        if ( spec.repeat && *hint != '\0' && *hint != '*' && ! isdigit( *hint ) )
+        {
+            spec.terminator = *hint ++;
+        }
+    }
+
+    return true;
+}
+
+
+/** Apply an OCTET STRING DISPLAY-HINT such as "1x:" or "255a".  See RFC
+ * 2579, section 3.1.  Returns false if the hint is invalid, in which case
+ * nothing has been written.
+ */
+static bool formatHintedOctets( FormatBuffer &w, const u_char *data, const size_t n, const char *hint )
+{
+    // validate the complete hint before writing anything
+    OctetSpec spec;
+    for ( const char *p = hint; *p != '\0'; )
+    {
+        if ( ! parseOctetSpec( p, spec ) )
+        {
+            return false;
+        }
+    }
+
+    size_t pos = 0;
+    while ( pos < n )
+    {
+        // once the hint is exhausted, the last part is used until the data is exhausted
+        if ( *hint != '\0' )
+        {
+            parseOctetSpec( hint, spec );
+        }
+
+        size_t repetitions = 1;
+        if ( spec.repeat )
+        {
+            repetitions = data[pos ++];
+        }
+
+        for ( size_t r = 0; r < repetitions && pos < n; r ++ )
+        {
+            const size_t chunk = ( n - pos < spec.length ? n - pos : spec.length );
+            if ( spec.format == 'a' || spec.format == 't' )
+            {
+                w.put( reinterpret_cast<const char *>( data + pos ), chunk );
+            }
+            else
+            {
+                uint64_t value = 0;
+                for ( size_t idx = 0; idx < chunk; idx ++ )
+                {
+                    value = ( value << 8 ) | data[ pos + idx ];
+                }
+                w.putUnsigned( value, spec.format == 'x' ? 16 : spec.format == 'o' ? 8 : 10 );
+            }
+            pos += chunk;
+
+            if ( pos < n )
+            {
+                if ( spec.terminator != 0 && r + 1 == repetitions )
+                {
+                    w.put( spec.terminator );
+                }
+                else if ( spec.separator != 0 )
+                {
+                    w.put( spec.separator );
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+
+size_t SNMPpp::formatValue( const netsnmp_variable_list *vl, char *buf, const size_t len, const char *hint )
+{
+    FormatBuffer w( buf, len );
+    const SNMPpp::Value v( vl );
+
+    if ( hint != NULL && hint[0] == '\0' )
+    {
+        hint = NULL;
+    }
+
+    switch ( v.asnType() )
+    {
+        case ASN_BOOLEAN:
+        {
+            if ( v.empty() )
+            {
+                // no value to go with the type, same as the other valueless types
+                w.put( "NULL" );
+                break;
+            }
+
+            w.put( v.asSigned() != 0 ? "true" : "false" );
+            break;
+        }
+        case ASN_TIMETICKS:
+        {
+            if ( v.empty() )
+            {
+                w.put( "NULL" );
+                break;
+            }
+
+            // same format as net-snmp's uptime_string()
+            const uint64_t ticks    = v.asUnsigned();
+            const uint64_t days     = ticks / 8640000;
+            const uint64_t hours    = ticks / 360000 % 24;
+            const uint64_t minutes  = ticks / 6000 % 60;
+            const uint64_t seconds  = ticks / 100 % 60;
+            w.put( '(' );
+            w.putUnsigned( ticks );
+            w.put( ") " );
+            if ( days > 0 )
+            {
+                w.putUnsigned( days );
+                w.put( days == 1 ? " day, " : " days, " );
+            }
+            w.putUnsigned( hours );
+            w.put( ':' );
+            w.putUnsigned( minutes, 10, 2 );
+            w.put( ':' );
+            w.putUnsigned( seconds, 10, 2 );
+            w.put( '.' );
+            w.putUnsigned( ticks % 100, 10, 2 );
+            break;
+        }
+        case ASN_IPADDRESS:
+        {
+            for ( size_t idx = 0; idx < v.size(); idx ++ )
+            {
+                if ( idx > 0 )
+                {
+                    w.put( '.' );
+                }
+                w.putUnsigned( v.data()[idx] );
+            }
+            break;
+        }
+        case ASN_OCTET_STR:
+        {
+            if ( hint != NULL && formatHintedOctets( w, v.data(), v.size(), hint ) )
+            {
+                break;
+            }
+
+            bool printable = true;
+            for ( size_t idx = 0; printable && idx < v.size(); idx ++ )
+            {
+                printable = ( isprint( v.data()[idx] ) || isspace( v.data()[idx] ) );
+            }
+            if ( printable )
+            {
+                w.put( reinterpret_cast<const char *>( v.data() ), v.size() );
+            }
+            else
+            {
+                w.putHex( v.data(), v.size() );
+            }
+            break;
+        }
+        case SNMP_NOSUCHOBJECT:
+        {
+            w.put( "No Such Object available on this agent at this OID" );
+            break;
+        }
+        case SNMP_NOSUCHINSTANCE:
+        {
+            w.put( "No Such Instance currently exists at this OID" );
+            break;
+        }
+        case SNMP_ENDOFMIBVIEW:
+        {
+            w.put( "No more variables left in this MIB View (It is past the end of the MIB tree)" );
+            break;
+        }
+        default:
+        {
+            switch ( v.getKind() )
+            {
+                case SNMPpp::Value::kNone:
+                {
+                    w.put( "NULL" );
+                    break;
+                }
+                case SNMPpp::Value::kSigned:
+                case SNMPpp::Value::kUnsigned:
+                {
+                    if ( hint != NULL && strchr( "dxob", hint[0] ) != NULL )
+                    {
+                        formatHintedInteger( w, v, hint );
+                    }
+                    else if ( v.getKind() == SNMPpp::Value::kSigned )
+                    {
+                        w.putSigned( v.asSigned() );
+                    }
+                    else
+                    {
+                        w.putUnsigned( v.asUnsigned() );
+                    }
+                    break;
+                }
+                case SNMPpp::Value::kDouble:
+                {
+                    char tmp[64];
+                    const int n = snprintf( tmp, sizeof(tmp), "%f", v.asDouble() );
+                    if ( n > 0 )
+                    {
+                        w.put( tmp, n < int(sizeof(tmp)) ? n : sizeof(tmp) - 1 );
+                    }
+                    break;
+                }
+                case SNMPpp::Value::kBytes:
+                {
+                    w.putHex( v.data(), v.size() );
+                    break;
+                }
+                case SNMPpp::Value::kObjectId:
+                {
+                    // nothing else has been written, so the view can write directly into the buffer
+                    w.skip( v.getOIDView().format( buf, len ) );
+                    break;
+                }
+            }
+            break;
+        }
+    }
+
+    return w.size();
+}
+
+
+const char *SNMPpp::displayHint( const SNMPpp::OIDView &o )
+{
+    const char *hint = NULL;
+
+    if ( ! o.empty() )
+    {
+        // get_tree() returns the closest match, which for a table instance
+        // such as ifPhysAddress.3 is the column where the hint is defined
+        const struct tree *t = get_tree( o.data(), o.size(), get_tree_head() );
+        if ( t != NULL )
+        {
+            hint = t->hint;
+        }
+    }
+
+    return hint;
+}
@@ -4,11 +4,15 @@
 
 #include <stdexcept>
 #include <sstream>
+#include <deque>
+#include <utility>
+#include <vector>
+#include <stdint.h>
 #include <stdlib.h>
 #include <SNMPpp/Get.hpp>
 
 
-SNMPpp::PDU SNMPpp::sync( SNMPpp::SessionHandle &session, SNMPpp::PDU &request )
+int SNMPpp::trySync( SNMPpp::SessionHandle &session, SNMPpp::PDU &request, SNMPpp::PDU &response )
 {
     netsnmp_pdu *pdu = request;
     if ( pdu == NULL )
@@ -24,37 +28,57 @@ SNMPpp::PDU SNMPpp::sync( SNMPpp::SessionHandle &session, SNMPpp::PDU &request )
     }
 
     // send out this request and wait until we have a reply
-    netsnmp_pdu *response = NULL;
-    const int status = snmp_sess_synch_response( session, pdu, &response );
+    netsnmp_pdu *p = NULL;
+    const int status = snmp_sess_synch_response( session, pdu, &p );
 
     // the request PDU has been freed by net-snmp and no longer exists
     request.clear();
+    response = SNMPpp::PDU( p );
 
-    if (    response            == NULL                 ||
-            response->errstat   != SNMP_ERR_NOERROR     ||
-            status              != STAT_SUCCESS         )
+    return status;
+}
+
+
+/// Describe the last error from net-snmp, and throw.  @see SNMPpp::sync()
+static void throwError( SNMPpp::SessionHandle &session )
+{
+    int error1 = 0;
+    int error2 = 0;
+    char *msg  = NULL;
+    snmp_sess_error( session, &error1, &error2, &msg );
+    std::stringstream ss;
+    ss  << "Failed to get. ["
+        << "cliberrno=" << error1 << ", "
+        << "snmperrno=" << error2;
+    if ( msg != NULL && msg[0] != '\0' )
     {
-        int error1 = 0;
-        int error2 = 0;
-        char *msg  = NULL;
-        snmp_sess_error( session, &error1, &error2, &msg );
-        std::stringstream ss;
-        ss  << "Failed to get. ["
-            << "cliberrno=" << error1 << ", "
-            << "snmperrno=" << error2;
-        if ( msg != NULL && msg[0] != '\0' )
-        {
-            ss << ", " << msg;
-        }
-        ss << "]";
+        ss << ", " << msg;
+    }
+    ss << "]";
+
+    free( msg );
+    /// @throw std::runtime_error if snmp_sess_synch_response() returned an error.
+    throw std::runtime_error( ss.str() );
+}
+
 
-        free( msg );
-        snmp_free_pdu( response );
+SNMPpp::PDU SNMPpp::sync( SNMPpp::SessionHandle &session, SNMPpp::PDU &request )
+{
+    /// @see SNMPpp::trySync() for the exceptions this may throw.
+    SNMPpp::PDU response( static_cast< netsnmp_pdu * >( NULL ) );
+    const int status = trySync( session, request, response );
+    netsnmp_pdu *p = response;
+
+    if (    p                   == NULL                 ||
+            p->errstat          != SNMP_ERR_NOERROR     ||
+            status              != STAT_SUCCESS         )
+    {
+        response.free();
         /// @throw std::runtime_error if snmp_sess_synch_response() returned an error.
-        throw std::runtime_error( ss.str() );
+        throwError( session );
     }
 
-    return SNMPpp::PDU( response );
+    return response;
 }
 
 
@@ -142,7 +166,116 @@ SNMPpp::PDU SNMPpp::getNext( SNMPpp::SessionHandle &session, SNMPpp::PDU &pdu )
 }
 
 
-SNMPpp::PDU SNMPpp::get( SNMPpp::SessionHandle &session, const SetOID &oids )
+/// Number of bytes needed to encode the length of a BER field.
+static size_t lengthSize( const size_t len )
+{
+    return ( len < 0x80 ? 1 : len <= 0xff ? 2 : len <= 0xffff ? 3 : 4 );
+}
+
+
+/// Number of bytes needed to encode a single sub-identifier, 7 bits at a time.
+static size_t subidSize( const uint64_t subid )
+{
+    size_t bytes = 1;
+    for ( uint64_t remaining = subid >> 7; remaining != 0; remaining >>= 7 )
+    {
+        bytes ++;
+    }
+
+    return bytes;
+}
+
+
+size_t SNMPpp::estimateVarbindSize( const SNMPpp::OIDView &o, const size_t valueSize )
+{
+    // the first two sub-identifiers are encoded together as 40 * X + Y
+    size_t name = 1;
+    if ( o.size() >= 2 )
+    {
+        name = subidSize( 40 * o[0] + o[1] );
+    }
+    for ( size_t idx = 2; idx < o.size(); idx ++ )
+    {
+        name += subidSize( o[idx] );
+    }
+
+    // SEQUENCE { OBJECT IDENTIFIER, value }
+    const size_t content = 1 + lengthSize( name ) + name + valueSize;
+
+    return 1 + lengthSize( content ) + content;
+}
+
+
+/// Split any container of OIDs into groups.  @see SNMPpp::splitOids()
+template < typename T >
+static std::vector< SNMPpp::VecOID > splitContainer( const T &oids, const size_t maxMessageSize, const size_t valueSize )
+{
+    // the list of varbinds is itself a SEQUENCE, so count its header in the overhead
+    const size_t budget = ( maxMessageSize > SNMPpp::kMessageOverhead + 4 ? maxMessageSize - SNMPpp::kMessageOverhead - 4 : 0 );
+
+    std::vector< SNMPpp::VecOID > groups;
+    size_t used = 0;
+    for ( typename T::const_iterator iter = oids.begin(); iter != oids.end(); iter ++ )
+    {
+        const size_t len = SNMPpp::estimateVarbindSize( iter->view(), valueSize );
+        if ( groups.empty() || ( used + len > budget && ! groups.back().empty() ) )
+        {
+            groups.push_back( SNMPpp::VecOID() );
+            used = 0;
+        }
+        groups.back().push_back( *iter );
+        used += len;
+    }
+
+    return groups;
+}
+
+
+/// Estimate the size of a message with these OIDs, the same way splitOids() does.
+static size_t estimateMessageSize( const SNMPpp::VecOID &oids )
+{
+    size_t size = SNMPpp::kMessageOverhead + 4;
+    for ( size_t idx = 0; idx < oids.size(); idx ++ )
+    {
+        size += SNMPpp::estimateVarbindSize( oids[idx].view(), 32 );
+    }
+
+    return size;
+}
+
+
+std::vector< SNMPpp::VecOID > SNMPpp::splitOids( const SNMPpp::SetOID &oids, const size_t maxMessageSize, const size_t valueSize )
+{
+    return splitContainer( oids, maxMessageSize, valueSize );
+}
+
+
+std::vector< SNMPpp::VecOID > SNMPpp::splitOids( const SNMPpp::VecOID &oids, const size_t maxMessageSize, const size_t valueSize )
+{
+    return splitContainer( oids, maxMessageSize, valueSize );
+}
+
+
+size_t SNMPpp::sessionMaxMessageSize( const SNMPpp::SessionHandle &session )
+{
+    const netsnmp_session *s = ( session == NULL ? NULL : snmp_sess_session( session ) );
+    if ( s == NULL )
+    {
+        return kDefaultMaxMessageSize;
+    }
+
+    // zero means net-snmp was not told, and the response must fit both ways
+    size_t size = s->sndMsgMaxSize;
+    if ( size == 0 || ( s->rcvMsgMaxSize != 0 && s->rcvMsgMaxSize < size ) )
+    {
+        size = s->rcvMsgMaxSize;
+    }
+
+    return ( size == 0 ? kDefaultMaxMessageSize : size );
+}
+
+
+SNMPpp::PDU SNMPpp::get( SNMPpp::SessionHandle &session, const SetOID &oids, const size_t maxMessageSize )
 {
     if ( oids.empty() )
     {
@@ -150,17 +283,114 @@ SNMPpp::PDU SNMPpp::get( SNMPpp::SessionHandle &session, const SetOID &oids )
         throw std::invalid_argument( "Cannot GET an empty set of OIDs." );
     }
 
-    SNMPpp::PDU pdu( SNMPpp::PDU::kGet );
-    SetOID::const_iterator iter;
-    for (   iter  = oids.begin();
-            iter != oids.end();
-            iter ++ )
+    return get( session, SNMPpp::VecOID( oids.begin(), oids.end() ), maxMessageSize );
+}
+
+
+SNMPpp::PDU SNMPpp::get( SNMPpp::SessionHandle &session, const VecOID &oids, const size_t maxMessageSize )
+{
+    if ( oids.empty() )
+    {
+        /// @throw std::invalid_argument if the VecOID is empty.
+        throw std::invalid_argument( "Cannot GET an empty set of OIDs." );
+    }
+
+    // never go over what the agent is known to accept
+    SNMPpp::SessionLimits limits = getSessionLimits( session );
+    const size_t budget = limits.messageSize( maxMessageSize == kSessionMaxMessageSize ? sessionMaxMessageSize( session ) : maxMessageSize );
+
+    std::deque< SNMPpp::VecOID > pending;
+    if ( budget == 0 )
     {
-        const SNMPpp::OID &o = *iter;
-        pdu.addNullVar( o );
+        pending.push_back( oids );
+    }
+    else
+    {
+        const std::vector< SNMPpp::VecOID > groups = splitOids( oids, budget );
+        pending.assign( groups.begin(), groups.end() );
     }
 
-    return sync( session, pdu );
+    SNMPpp::UniquePDU result( static_cast< netsnmp_pdu * >( NULL ) );
+    netsnmp_variable_list *last = NULL;
+    while ( ! pending.empty() )
+    {
+        SNMPpp::UniquePDU request( SNMPpp::PDU::kGet );
+        request.addNullVars( pending.front() );
+        const size_t size = estimateMessageSize( pending.front() );
+
+        SNMPpp::PDU p( static_cast< netsnmp_pdu * >( NULL ) );
+        const int status = trySync( session, request, p );
+        SNMPpp::UniquePDU response( std::move( p ) );
+        netsnmp_pdu *r = response;
+
+        // the agent cannot fit the response in a message, or net-snmp cannot fit the request
+        bool tooBig = ( status == STAT_SUCCESS && r != NULL && r->errstat == SNMP_ERR_TOOBIG );
+        if ( status == STAT_ERROR )
+        {
+            int error1 = 0;
+            int error2 = 0;
+            char *msg  = NULL;
+            snmp_sess_error( session, &error1, &error2, &msg );
+            free( msg );
+            tooBig = ( error2 == SNMPERR_TOO_LONG );
+        }
+
+        if ( tooBig )
+        {
+            limits.learnMessageSize( size, true );
+            setSessionLimits( session, limits );
+
+            if ( pending.front().size() < 2 )
+            {
+                /// @throw std::runtime_error if the response to a single OID is too big for the agent.
+                throw std::runtime_error( "The response to " + pending.front().front().to_str() + " is too big for the agent." );
+            }
+
+            // try again with smaller groups, keeping the OIDs in order
+            std::vector< SNMPpp::VecOID > groups = splitOids( pending.front(), limits.messageSize( size - 1 ) );
+            if ( groups.size() < 2 )
+            {
+                SNMPpp::VecOID &first = groups.front();
+                const size_t half = first.size() / 2;
+                groups.push_back( SNMPpp::VecOID( first.begin() + half, first.end() ) );
+                first.resize( half );
+            }
+            pending.pop_front();
+            pending.insert( pending.begin(), groups.begin(), groups.end() );
+            continue;
+        }
+
+        if ( status != STAT_SUCCESS || r == NULL || r->errstat != SNMP_ERR_NOERROR )
+        {
+            /// @throw std::runtime_error if snmp_sess_synch_response() returned an error.
+            throwError( session );
+        }
+        pending.pop_front();
+
+        if ( size > limits.goodMessageSize )
+        {
+            limits.learnMessageSize( size, false );
+            setSessionLimits( session, limits );
+        }
+
+        // move the varbinds to the end of the result without copying them
+        if ( last == NULL )
+        {
+            result  = std::move( response );
+            last    = r->variables;
+        }
+        else
+        {
+            last->next_variable = r->variables;
+            r->variables        = NULL;
+        }
+        while ( last != NULL && last->next_variable != NULL )
+        {
+            last = last->next_variable;
+        }
+    }
+
+    return result.release();
 }
 
 
@@ -194,9 +424,90 @@ SNMPpp::PDU SNMPpp::getBulk( SNMPpp::SessionHandle &session, SNMPpp::PDU &pdu, c
         p = pdu;
     }
 
-    // net-snmp seems to have re-used these variables to mean something else during bulk requests
-    p->errstat  = nonRepeaters;
-    p->errindex = maxRepetitions;
+    // net-snmp frees the request once it is sent, so only its OIDs are
+    // kept (as a length followed by the sub-identifiers, all in a single
+    // vector) in case it has to be rebuilt with fewer repetitions
+    std::vector< oid > names;
+    size_t starts = 0;
+    for ( const netsnmp_variable_list *vl = p->variables; vl != NULL; vl = vl->next_variable )
+    {
+        names.push_back( vl->name_length );
+        names.insert( names.end(), vl->name, vl->name + vl->name_length );
+        starts ++;
+    }
+    const size_t fixed      = ( nonRepeaters > 0 ? static_cast< size_t >( nonRepeaters ) : 0 );
+    const size_t repeaters  = ( starts > fixed ? starts - fixed : 0 );
+    const int width         = static_cast< int >( repeaters > 0 ? repeaters : 1 );
 
-    return sync( session, pdu );
+    SNMPpp::PDU request( std::move( pdu ) );
+    SNMPpp::SessionLimits limits = getSessionLimits( session );
+    while ( true )
+    {
+        netsnmp_pdu *q = request;
+        if ( q == NULL )
+        {
+            // the previous attempt was freed by net-snmp
+            request = SNMPpp::PDU( SNMPpp::PDU::kGetBulk );
+            q = request;
+            for ( size_t idx = 0; idx < names.size(); idx += names[idx] + 1 )
+            {
+                snmp_add_null_var( q, names.data() + idx + 1, names[idx] );
+            }
+        }
+
+        // net-snmp re-uses these fields for bulk requests
+        const int repetitions = limits.repetitions( maxRepetitions, width );
+        q->errstat  = nonRepeaters;
+        q->errindex = repetitions;
+
+        SNMPpp::PDU response( static_cast< netsnmp_pdu * >( NULL ) );
+        const int status = trySync( session, request, response );
+        netsnmp_pdu *r = response;
+
+        if ( status == STAT_SUCCESS && r != NULL && r->errstat == SNMP_ERR_TOOBIG && repetitions > 1 )
+        {
+            response.free();
+            limits.learnRepetitions( repetitions, true, width );
+            setSessionLimits( session, limits );
+            continue;
+        }
+
+        if ( status != STAT_SUCCESS || r == NULL || r->errstat != SNMP_ERR_NOERROR )
+        {
+            response.free();
+            /// @throw std::runtime_error if snmp_sess_synch_response() returned an error.
+            throwError( session );
+        }
+
+        // Agents may return fewer repetitions than requested when the
+        // response would otherwise be too big, which is only expected at
+        // the end of the MIB.
+        if ( repeaters > 0 && repetitions > 0 )
+        {
+            size_t count = 0;
+            bool endOfMib = false;
+            for ( SNMPpp::Varlist::const_iterator iter = response.begin(); iter != response.end(); ++ iter )
+            {
+                count ++;
+                endOfMib = endOfMib || iter->asnType() == SNMP_ENDOFMIBVIEW;
+            }
+
+            const size_t received = ( count > fixed ? count - fixed : 0 ) / repeaters;
+            if ( received < static_cast< size_t >( repetitions ) && ! endOfMib )
+            {
+                limits.learnRepetitions( static_cast< int >( received ) + 1, true, width );
+                if ( received > 0 )
+                {
+                    limits.learnRepetitions( static_cast< int >( received ), false, width );
+                }
+            }
+            else
+            {
+                limits.learnRepetitions( repetitions, false, width );
+            }
+            setSessionLimits( session, limits );
+        }
+
+        return response;
+    }
 }
@@ -3,9 +3,10 @@
 // Copyright (C) 2013 Stephane Charette <stephanecharette@gmail.com>
 
 #include <stdlib.h>
-#include <sstream>
+#include <string.h>
 #include <stdexcept>
 #include <algorithm>
+#include <utility>
 #include <SNMPpp/OID.hpp>
 
 
@@ -30,6 +31,13 @@ SNMPpp::OID::OID( const SNMPpp::OID &o )
 }
 
 
+SNMPpp::OID::OID( SNMPpp::OID &&o ) noexcept :
+    v( std::move( o.v ) )
+{
+    return;
+}
+
+
 SNMPpp::OID::OID( const char * const s )
 {
     set( s );
@@ -46,6 +54,14 @@ SNMPpp::OID::OID( const std::string &s )
 }
 
 
+SNMPpp::OID::OID( const char * const s, const size_t len )
+{
+    append( s, len );
+
+    return;
+}
+
+
 SNMPpp::OID::OID( const SNMPpp::OID::ECommon &location )
 {
     set( location );
@@ -56,11 +72,7 @@ SNMPpp::OID::OID( const SNMPpp::OID::ECommon &location )
 
 SNMPpp::OID::OID( const oid * o, const size_t length )
 {
-    v.reserve( length );
-    for ( size_t idx = 0; idx < length; idx ++ )
-    {
-        v.push_back( o[idx] );
-    }
+    v.assign( o, length );
 
     return;
 }
@@ -70,28 +82,29 @@ SNMPpp::OID::OID( const netsnmp_variable_list *vl )
 {
     if ( vl != NULL )
     {
-        v.reserve( vl->name_length );
-        for ( size_t idx = 0; idx < vl->name_length; idx ++ )
-        {
-            v.push_back( vl->name[idx] );
-        }
+        v.assign( vl->name, vl->name_length );
     }
 
     return;
 }
 
 
+SNMPpp::OID::OID( const SNMPpp::OIDView &view )
+{
+    v.assign( view.data(), view.size() );
+
+    return;
+}
+
+
 SNMPpp::OID::operator std::string( void ) const
 {
     // convert the OID to a text string, such as:  .0.1.2.3.4
 
-    std::stringstream ss;
-    for ( size_t idx = 0; idx < v.size(); idx ++ )
-    {
-        ss << "." << v[ idx ];
-    }
+    std::string s;
+    appendTo( s );
 
-    return ss.str();
+    return s;
 }
 
 
@@ -153,6 +166,14 @@ SNMPpp::OID SNMPpp::OID::operator+( const oid o ) const
 }
 
 
+SNMPpp::OID SNMPpp::operator+( SNMPpp::OID &&lhs, const oid rhs )
+{
+    lhs += rhs;
+
+    return std::move( lhs );
+}
+
+
 SNMPpp::OID &SNMPpp::OID::operator+=( const oid o )
 {
     // For example:
@@ -174,49 +195,73 @@ SNMPpp::OID SNMPpp::OID::operator+( const std::string &s ) const
     //      SNMPpp::OID oid2 = oid1 + ".5.6";
 
     OID newOid( *this );
+    newOid.append( s.data(), s.size() );
+
+    return newOid;
+}
+
+
+SNMPpp::OID &SNMPpp::OID::operator+=( const std::string &s )
+{
+    // For example:
+    //
+    //      SNMPpp::OID oid( ".1.2.3.4" );
+    //      oid += ".5.6";
+
+    return append( s.data(), s.size() );
+}
+
 
-    size_t pos = 0;
-    while ( pos < std::string::npos )
+SNMPpp::OID &SNMPpp::OID::append( const char * const s, const size_t len )
+{
+    if ( s == NULL )
+    {
+        return *this;
+    }
+
+    const size_t originalSize = v.size();
+    const char *p   = s;
+    const char *end = s + len;
+
+    while ( p < end )
     {
         // move past the next "." character
-        if ( s[ pos ] == '.' )
+        if ( *p == '.' )
         {
-            pos ++;
+            p ++;
+            if ( p >= end )
+            {
+                break;
+            }
         }
 
-        if ( pos >= s.size() )
+        // if the next char is not numeric, then we're done
+        unsigned int digit = static_cast<unsigned char>( *p ) - '0';
+        if ( digit > 9 )
         {
             break;
         }
 
-        const char * const p = &s[pos];
-
-        // if the next char is not numeric, then we're done
-        if ( isdigit( p[0] ) == false )
+        // accumulate the entire run of digits
+        unsigned long long value = 0;
+        do
         {
-            break;
-        }
+            value = value * 10 + digit;
+            if ( value > MAX_SUBID )
+            {
+                // don't leave a partially-parsed OID behind
+                v.resize( originalSize );
 
-        newOid.v.push_back( atoi( p ) );
+                /// @throw std::invalid_argument if one of the numeric values is larger than an OID can hold.
+                throw std::invalid_argument( "A numeric value in OID \"" + std::string( s, len ) + "\" is larger than " + std::to_string( MAX_SUBID ) + "." );
+            }
+            p ++;
+        }
+        while ( p < end && ( digit = static_cast<unsigned char>( *p ) - '0' ) <= 9 );
 
-        // move our position pointer past the numeric value we just processed
-        pos = s.find_first_not_of( "0123456789", pos );
+        v.push_back( static_cast<oid>( value ) );
     }
 
-    return newOid;
-}
-
-
-SNMPpp::OID &SNMPpp::OID::operator+=( const std::string &s )
-{
-    // For example:
-    //
-    //      SNMPpp::OID oid( ".1.2.3.4" );
-    //      oid += ".5.6";
-
-    OID newOid = operator+( s );
-    v.swap( newOid.v );
-
     return *this;
 }
 
@@ -245,12 +290,20 @@ SNMPpp::OID &SNMPpp::OID::set( const OID &o )
 }
 
 
+SNMPpp::OID &SNMPpp::OID::operator=( SNMPpp::OID &&rhs ) noexcept
+{
+    v = std::move( rhs.v );
+
+    return *this;
+}
+
+
 SNMPpp::OID &SNMPpp::OID::set( const char * const s )
 {
     clear();
     if ( s != NULL )
     {
-        operator+=( std::string( s ) );
+        append( s, strlen( s ) );
     }
 
     return *this;
@@ -268,19 +321,26 @@ SNMPpp::OID &SNMPpp::OID::set( const std::string &s )
 
 SNMPpp::OID &SNMPpp::OID::set( const SNMPpp::OID::ECommon &location )
 {
-    clear();
+    const OIDView view = common( location );
+    v.assign( view.data(), view.size() );
+
+    return *this;
+}
+
 
+SNMPpp::OIDView SNMPpp::OID::common( const SNMPpp::OID::ECommon location )
+{
     switch ( location )
     {
-        case kInvalid:              set( ""                         ); break;
-        case kEmpty:                set( ""                         ); break;
-        case kInternet:             set( "1.3.6.1"                  ); break;
-        case kPrivateEnterprise:    set( "1.3.6.1.4"                ); break;
-        case kSysUpTime:            set( "1.3.6.1.2.1.1.3.0"        ); break;
-        case kTrap:                 set( "1.3.6.1.6.3.1.1.4.1.0"    ); break;
+        case kInvalid:              break;
+        case kEmpty:                break;
+        case kInternet:             return InternetOID::view();
+        case kPrivateEnterprise:    return PrivateEnterpriseOID::view();
+        case kSysUpTime:            return SysUpTimeOID::view();
+        case kTrap:                 return SnmpTrapOID::view();
     }
 
-    return *this;
+    return OIDView();
 }
 
 
@@ -356,17 +416,16 @@ SNMPpp::OID SNMPpp::OID::parent( const size_t level ) const
      * and the value of oid3 will be `.1.2`.
      */
 
-    SNMPpp::OID o( *this );
-    if ( level >= o.size() )
-    {
-        /// @return If the level is greater than or equal to the number of values in the OID, then an empty OID is returned to the caller.
-        o.clear();
-    }
-    else
+    SNMPpp::OID o;
+    if ( level < size() )
     {
-        /// @return If the level is smaller than the number of values in the OID, then the vector is truncated by the appropriate amount and a new OID is returned to the caller.
-        o.v.resize( o.size() - level );
+        // a parent is often extended again (for example, when walking the
+        // next index of a table) so keep room for the values we removed
+        o.v.reserve( size() );
+        /// @return If the level is smaller than the number of values in the OID, then only the leading values are copied into the new OID returned to the caller.
+        o.v.assign( v.data(), size() - level );
     }
+    /// @return If the level is greater than or equal to the number of values in the OID, then an empty OID is returned to the caller.
 
     return o;
 }
@@ -557,7 +616,7 @@ const struct tree *SNMPpp::OID::getTree( const bool exact ) const
              */
 
             // make sure the tree returned is an exact match
-            std::vector<oid> tmpOid;
+            SmallVector<oid, kInlineSize> tmpOid;
             struct tree *p = t;
             while ( p != NULL )
             {
@@ -599,7 +658,7 @@ const struct module *SNMPpp::OID::getModule( const bool exact ) const
 
 std::ostream &operator<<( std::ostream &os, const SNMPpp::OID &o )
 {
-    os << o.to_str();
+    os << o.view();
 
     return os;
 }
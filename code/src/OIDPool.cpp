@@ -0,0 +1,214 @@
+// SNMPpp: https://sourceforge.net/p/snmppp/
+// SNMPpp project uses the MIT license. See LICENSE for details.
+// Copyright (C) 2013 Stephane Charette <stephanecharette@gmail.com>
+
+#include <stdexcept>
+#include <SNMPpp/OIDPool.hpp>
+
+
+const SNMPpp::OIDPool::Handle SNMPpp::OIDPool::kEmpty;
+const SNMPpp::OIDPool::Handle SNMPpp::OIDPool::kNotFound;
+
+
+SNMPpp::OIDPool::~OIDPool( void )
+{
+    return;
+}
+
+
+SNMPpp::OIDPool::OIDPool( void )
+{
+    // node #0 is the empty OID, which is the parent of everything else
+    const Node root = { kEmpty, 0, 0 };
+    nodes.push_back( root );
+
+    return;
+}
+
+
+SNMPpp::OIDPool &SNMPpp::OIDPool::global( void )
+{
+    // this is intentionally leaked so handles remain valid even while other
+    // static objects are being destroyed at the end of the application
+    static OIDPool *pool = new OIDPool;
+
+    return *pool;
+}
+
+
+SNMPpp::OIDPool::Handle SNMPpp::OIDPool::intern( const SNMPpp::OIDView &o )
+{
+    for ( size_t idx = 0; idx < o.size(); idx ++ )
+    {
+        if ( static_cast<uint64_t>( o[idx] ) > MAX_SUBID )
+        {
+            throw std::invalid_argument( "Cannot intern OID " + o.to_str() + " since the value " + std::to_string( o[idx] ) + " is larger than 32 bits." );
+        }
+    }
+
+    std::lock_guard< std::mutex > lock( mutex );
+
+    Handle h = kEmpty;
+    for ( size_t idx = 0; idx < o.size(); idx ++ )
+    {
+        const uint64_t key = makeKey( h, o[idx] );
+        std::unordered_map< uint64_t, Handle >::const_iterator iter = children.find( key );
+        if ( iter != children.end() )
+        {
+            h = iter->second;
+            continue;
+        }
+
+        if ( nodes.size() >= kNotFound )
+        {
+            throw std::length_error( "The OID pool is full." );
+        }
+
+        const Node node = { h, static_cast<uint32_t>( o[idx] ), static_cast<uint32_t>( idx + 1 ) };
+        const Handle child = static_cast<Handle>( nodes.size() );
+        nodes.push_back( node );
+        children[ key ] = child;
+        h = child;
+    }
+
+    return h;
+}
+
+
+SNMPpp::OIDPool::Handle SNMPpp::OIDPool::find( const SNMPpp::OIDView &o ) const
+{
+    std::lock_guard< std::mutex > lock( mutex );
+
+    Handle h = kEmpty;
+    for ( size_t idx = 0; idx < o.size(); idx ++ )
+    {
+        if ( static_cast<uint64_t>( o[idx] ) > MAX_SUBID )
+        {
+            return kNotFound;
+        }
+
+        std::unordered_map< uint64_t, Handle >::const_iterator iter = children.find( makeKey( h, o[idx] ) );
+        if ( iter == children.end() )
+        {
+            return kNotFound;
+        }
+        h = iter->second;
+    }
+
+    return h;
+}
+
+
+SNMPpp::OID SNMPpp::OIDPool::resolve( const Handle h ) const
+{
+    oid buffer[ OID::kInlineSize ];
+    const size_t len = resolve( h, buffer, OID::kInlineSize );
+    if ( len <= OID::kInlineSize )
+    {
+        return OID( buffer, len );
+    }
+
+    // this OID is too long for the buffer on the stack
+    std::vector< oid > v( len );
+    resolve( h, &v[0], len );
+
+    return OID( &v[0], len );
+}
+
+
+size_t SNMPpp::OIDPool::resolve( const Handle h, oid *buf, const size_t len ) const
+{
+    std::lock_guard< std::mutex > lock( mutex );
+    validate( h );
+
+    const size_t depth = nodes[h].depth;
+    if ( depth <= len )
+    {
+        // walk up towards the root, filling in the buffer from the end
+        Handle current = h;
+        for ( size_t idx = depth; idx > 0; idx -- )
+        {
+            const Node &node = nodes[current];
+            buf[idx - 1]    = node.value;
+            current         = node.parent;
+        }
+    }
+
+    return depth;
+}
+
+
+size_t SNMPpp::OIDPool::length( const Handle h ) const
+{
+    std::lock_guard< std::mutex > lock( mutex );
+    validate( h );
+
+    return nodes[h].depth;
+}
+
+
+SNMPpp::OIDPool::Handle SNMPpp::OIDPool::parent( const Handle h ) const
+{
+    std::lock_guard< std::mutex > lock( mutex );
+    validate( h );
+
+    return nodes[h].parent;
+}
+
+
+bool SNMPpp::OIDPool::isChildOf( const Handle child, const Handle h ) const
+{
+    std::lock_guard< std::mutex > lock( mutex );
+    validate( child );
+    validate( h );
+
+    // same rules as OID::isChildOf():  an empty OID is not a parent, and an OID is not a child of itself
+    const uint32_t depth = nodes[h].depth;
+    if ( depth == 0 || nodes[child].depth <= depth )
+    {
+        return false;
+    }
+
+    Handle current = child;
+    while ( nodes[current].depth > depth )
+    {
+        current = nodes[current].parent;
+    }
+
+    return current == h;
+}
+
+
+size_t SNMPpp::OIDPool::size( void ) const
+{
+    std::lock_guard< std::mutex > lock( mutex );
+
+    return nodes.size();
+}
+
+
+size_t SNMPpp::OIDPool::memoryUsage( void ) const
+{
+    std::lock_guard< std::mutex > lock( mutex );
+
+    // each entry in the unordered_map is a separately-allocated node with
+    // the key, the value, and a pointer to the next node, plus the buckets
+    const size_t entrySize = sizeof( std::pair< const uint64_t, Handle > ) + sizeof( void * );
+
+    return  sizeof( *this )                     +
+            nodes.capacity()                    * sizeof( Node )    +
+            children.size()                     * entrySize         +
+            children.bucket_count()             * sizeof( void * )  ;
+}
+
+
+void SNMPpp::OIDPool::validate( const Handle h ) const
+{
+    if ( h >= nodes.size() )
+    {
+        /// @throw std::invalid_argument if the handle is not valid in this pool.
+        throw std::invalid_argument( "Handle " + std::to_string( h ) + " is not valid in this OID pool." );
+    }
+
+    return;
+}
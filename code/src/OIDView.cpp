@@ -0,0 +1,192 @@
+// SNMPpp: https://sourceforge.net/p/snmppp/
+// SNMPpp project uses the MIT license. See LICENSE for details.
+// Copyright (C) 2013 Stephane Charette <stephanecharette@gmail.com>
+
+#include <stdint.h>
+#include <string.h>
+#include <SNMPpp/OIDView.hpp>
+
+
+/** Write the decimal digits of `value` so they end immediately before `end`,
+ * and return a pointer to the first digit.  Two digits are produced at a
+ * time to halve the number of (slow) divisions.
+ */
+static char *writeDigits( char *end, oid value )
+{
+    static const char pairs[] =
+        "00010203040506070809"
+        "10111213141516171819"
+        "20212223242526272829"
+        "30313233343536373839"
+        "40414243444546474849"
+        "50515253545556575859"
+        "60616263646566676869"
+        "70717273747576777879"
+        "80818283848586878889"
+        "90919293949596979899";
+
+    while ( value >= 100 )
+    {
+        const size_t idx = 2 * ( value % 100 );
+        value /= 100;
+        *--end = pairs[ idx + 1 ];
+        *--end = pairs[ idx     ];
+    }
+
+    if ( value >= 10 )
+    {
+        const size_t idx = 2 * value;
+        *--end = pairs[ idx + 1 ];
+        *--end = pairs[ idx     ];
+    }
+    else
+    {
+        *--end = static_cast<char>( '0' + value );
+    }
+
+    return end;
+}
+
+
+bool SNMPpp::OIDView::operator==( const SNMPpp::OIDView &rhs ) const
+{
+    if ( length != rhs.length )
+    {
+        return false;
+    }
+
+    // OIDs usually share a long common prefix such as .1.3.6.1.2.1, so
+    // start comparing at the end where the differences are more likely
+    for ( size_t idx = length; idx > 0; idx -- )
+    {
+        if ( ptr[idx - 1] != rhs.ptr[idx - 1] )
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+int SNMPpp::OIDView::compare( const SNMPpp::OIDView &rhs ) const
+{
+    const size_t len = ( length < rhs.length ? length : rhs.length );
+    for ( size_t idx = 0; idx < len; idx ++ )
+    {
+        if ( ptr[idx] != rhs.ptr[idx] )
+        {
+            return ( ptr[idx] < rhs.ptr[idx] ? -1 : 1 );
+        }
+    }
+
+    // if we get here then one is a prefix of the other, so the shortest one sorts first
+    if ( length == rhs.length )
+    {
+        return 0;
+    }
+
+    return ( length < rhs.length ? -1 : 1 );
+}
+
+
+bool SNMPpp::OIDView::isChildOf( const SNMPpp::OIDView &rhs ) const
+{
+    // both must have a size, and THIS must be longer than RHS for THIS to be a child of RHS
+    if ( rhs.length == 0 || rhs.length >= length )
+    {
+        return false;
+    }
+
+    for ( size_t idx = 0; idx < rhs.length; idx ++ )
+    {
+        if ( ptr[idx] != rhs.ptr[idx] )
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+size_t SNMPpp::OIDView::hash( void ) const
+{
+    // FNV-1a, but applied to entire numeric values rather than individual
+    // bytes, followed by a final avalanche so the low bits are well mixed
+    uint64_t h = 14695981039346656037ULL;
+    for ( size_t idx = 0; idx < length; idx ++ )
+    {
+        h ^= ptr[idx];
+        h *= 1099511628211ULL;
+    }
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+
+    return static_cast<size_t>( h );
+}
+
+
+size_t SNMPpp::OIDView::format( char *buf, const size_t len ) const
+{
+    size_t total = 0;
+    for ( size_t idx = 0; idx < length; idx ++ )
+    {
+        // large enough for a "." followed by a 64-bit number
+        char tmp[24];
+        char * const end = tmp + sizeof(tmp);
+        char *begin = writeDigits( end, ptr[idx] );
+        *--begin = '.';
+
+        const size_t n = end - begin;
+        if ( total + n <= len )
+        {
+            memcpy( buf + total, begin, n );
+        }
+        else if ( total < len )
+        {
+            memcpy( buf + total, begin, len - total );
+        }
+        total += n;
+    }
+
+    return total;
+}
+
+
+std::string &SNMPpp::OIDView::appendTo( std::string &s ) const
+{
+    // most OIDs easily fit in this buffer, in which case we only touch the string once
+    char buffer[256];
+    const size_t len = format( buffer, sizeof(buffer) );
+    if ( len <= sizeof(buffer) )
+    {
+        s.append( buffer, len );
+    }
+    else
+    {
+        const size_t pos = s.size();
+        s.resize( pos + len );
+        format( &s[pos], len );
+    }
+
+    return s;
+}
+
+
+std::ostream &operator<<( std::ostream &os, const SNMPpp::OIDView &o )
+{
+    char buffer[256];
+    const size_t len = o.format( buffer, sizeof(buffer) );
+    if ( len <= sizeof(buffer) )
+    {
+        os.write( buffer, len );
+    }
+    else
+    {
+        os << o.to_str();
+    }
+
+    return os;
+}
@@ -6,6 +6,7 @@
 #include <SNMPpp/net-snmppp.hpp>
 #include <stdexcept>
 #include <sstream>
+#include <utility>
 
 
 SNMPpp::PDU::~PDU( void )
@@ -18,7 +19,9 @@ SNMPpp::PDU::~PDU( void )
 
 SNMPpp::PDU::PDU( const SNMPpp::PDU::EType t ) :
     type( t ),
-    pdu( NULL )
+    pdu( NULL ),
+    tail( NULL ),
+    head( NULL )
 {
     pdu = snmp_pdu_create( type );
     if ( pdu == NULL )
@@ -34,7 +37,9 @@ SNMPpp::PDU::PDU( const SNMPpp::PDU::EType t ) :
 
 SNMPpp::PDU::PDU( netsnmp_pdu * p ) :
     type( SNMPpp::PDU::kUnknown ),
-    pdu( NULL )
+    pdu( NULL ),
+    tail( NULL ),
+    head( NULL )
 {
     // This constructor can be used if a pdu is obtained from another source
     // such as net-snmp, and we'd like to interact with it as a C++ object.
@@ -49,6 +54,58 @@ SNMPpp::PDU::PDU( netsnmp_pdu * p ) :
 }
 
 
+SNMPpp::PDU::PDU( const SNMPpp::PDU &rhs ) :
+    type ( rhs.type  ),
+    pdu  ( rhs.pdu   ),
+    tail ( rhs.tail  ),
+    head ( rhs.head  ),
+    index( rhs.index )
+{
+    return;
+}
+
+
+SNMPpp::PDU::PDU( SNMPpp::PDU &&rhs ) noexcept :
+    type ( rhs.type  ),
+    pdu  ( rhs.pdu   ),
+    tail ( rhs.tail  ),
+    head ( rhs.head  ),
+    index( std::move( rhs.index ) )
+{
+    rhs.clear();
+
+    return;
+}
+
+
+SNMPpp::PDU &SNMPpp::PDU::operator=( const SNMPpp::PDU &rhs )
+{
+    type    = rhs.type;
+    pdu     = rhs.pdu;
+    tail    = rhs.tail;
+    head    = rhs.head;
+    index   = rhs.index;
+
+    return *this;
+}
+
+
+SNMPpp::PDU &SNMPpp::PDU::operator=( SNMPpp::PDU &&rhs ) noexcept
+{
+    if ( &rhs != this )
+    {
+        type    = rhs.type;
+        pdu     = rhs.pdu;
+        tail    = rhs.tail;
+        head    = rhs.head;
+        index   = std::move( rhs.index );
+        rhs.clear();
+    }
+
+    return *this;
+}
+
+
 void SNMPpp::PDU::free( void )
 {
     if ( pdu != NULL )
@@ -63,8 +120,11 @@ void SNMPpp::PDU::free( void )
 
 void SNMPpp::PDU::clear( void )
 {
-    type = SNMPpp::PDU::kInvalid;
-    pdu  = NULL;
+    type    = SNMPpp::PDU::kInvalid;
+    pdu     = NULL;
+    tail    = NULL;
+    head    = NULL;
+    index.reset();
 
     return;
 }
@@ -102,7 +162,7 @@ const SNMPpp::Varlist SNMPpp::PDU::varlist( void ) const
         throw std::logic_error( "The PDU does not contain a variable list." );
     }
 
-    return SNMPpp::Varlist( pdu->variables );
+    return SNMPpp::Varlist( pdu->variables, index );
 }
 
 
@@ -119,7 +179,19 @@ SNMPpp::Varlist SNMPpp::PDU::varlist( void )
         throw std::logic_error( "The PDU does not contain a variable list." );
     }
 
-    return SNMPpp::Varlist( pdu->variables );
+    return SNMPpp::Varlist( pdu->variables, index );
+}
+
+
+SNMPpp::PDU &SNMPpp::PDU::buildIndex( void )
+{
+    index.reset();
+    if ( ! empty() )
+    {
+        index = SNMPpp::Varlist( pdu->variables ).buildIndex().getIndex();
+    }
+
+    return *this;
 }
 
 
@@ -155,6 +227,12 @@ netsnmp_variable_list * SNMPpp::PDU::operator[]( const size_t idx )
 
 SNMPpp::PDU &SNMPpp::PDU::setVarlist( Varlist &vl )
 {
+    if ( vl.getArena() != NULL )
+    {
+        /// @throw std::logic_error if the varbinds belong to a SNMPpp::VarbindArena, since net-snmp would free them.
+        throw std::logic_error( "Cannot give varbinds from an arena to a PDU." );
+    }
+
     netsnmp_variable_list *p = vl;
     return setVarlist( p );
 }
@@ -172,6 +250,8 @@ SNMPpp::PDU &SNMPpp::PDU::setVarlist( netsnmp_variable_list *vl )
     {
         snmp_free_varbind( pdu->variables );
         pdu->variables = vl;
+        tail = NULL;
+        index.reset();
     }
 
     return *this;
@@ -189,7 +269,7 @@ size_t SNMPpp::PDU::size( void ) const
 }
 
 
-bool SNMPpp::PDU::contains( const SNMPpp::OID &o ) const
+bool SNMPpp::PDU::contains( const SNMPpp::OIDView &o ) const
 {
     bool found = false;
     if ( ! empty() )
@@ -209,7 +289,7 @@ SNMPpp::OID SNMPpp::PDU::firstOID( void ) const
 }
 
 
-SNMPpp::PDU &SNMPpp::PDU::addBooleanVar( const SNMPpp::OID &o, bool value )
+SNMPpp::Varlist SNMPpp::PDU::beginAppend( void )
 {
     if ( pdu == NULL )
     {
@@ -217,138 +297,87 @@ SNMPpp::PDU &SNMPpp::PDU::addBooleanVar( const SNMPpp::OID &o, bool value )
         throw std::logic_error( "Cannot reference a NULL PDU." );
     }
 
-    if ( pdu->variables == NULL )
-    {
-        // if the PDU doesn't have a varlist, create a new one
-        SNMPpp::Varlist vl;
-        vl.addBooleanVar( o, value );
-        setVarlist( vl );
-    }
-    else
+    // the index would no longer be complete
+    index.reset();
+
+    // a copy of this object may have appended to the varbinds, or replaced them
+    netsnmp_variable_list *last = NULL;
+    if ( tail != NULL && head == pdu->variables && tail->next_variable == NULL )
     {
-        // ...otherwise, add to the existing varlist
-        varlist().addBooleanVar( o, value );
+        last = tail;
     }
 
+    return SNMPpp::Varlist( pdu->variables, last );
+}
+
+
+void SNMPpp::PDU::endAppend( SNMPpp::Varlist &vl )
+{
+    // the varlist may have been empty, in which case the first varbind is new
+    pdu->variables  = vl;
+    tail            = vl.back();
+    head            = pdu->variables;
+
+    return;
+}
+
+
+SNMPpp::PDU &SNMPpp::PDU::addBooleanVar( const SNMPpp::OID &o, bool value )
+{
+    /// @see SNMPpp::PDU::beginAppend() for the exceptions this may throw.
+    SNMPpp::Varlist vl = beginAppend();
+    vl.addBooleanVar( o, value );
+    endAppend( vl );
+
     return *this;
 }
 
 SNMPpp::PDU &SNMPpp::PDU::addIntegerVar( const SNMPpp::OID &o, int value )
 {
-    if ( pdu == NULL )
-    {
-        /// @throw std::logic_error if the PDU is NULL.
-        throw std::logic_error( "Cannot reference a NULL PDU." );
-    }
-
-    if ( pdu->variables == NULL )
-    {
-        // if the PDU doesn't have a varlist, create a new one
-        SNMPpp::Varlist vl;
-        vl.addIntegerVar( o, value );
-        setVarlist( vl );
-    }
-    else
-    {
-        // ...otherwise, add to the existing varlist
-        varlist().addIntegerVar( o, value );
-    }
+    /// @see SNMPpp::PDU::beginAppend() for the exceptions this may throw.
+    SNMPpp::Varlist vl = beginAppend();
+    vl.addIntegerVar( o, value );
+    endAppend( vl );
 
     return *this;
 }
 
 SNMPpp::PDU &SNMPpp::PDU::addInteger64Var( const SNMPpp::OID &o, long value )
 {
-    if ( pdu == NULL )
-    {
-        /// @throw std::logic_error if the PDU is NULL.
-        throw std::logic_error( "Cannot reference a NULL PDU." );
-    }
-
-    if ( pdu->variables == NULL )
-    {
-        // if the PDU doesn't have a varlist, create a new one
-        SNMPpp::Varlist vl;
-        vl.addInteger64Var( o, value );
-        setVarlist( vl );
-    }
-    else
-    {
-        // ...otherwise, add to the existing varlist
-        varlist().addInteger64Var( o, value );
-    }
+    /// @see SNMPpp::PDU::beginAppend() for the exceptions this may throw.
+    SNMPpp::Varlist vl = beginAppend();
+    vl.addInteger64Var( o, value );
+    endAppend( vl );
 
     return *this;
 }
 
 SNMPpp::PDU &SNMPpp::PDU::addGaugeVar( const SNMPpp::OID &o, unsigned int value )
 {
-    if ( pdu == NULL )
-    {
-        /// @throw std::logic_error if the PDU is NULL.
-        throw std::logic_error( "Cannot reference a NULL PDU." );
-    }
-
-    if ( pdu->variables == NULL )
-    {
-        // if the PDU doesn't have a varlist, create a new one
-        SNMPpp::Varlist vl;
-        vl.addGaugeVar( o, value );
-        setVarlist( vl );
-    }
-    else
-    {
-        // ...otherwise, add to the existing varlist
-        varlist().addGaugeVar( o, value );
-    }
+    /// @see SNMPpp::PDU::beginAppend() for the exceptions this may throw.
+    SNMPpp::Varlist vl = beginAppend();
+    vl.addGaugeVar( o, value );
+    endAppend( vl );
 
     return *this;
 }
 
 SNMPpp::PDU &SNMPpp::PDU::addOctetStringVar( const SNMPpp::OID &o, unsigned char * value, long unsigned int size )
 {
-    if ( pdu == NULL )
-    {
-        /// @throw std::logic_error if the PDU is NULL.
-        throw std::logic_error( "Cannot reference a NULL PDU." );
-    }
-
-    if ( pdu->variables == NULL )
-    {
-        // if the PDU doesn't have a varlist, create a new one
-        SNMPpp::Varlist vl;
-        vl.addOctetStringVar( o, value, size );
-        setVarlist( vl );
-    }
-    else
-    {
-        // ...otherwise, add to the existing varlist
-        varlist().addOctetStringVar( o, value, size );
-    }
+    /// @see SNMPpp::PDU::beginAppend() for the exceptions this may throw.
+    SNMPpp::Varlist vl = beginAppend();
+    vl.addOctetStringVar( o, value, size );
+    endAppend( vl );
 
     return *this;
 }
 
 SNMPpp::PDU &SNMPpp::PDU::addNullVar( const SNMPpp::OID &o )
 {
-    if ( pdu == NULL )
-    {
-        /// @throw std::logic_error if the PDU is NULL.
-        throw std::logic_error( "Cannot reference a NULL PDU." );
-    }
-
-    if ( pdu->variables == NULL )
-    {
-        // if the PDU doesn't have a varlist, create a new one
-        SNMPpp::Varlist vl;
-        vl.addNullVar( o );
-        setVarlist( vl );
-    }
-    else
-    {
-        // ...otherwise, add to the existing varlist
-        varlist().addNullVar( o );
-    }
+    /// @see SNMPpp::PDU::beginAppend() for the exceptions this may throw.
+    SNMPpp::Varlist vl = beginAppend();
+    vl.addNullVar( o );
+    endAppend( vl );
 
     return *this;
 }
@@ -356,24 +385,10 @@ SNMPpp::PDU &SNMPpp::PDU::addNullVar( const SNMPpp::OID &o )
 
 SNMPpp::PDU &SNMPpp::PDU::addNullVars( const SNMPpp::SetOID &s )
 {
-    if ( pdu == NULL )
-    {
-        /// @throw std::logic_error if the PDU is NULL.
-        throw std::logic_error( "Cannot reference a NULL PDU." );
-    }
-
-    if ( pdu->variables == NULL )
-    {
-        // if the PDU doesn't have a varlist, create a new one
-        SNMPpp::Varlist vl;
-        vl.addNullVars( s );
-        setVarlist( vl );
-    }
-    else
-    {
-        // ...otherwise, add to the existing varlist
-        varlist().addNullVars( s );
-    }
+    /// @see SNMPpp::PDU::beginAppend() for the exceptions this may throw.
+    SNMPpp::Varlist vl = beginAppend();
+    vl.addNullVars( s );
+    endAppend( vl );
 
     return *this;
 }
@@ -381,24 +396,10 @@ SNMPpp::PDU &SNMPpp::PDU::addNullVars( const SNMPpp::SetOID &s )
 
 SNMPpp::PDU &SNMPpp::PDU::addNullVars( const SNMPpp::VecOID &v )
 {
-    if ( pdu == NULL )
-    {
-        /// @throw std::logic_error if the PDU is NULL.
-        throw std::logic_error( "Cannot reference a NULL PDU." );
-    }
-
-    if ( pdu->variables == NULL )
-    {
-        // if the PDU doesn't have a varlist, create a new one
-        SNMPpp::Varlist vl;
-        vl.addNullVars( v );
-        setVarlist( vl );
-    }
-    else
-    {
-        // ...otherwise, add to the existing varlist
-        varlist().addNullVars( v );
-    }
+    /// @see SNMPpp::PDU::beginAppend() for the exceptions this may throw.
+    SNMPpp::Varlist vl = beginAppend();
+    vl.addNullVars( v );
+    endAppend( vl );
 
     return *this;
 }
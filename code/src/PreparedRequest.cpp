@@ -0,0 +1,124 @@
+// SNMPpp: https://sourceforge.net/p/snmppp/
+// SNMPpp project uses the MIT license. See LICENSE for details.
+// Copyright (C) 2013 Stephane Charette <stephanecharette@gmail.com>
+
+#include <stdexcept>
+#include <utility>
+#include <SNMPpp/PreparedRequest.hpp>
+#include <SNMPpp/Get.hpp>
+
+
+SNMPpp::PreparedRequest::~PreparedRequest( void )
+{
+    return;
+}
+
+
+SNMPpp::PreparedRequest::PreparedRequest( const SNMPpp::SetOID &oids, const SNMPpp::PDU::EType t ) :
+    prepared( t )
+{
+    if ( oids.empty() )
+    {
+        /// @throw std::invalid_argument if the SetOID is empty.
+        throw std::invalid_argument( "Cannot prepare a request without any OIDs." );
+    }
+
+    prepared.addNullVars( oids );
+
+    return;
+}
+
+
+SNMPpp::PreparedRequest::PreparedRequest( const SNMPpp::VecOID &oids, const SNMPpp::PDU::EType t ) :
+    prepared( t )
+{
+    if ( oids.empty() )
+    {
+        /// @throw std::invalid_argument if the VecOID is empty.
+        throw std::invalid_argument( "Cannot prepare a request without any OIDs." );
+    }
+
+    prepared.addNullVars( oids );
+
+    return;
+}
+
+
+SNMPpp::PreparedRequest::PreparedRequest( const SNMPpp::PDU &pdu ) :
+    prepared( static_cast< netsnmp_pdu * >( NULL ) )
+{
+    if ( pdu.empty() )
+    {
+        /// @throw std::invalid_argument if the PDU is empty.
+        throw std::invalid_argument( "Cannot prepare a request from an empty PDU." );
+    }
+
+    prepared = pdu.clone();
+
+    return;
+}
+
+
+SNMPpp::PreparedRequest::PreparedRequest( SNMPpp::PreparedRequest &&rhs ) noexcept :
+    prepared( std::move( rhs.prepared ) )
+{
+    return;
+}
+
+
+SNMPpp::PreparedRequest &SNMPpp::PreparedRequest::operator=( SNMPpp::PreparedRequest &&rhs ) noexcept
+{
+    prepared = std::move( rhs.prepared );
+
+    return *this;
+}
+
+
+SNMPpp::PreparedRequest &SNMPpp::PreparedRequest::setBulk( const int maxRepetitions, const int nonRepeaters )
+{
+    if ( prepared.getType() != SNMPpp::PDU::kGetBulk )
+    {
+        /// @throw std::logic_error if the request is not a kGetBulk.
+        throw std::logic_error( "Repetitions can only be set on a GETBULK request." );
+    }
+
+    // same as SNMPpp::getBulk(), net-snmp re-uses these fields for bulk requests
+    netsnmp_pdu *p  = prepared;
+    p->errstat      = nonRepeaters;
+    p->errindex     = maxRepetitions;
+
+    return *this;
+}
+
+
+SNMPpp::PDU SNMPpp::PreparedRequest::makeRequest( void ) const
+{
+    if ( prepared.empty() )
+    {
+        /// @throw std::logic_error if the request has been moved away.
+        throw std::logic_error( "The request has not been prepared." );
+    }
+
+    SNMPpp::PDU request = prepared.clone();
+    netsnmp_pdu *p = request;
+    if ( p == NULL )
+    {
+        /// @throw std::runtime_error if snmp_clone_pdu() fails.
+        throw std::runtime_error( "Failed to clone the prepared request." );
+    }
+
+    // snmp_clone_pdu() copies the IDs, so give the new request its own the way snmp_pdu_create() would
+    p->reqid    = snmp_get_next_reqid();
+    p->msgid    = snmp_get_next_msgid();
+    p->transid  = snmp_get_next_transid();
+
+    return request;
+}
+
+
+SNMPpp::PDU SNMPpp::PreparedRequest::send( SNMPpp::SessionHandle &session ) const
+{
+    SNMPpp::PDU request = makeRequest();
+
+    return SNMPpp::sync( session, request );
+}
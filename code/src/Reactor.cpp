@@ -0,0 +1,280 @@
+// SNMPpp: https://sourceforge.net/p/snmppp/
+// SNMPpp project uses the MIT license. See LICENSE for details.
+// Copyright (C) 2013 Stephane Charette <stephanecharette@gmail.com>
+
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+#include <chrono>
+#include <stdexcept>
+#include <SNMPpp/Reactor.hpp>
+#ifdef __linux__
+#include <sys/epoll.h>
+#endif
+
+
+SNMPpp::Reactor::~Reactor( void )
+{
+    if ( epfd >= 0 )
+    {
+        close( epfd );
+    }
+    netsnmp_large_fd_set_cleanup( &fdset );
+
+    return;
+}
+
+
+SNMPpp::Reactor::Reactor( const int eventsPerWait ) :
+    epfd        ( -1 ),
+    maxEvents   ( eventsPerWait < 1 ? 1 : eventsPerWait )
+{
+    netsnmp_large_fd_set_init( &fdset, FD_SETSIZE );
+
+#ifdef __linux__
+    epfd = epoll_create1( EPOLL_CLOEXEC );
+    events.resize( maxEvents * sizeof(struct epoll_event) );
+#endif
+    if ( epfd < 0 )
+    {
+        netsnmp_large_fd_set_cleanup( &fdset );
+        /// @throw std::runtime_error if epoll is not available.
+        throw std::runtime_error( "Failed to create the epoll descriptor." );
+    }
+
+    return;
+}
+
+
+int SNMPpp::Reactor::sendAsync( SNMPpp::SessionHandle &session, SNMPpp::PDU &request, const Callback &callback )
+{
+    if ( session != NULL && registrations.count( session ) == 0 )
+    {
+        netsnmp_transport *transport = snmp_sess_transport( session );
+        int result = -1;
+        if ( transport != NULL && transport->sock >= 0 )
+        {
+#ifdef __linux__
+            struct epoll_event ev;
+            memset( &ev, 0, sizeof(ev) );
+            ev.events   = EPOLLIN;
+            ev.data.ptr = session;
+            result = epoll_ctl( epfd, EPOLL_CTL_ADD, transport->sock, &ev );
+#endif
+        }
+        if ( result != 0 )
+        {
+            request.free();
+            /// @throw std::runtime_error if the socket cannot be added to epoll.
+            throw std::runtime_error( "Failed to add the session to epoll." );
+        }
+
+        Registration &registration  = registrations[ session ];
+        registration.fd             = transport->sock;
+        registration.deadline       = 0;
+    }
+
+    int reqid = 0;
+    try
+    {
+        reqid = AsyncEngine::sendAsync( session, request, callback );
+    }
+    catch ( ... )
+    {
+        if ( sessions.count( session ) == 0 )
+        {
+            unregister( session );
+        }
+        throw;
+    }
+
+    schedule( session );
+
+    return reqid;
+}
+
+
+size_t SNMPpp::Reactor::poll( const int milliseconds )
+{
+    const size_t before = completed;
+
+    expireTimers();
+
+    if ( registrations.empty() && milliseconds < 0 )
+    {
+        // nothing to wait for, so waiting forever would never return
+        rethrowFailure();
+        return completed - before;
+    }
+
+    // wake up in time for the next retry or timeout
+    int wait = milliseconds;
+    if ( ! timers.empty() )
+    {
+        const int64_t next = timers.top().first - now();
+        if ( wait < 0 || next < wait )
+        {
+            wait = next < 0 ? 0 : static_cast< int >( next );
+        }
+    }
+
+    int count = -1;
+#ifdef __linux__
+    struct epoll_event *ev = reinterpret_cast< struct epoll_event * >( events.data() );
+    count = epoll_wait( epfd, ev, maxEvents, wait );
+#else
+    errno = ENOSYS;
+#endif
+    if ( count < 0 && errno != EINTR )
+    {
+        /// @throw std::runtime_error if epoll_wait() fails.
+        throw std::runtime_error( std::string( "Failed to wait for replies: " ) + strerror( errno ) );
+    }
+
+    for ( int idx = 0; idx < count; idx ++ )
+    {
+#ifdef __linux__
+        SNMPpp::SessionHandle session = ev[idx].data.ptr;
+        std::unordered_map< SNMPpp::SessionHandle, Registration >::const_iterator iter = registrations.find( session );
+        if ( iter != registrations.end() )
+        {
+            // a callback may have closed this session, or completed all of its requests
+            read( session, iter->second.fd );
+        }
+#endif
+    }
+
+    expireTimers();
+    rethrowFailure();
+
+    return completed - before;
+}
+
+
+void SNMPpp::Reactor::complete( Request *request, const int status, netsnmp_pdu *pdu )
+{
+    const SNMPpp::SessionHandle session = request->session;
+
+    // the callback may send another request on the same session, which then remains registered
+    AsyncEngine::complete( request, status, pdu );
+
+    if ( sessions.count( session ) == 0 )
+    {
+        unregister( session );
+    }
+
+    return;
+}
+
+
+void SNMPpp::Reactor::unregister( SNMPpp::SessionHandle session )
+{
+    std::unordered_map< SNMPpp::SessionHandle, Registration >::iterator iter = registrations.find( session );
+    if ( iter == registrations.end() )
+    {
+        return;
+    }
+
+#ifdef __linux__
+    // this fails harmlessly if the socket has already been closed
+    struct epoll_event ev;
+    memset( &ev, 0, sizeof(ev) );
+    epoll_ctl( epfd, EPOLL_CTL_DEL, iter->second.fd, &ev );
+#endif
+    registrations.erase( iter );
+
+    return;
+}
+
+
+void SNMPpp::Reactor::schedule( SNMPpp::SessionHandle session )
+{
+    std::unordered_map< SNMPpp::SessionHandle, Registration >::iterator iter = registrations.find( session );
+    if ( iter == registrations.end() )
+    {
+        return;
+    }
+
+    const int fd = iter->second.fd;
+    if ( fd >= static_cast< int >( fdset.lfs_setsize ) )
+    {
+        netsnmp_large_fd_set_resize( &fdset, fd + 1 );
+    }
+
+    int numfds = 0;
+    int block = 1;
+    struct timeval timeout;
+    timeout.tv_sec  = 0;
+    timeout.tv_usec = 0;
+    snmp_sess_select_info2( session, &numfds, &fdset, &timeout, &block );
+    NETSNMP_LARGE_FD_CLR( fd, &fdset );
+    if ( block )
+    {
+        // nothing outstanding as far as net-snmp is concerned
+        return;
+    }
+
+    // always at least a millisecond away, so expireTimers() cannot spin on a session
+    int64_t delay = timeout.tv_sec * 1000 + ( timeout.tv_usec + 999 ) / 1000;
+    if ( delay < 1 )
+    {
+        delay = 1;
+    }
+    const int64_t deadline = now() + delay;
+
+    // an earlier deadline is kept, since waking up early does no harm
+    Registration &registration = iter->second;
+    if ( registration.deadline == 0 || deadline < registration.deadline )
+    {
+        registration.deadline = deadline;
+        timers.push( Timer( deadline, session ) );
+    }
+
+    return;
+}
+
+
+void SNMPpp::Reactor::expireTimers( void )
+{
+    const int64_t t = now();
+    while ( ! timers.empty() && timers.top().first <= t )
+    {
+        const Timer timer = timers.top();
+        timers.pop();
+
+        std::unordered_map< SNMPpp::SessionHandle, Registration >::iterator iter = registrations.find( timer.second );
+        if ( iter == registrations.end() || iter->second.deadline != timer.first )
+        {
+            // the session is idle, or has been rescheduled since
+            continue;
+        }
+        iter->second.deadline = 0;
+
+        // resends the requests which are due, and times out the ones out of retries
+        snmp_sess_timeout( timer.second );
+        schedule( timer.second );
+    }
+
+    return;
+}
+
+
+void SNMPpp::Reactor::read( SNMPpp::SessionHandle session, const int fd )
+{
+    if ( fd >= static_cast< int >( fdset.lfs_setsize ) )
+    {
+        netsnmp_large_fd_set_resize( &fdset, fd + 1 );
+    }
+
+    NETSNMP_LARGE_FD_SET( fd, &fdset );
+    snmp_sess_read2( session, &fdset );
+    NETSNMP_LARGE_FD_CLR( fd, &fdset );
+
+    return;
+}
+
+
+int64_t SNMPpp::Reactor::now( void )
+{
+    return std::chrono::duration_cast< std::chrono::milliseconds >( std::chrono::steady_clock::now().time_since_epoch() ).count();
+}
@@ -5,9 +5,27 @@
 #include <stdlib.h>
 #include <sstream>
 #include <stdexcept>
+#include <map>
 #include <SNMPpp/Session.hpp>
 
 
+// Limits learned for each session.  net-snmp's session structure has no
+// room for this, so it is kept here until the session is closed.
+static std::mutex mtxSessionLimits;
+static std::map< SNMPpp::SessionHandle, SNMPpp::SessionLimits > sessionLimits;
+
+
+/// Forget the limits of a session which is closed, or of one which was
+/// closed without SNMPpp::closeSession() and whose address is now re-used.
+static void forgetSessionLimits( const SNMPpp::SessionHandle &sessionHandle )
+{
+    std::lock_guard< std::mutex > lock( mtxSessionLimits );
+    sessionLimits.erase( sessionHandle );
+
+    return;
+}
+
+
 void SNMPpp::openSession( SNMPpp::SessionHandle &sessionHandle, const std::string &server, const std::string &community, const int version, const int retryAttempts, const int timeout )
 {
     std::lock_guard<std::mutex> lock(mtxOpenSession);
@@ -52,6 +70,9 @@ void SNMPpp::openSession( SNMPpp::SessionHandle &sessionHandle, const std::strin
         throw std::runtime_error( ss.str() );
     }
 
+    // a new session knows nothing about its agent yet
+    forgetSessionLimits( sessionHandle );
+
     return;
 }
 
@@ -182,6 +203,9 @@ void SNMPpp::openSession( SNMPpp::SessionHandle &sessionHandle, const std::strin
         throw std::runtime_error( ss.str() );
     }
 
+    // a new session knows nothing about its agent yet
+    forgetSessionLimits( sessionHandle );
+
     return;
  }
 
@@ -189,9 +213,134 @@ void SNMPpp::closeSession( SNMPpp::SessionHandle &sessionHandle )
 {
     if ( sessionHandle )
     {
+        forgetSessionLimits( sessionHandle );
         snmp_sess_close( sessionHandle );
         sessionHandle = NULL;
     }
 
     return;
 }
+
+
+/// Binary search between the largest known good and the smallest known bad value.
+template < typename T >
+static T nextAttempt( const T good, const T bad )
+{
+    if ( bad == 0 )
+    {
+        return 0;
+    }
+    if ( good == 0 )
+    {
+        return ( bad / 2 > 0 ? bad / 2 : 1 );
+    }
+    if ( bad - good <= good / 32 + 1 )
+    {
+        // close enough, stop searching
+        return good;
+    }
+
+    return good + ( bad - good ) / 2;
+}
+
+
+/// Narrow down the known good and bad values.  @see nextAttempt()
+template < typename T >
+static void narrow( T &good, T &bad, const T value, const bool tooBig )
+{
+    if ( tooBig )
+    {
+        if ( bad == 0 || value < bad )
+        {
+            bad = value;
+        }
+        if ( good >= bad )
+        {
+            // the agent now refuses something it used to accept
+            good = 0;
+        }
+    }
+    else
+    {
+        if ( value > good )
+        {
+            good = value;
+        }
+        if ( bad != 0 && bad <= good )
+        {
+            // the agent now accepts something it used to refuse
+            bad = 0;
+        }
+    }
+
+    return;
+}
+
+
+size_t SNMPpp::SessionLimits::messageSize( const size_t requested ) const
+{
+    const size_t size = nextAttempt( goodMessageSize, tooBigMessageSize );
+    if ( size == 0 )
+    {
+        return requested;
+    }
+
+    return ( requested == 0 || size < requested ? size : requested );
+}
+
+
+int SNMPpp::SessionLimits::repetitions( const int requested, const int repeaters ) const
+{
+    const int count = nextAttempt( goodRepetitions, tooBigRepetitions );
+    if ( count == 0 )
+    {
+        return requested;
+    }
+
+    // the limit is in varbinds, so wider rows get fewer repetitions
+    int rows = count / ( repeaters > 1 ? repeaters : 1 );
+    if ( rows < 1 )
+    {
+        rows = 1;
+    }
+
+    return ( rows < requested ? rows : requested );
+}
+
+
+void SNMPpp::SessionLimits::learnMessageSize( const size_t size, const bool tooBig )
+{
+    narrow( goodMessageSize, tooBigMessageSize, size, tooBig );
+
+    return;
+}
+
+
+void SNMPpp::SessionLimits::learnRepetitions( const int count, const bool tooBig, const int repeaters )
+{
+    narrow( goodRepetitions, tooBigRepetitions, count * ( repeaters > 1 ? repeaters : 1 ), tooBig );
+
+    return;
+}
+
+
+SNMPpp::SessionLimits SNMPpp::getSessionLimits( const SNMPpp::SessionHandle &sessionHandle )
+{
+    std::lock_guard< std::mutex > lock( mtxSessionLimits );
+    std::map< SNMPpp::SessionHandle, SNMPpp::SessionLimits >::const_iterator iter = sessionLimits.find( sessionHandle );
+    if ( iter == sessionLimits.end() )
+    {
+        return SNMPpp::SessionLimits();
+    }
+
+    return iter->second;
+}
+
+
+void SNMPpp::setSessionLimits( const SNMPpp::SessionHandle &sessionHandle, const SNMPpp::SessionLimits &limits )
+{
+    std::lock_guard< std::mutex > lock( mtxSessionLimits );
+    sessionLimits[ sessionHandle ] = limits;
+
+    return;
+}
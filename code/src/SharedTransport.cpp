@@ -0,0 +1,991 @@
+// SNMPpp: https://sourceforge.net/p/snmppp/
+// SNMPpp project uses the MIT license. See LICENSE for details.
+// Copyright (C) 2013 Stephane Charette <stephanecharette@gmail.com>
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <new>
+#include <sstream>
+#include <stdexcept>
+#include <SNMPpp/SharedTransport.hpp>
+#ifdef __linux__
+#include <netdb.h>
+#include <netinet/in.h>
+#include <sys/epoll.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+#ifdef SNMPPP_HAVE_LIBURING
+#include <deque>
+#include <liburing.h>
+#endif
+
+
+/// Large enough for any UDP datagram.
+static const size_t kMaxDatagram = 65536;
+
+/// Buffer group of the buffers registered for replies received through io_uring.
+static const int kBufferGroup = 0;
+
+/// Tells the completions of the multishot receives, whose user data is the socket, from those of the sends.
+static const uint64_t kReceiveTag = 1ULL << 63;
+
+
+struct SNMPpp::SharedTransport::Ring
+{
+#ifdef SNMPPP_HAVE_LIBURING
+    /// A datagram being sent, which must stay where it is until its completion arrives.
+    struct Send
+    {
+        struct msghdr           header;
+        struct iovec            vector;
+        struct sockaddr_storage address;
+        std::vector< u_char >   packet;
+        int                     reqid;
+    };
+
+    struct io_uring             uring;
+    struct io_uring_buf_ring *  buffers;    ///< replies are received into these, registered with the kernel
+    unsigned                    count;      ///< number of buffers, a power of two
+    size_t                      length;     ///< size of each buffer, room for the header, source address and any UDP datagram
+    u_char *                    memory;     ///< the buffers, from malloc() so untouched pages are never committed
+    struct msghdr               receive;    ///< tells the multishot receives how much room to keep for the source address
+    std::deque< Send >          sends;      ///< only ever grows, so entries in flight never move
+    std::vector< size_t >       idle;       ///< entries of `sends` which can be reused
+#endif
+};
+
+
+#ifdef SNMPPP_HAVE_LIBURING
+/// Return a free submission entry, submitting what is already queued if the ring is full.
+static struct io_uring_sqe *nextSqe( struct io_uring *uring )
+{
+    struct io_uring_sqe *sqe = io_uring_get_sqe( uring );
+    if ( sqe == NULL )
+    {
+        io_uring_submit( uring );
+        sqe = io_uring_get_sqe( uring );
+    }
+    if ( sqe == NULL )
+    {
+        /// @throw std::runtime_error if io_uring has no room for another submission.
+        throw std::runtime_error( "Failed to get an io_uring submission entry." );
+    }
+
+    return sqe;
+}
+#endif
+
+/// Requested size of the socket receive buffers, so a burst of replies from many agents isn't dropped.  The kernel may cap this.
+static const int kReceiveBuffer = 4 * 1024 * 1024;
+
+
+SNMPpp::SharedTransport::~SharedTransport( void )
+{
+    // before the sockets are closed, since the ring still has receives on them
+    stopRing();
+
+#ifdef __linux__
+    for ( size_t idx = 0; idx < sockets.size(); idx ++ )
+    {
+        if ( sockets[idx] >= 0 )
+        {
+            close( sockets[idx] );
+        }
+    }
+    if ( epfd >= 0 )
+    {
+        close( epfd );
+    }
+#endif
+    ::free( buffer );
+    ::free( datagrams );
+
+    return;
+}
+
+
+SNMPpp::SharedTransport::SharedTransport( const size_t socketsPerFamily, const size_t datagramsPerCall, const EBackend preferred ) :
+    sockets     ( 2 * ( socketsPerFamily < 1 ? 1 : socketsPerFamily ), -1 ),
+    nextSlot    ( 0 ),
+    epfd        ( -1 ),
+    backend     ( kEpoll ),
+    ring        ( NULL ),
+    buffer      ( NULL ),
+    bufferSize  ( 0 ),
+    batchSize   ( datagramsPerCall < 1 ? 1 : datagramsPerCall ),
+    datagrams   ( NULL ),
+    sources     ( batchSize ),
+    completed   ( 0 ),
+    discarded   ( 0 )
+{
+    // only used for snmp_build() and snmp_parse(), never opened
+    snmp_sess_init( &session );
+
+#ifdef __linux__
+    epfd = epoll_create1( EPOLL_CLOEXEC );
+    headers.resize( batchSize * sizeof(struct mmsghdr) );
+    vectors.resize( batchSize * sizeof(struct iovec) );
+#endif
+    if ( epfd < 0 )
+    {
+        /// @throw std::runtime_error if epoll is not available.
+        throw std::runtime_error( "Failed to create the epoll descriptor." );
+    }
+
+    bufferSize  = kMaxDatagram;
+    buffer      = static_cast< u_char * >( malloc( bufferSize ) );
+    datagrams   = static_cast< u_char * >( malloc( batchSize * kMaxDatagram ) );
+    if ( buffer == NULL || datagrams == NULL )
+    {
+#ifdef __linux__
+        close( epfd );
+#endif
+        ::free( buffer );
+        ::free( datagrams );
+        throw std::bad_alloc();
+    }
+
+    if ( preferred == kIoUring && startRing() )
+    {
+        backend = kIoUring;
+    }
+
+    return;
+}
+
+
+size_t SNMPpp::SharedTransport::addTarget( const std::string &server, const std::string &community, const int version, const int retryAttempts, const int timeout )
+{
+    if ( version != SNMP_VERSION_1 && version != SNMP_VERSION_2c )
+    {
+        /// @throw std::invalid_argument if the version is not SNMPv1 or SNMPv2c.
+        throw std::invalid_argument( "Shared transports only support SNMPv1 and SNMPv2c." );
+    }
+
+    // same transport specifiers as net-snmp, where "udp" is IPv4 only
+    std::string address = server;
+    int family = AF_INET;
+    const size_t colon = address.find( ':' );
+    if ( colon != std::string::npos )
+    {
+        const std::string prefix = address.substr( 0, colon );
+        if ( prefix == "udp" )
+        {
+            address.erase( 0, colon + 1 );
+        }
+        else if ( prefix == "udp6" || prefix == "udpv6" || prefix == "udpipv6" )
+        {
+            address.erase( 0, colon + 1 );
+            family = AF_INET6;
+        }
+        else if (   prefix == "tcp"     || prefix == "tcp6"     || prefix == "tcpv6"    || prefix == "tcpipv6"  ||
+                    prefix == "unix"    || prefix == "ipx"      || prefix == "dtlsudp"  || prefix == "tlstcp"   ||
+                    prefix == "ssh" )
+        {
+            /// @throw std::invalid_argument if the server uses a transport other than UDP.
+            throw std::invalid_argument( "Shared transports only support UDP: " + server );
+        }
+    }
+
+    std::string host = address;
+    std::string port = "161";
+    if ( ! address.empty() && address[0] == '[' )
+    {
+        const size_t end = address.find( ']' );
+        if ( end == std::string::npos || ( end + 1 < address.size() && address[end + 1] != ':' ) )
+        {
+            /// @throw std::invalid_argument if an IPv6 address in brackets is malformed.
+            throw std::invalid_argument( "Invalid server address: " + server );
+        }
+        host    = address.substr( 1, end - 1 );
+        family  = AF_INET6;
+        if ( end + 2 < address.size() )
+        {
+            port = address.substr( end + 2 );
+        }
+    }
+    else if ( address.find( ':' ) != std::string::npos && address.find( ':' ) == address.rfind( ':' ) )
+    {
+        host = address.substr( 0, address.find( ':' ) );
+        port = address.substr( address.find( ':' ) + 1 );
+    }
+    else if ( address.find( ':' ) != std::string::npos )
+    {
+        // several colons without brackets is an IPv6 address without a port
+        family = AF_INET6;
+    }
+
+    Target t;
+    memset( &t.address, 0, sizeof(t.address) );
+    t.addressLength = 0;
+#ifdef __linux__
+    struct addrinfo hints;
+    memset( &hints, 0, sizeof(hints) );
+    hints.ai_family     = family;
+    hints.ai_socktype   = SOCK_DGRAM;
+    hints.ai_protocol   = IPPROTO_UDP;
+    struct addrinfo *result = NULL;
+    const int rc = getaddrinfo( host.c_str(), port.c_str(), &hints, &result );
+    if ( rc != 0 || result == NULL )
+    {
+        /// @throw std::runtime_error if the address cannot be resolved.
+        throw std::runtime_error( "Failed to resolve " + server + ": " + gai_strerror( rc ) );
+    }
+    memcpy( &t.address, result->ai_addr, result->ai_addrlen );
+    t.addressLength = result->ai_addrlen;
+    freeaddrinfo( result );
+#endif
+
+    t.socket    = socketFor( family );
+    t.version   = version;
+    t.retries   = retryAttempts < 0 ? 0 : retryAttempts;
+    t.timeout   = timeout < 1000 ? 1 : ( timeout + 999 ) / 1000;
+    t.community = community;
+    targets.push_back( t );
+
+    return targets.size() - 1;
+}
+
+
+uint32_t SNMPpp::SharedTransport::socketFor( const int family )
+{
+    // targets are spread over the slots, each of which has one socket per address family
+    const size_t slot = nextSlot ++ % ( sockets.size() / 2 );
+    const uint32_t idx = static_cast< uint32_t >( slot * 2 + ( family == AF_INET6 ? 1 : 0 ) );
+    if ( sockets[idx] >= 0 )
+    {
+        return idx;
+    }
+
+    int fd = -1;
+#ifdef __linux__
+    fd = socket( family, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0 );
+    if ( fd >= 0 )
+    {
+        const int on = 1;
+        if ( family == AF_INET6 )
+        {
+            setsockopt( fd, IPPROTO_IPV6, IPV6_V6ONLY, &on, sizeof(on) );
+        }
+        setsockopt( fd, SOL_SOCKET, SO_RCVBUF, &kReceiveBuffer, sizeof(kReceiveBuffer) );
+
+        struct epoll_event ev;
+        memset( &ev, 0, sizeof(ev) );
+        ev.events   = EPOLLIN;
+        ev.data.u32 = idx;
+        if ( epoll_ctl( epfd, EPOLL_CTL_ADD, fd, &ev ) != 0 )
+        {
+            close( fd );
+            fd = -1;
+        }
+    }
+#endif
+    if ( fd < 0 )
+    {
+        /// @throw std::runtime_error if the socket cannot be opened.
+        throw std::runtime_error( std::string( "Failed to open a UDP socket: " ) + strerror( errno ) );
+    }
+    sockets[idx] = fd;
+
+    if ( backend == kIoUring )
+    {
+        armRing( idx );
+    }
+
+    return idx;
+}
+
+
+size_t SNMPpp::SharedTransport::socketCount( void ) const
+{
+    size_t count = 0;
+    for ( size_t idx = 0; idx < sockets.size(); idx ++ )
+    {
+        if ( sockets[idx] >= 0 )
+        {
+            count ++;
+        }
+    }
+
+    return count;
+}
+
+
+int SNMPpp::SharedTransport::sendAsync( const size_t target, SNMPpp::PDU &request, const Callback &callback )
+{
+    netsnmp_pdu *pdu = request;
+    if ( pdu == NULL )
+    {
+        /// @throw std::invalid_argument if the PDU is empty.
+        throw std::invalid_argument( "Request PDU must not be NULL." );
+    }
+    if ( target >= targets.size() )
+    {
+        request.free();
+        /// @throw std::invalid_argument if the target does not exist.
+        throw std::invalid_argument( "Unknown target." );
+    }
+    const Target &t = targets[ target ];
+
+    // the request ID is what the reply is matched with, so it must be unique among the outstanding requests
+    while ( pdu->reqid <= 0 || pending.count( pdu->reqid ) )
+    {
+        pdu->reqid = snmp_get_next_reqid();
+    }
+
+    pdu->version = t.version;
+    ::free( pdu->community );
+    pdu->community_len  = t.community.size();
+    pdu->community      = static_cast< u_char * >( malloc( t.community.size() + 1 ) );
+    if ( pdu->community == NULL )
+    {
+        pdu->community_len = 0;
+        request.free();
+        throw std::bad_alloc();
+    }
+    memcpy( pdu->community, t.community.c_str(), t.community.size() + 1 );
+
+    // exactly how net-snmp builds its own requests, since the encoding direction is a build option
+    size_t length = bufferSize;
+    size_t offset = 0;
+    int result = -1;
+    const u_char *packet = NULL;
+#ifdef NETSNMP_USE_REVERSE_ASNENCODING
+    if ( netsnmp_ds_get_boolean( NETSNMP_DS_LIBRARY_ID, NETSNMP_DS_LIB_REVERSE_ENCODE ) )
+    {
+        result  = snmp_build( &buffer, &bufferSize, &offset, &session, pdu );
+        packet  = buffer + bufferSize - offset;
+        length  = offset;
+    }
+    else
+#endif
+    {
+        result  = snmp_build( &buffer, &length, &offset, &session, pdu );
+        packet  = buffer;
+    }
+
+    const int reqid = pdu->reqid;
+    request.free();
+    if ( result != 0 )
+    {
+        std::stringstream ss;
+        ss << "Failed to encode the request. [snmperrno=" << session.s_snmp_errno << "]";
+        /// @throw std::runtime_error if snmp_build() fails.
+        throw std::runtime_error( ss.str() );
+    }
+
+    Request &r  = pending[ reqid ];
+    r.target    = target;
+    r.callback  = callback;
+    r.packet.assign( packet, packet + length );
+    r.retries   = t.retries;
+    r.deadline  = now() + t.timeout;
+    timers.push( Timer( r.deadline, reqid ) );
+    outbox.push_back( reqid );
+
+    return reqid;
+}
+
+
+void SNMPpp::SharedTransport::flush( void )
+{
+    sendQueued( true );
+
+    return;
+}
+
+
+void SNMPpp::SharedTransport::sendQueued( const bool submit )
+{
+    // callbacks of requests which cannot be sent may queue new requests, which are left for the next flush
+    std::vector< int > queued;
+    queued.swap( outbox );
+
+    if ( backend == kIoUring )
+    {
+        transmitRing( queued, submit );
+        rethrowFailure();
+        return;
+    }
+
+    std::vector< int > batch;
+    batch.reserve( batchSize );
+    for ( uint32_t socket = 0; socket < sockets.size(); socket ++ )
+    {
+        if ( sockets[socket] < 0 )
+        {
+            continue;
+        }
+
+        // once the socket buffer is full, the rest of its requests are left to their retry timers
+        bool writable = true;
+        for ( size_t idx = 0; writable && idx < queued.size(); idx ++ )
+        {
+            std::unordered_map< int, Request >::const_iterator iter = pending.find( queued[idx] );
+            if ( iter == pending.end() || targets[ iter->second.target ].socket != socket )
+            {
+                continue;
+            }
+
+            batch.push_back( queued[idx] );
+            if ( batch.size() == batchSize )
+            {
+                writable = transmit( socket, batch.data(), batch.size() );
+                batch.clear();
+            }
+        }
+
+        if ( writable && ! batch.empty() )
+        {
+            transmit( socket, batch.data(), batch.size() );
+        }
+        batch.clear();
+    }
+
+    rethrowFailure();
+
+    return;
+}
+
+
+bool SNMPpp::SharedTransport::transmit( const uint32_t socket, const int *reqids, const size_t count )
+{
+    std::vector< int > failed;
+    bool writable = true;
+
+#ifdef __linux__
+    struct mmsghdr *msgs = reinterpret_cast< struct mmsghdr * >( headers.data() );
+    struct iovec *iov = reinterpret_cast< struct iovec * >( vectors.data() );
+    memset( msgs, 0, count * sizeof(struct mmsghdr) );
+    for ( size_t idx = 0; idx < count; idx ++ )
+    {
+        Request &r      = pending.find( reqids[idx] )->second;
+        Target &t       = targets[ r.target ];
+        iov[idx].iov_base               = r.packet.data();
+        iov[idx].iov_len                = r.packet.size();
+        msgs[idx].msg_hdr.msg_name      = &t.address;
+        msgs[idx].msg_hdr.msg_namelen   = t.addressLength;
+        msgs[idx].msg_hdr.msg_iov       = &iov[idx];
+        msgs[idx].msg_hdr.msg_iovlen    = 1;
+    }
+
+    size_t next = 0;
+    while ( next < count )
+    {
+        const int sent = sendmmsg( sockets[socket], msgs + next, count - next, 0 );
+        if ( sent > 0 )
+        {
+            next += sent;
+            continue;
+        }
+
+        if ( errno == EINTR )
+        {
+            continue;
+        }
+
+        // a full socket buffer won't empty itself while we keep trying, so the
+        // rest of the batch is handled like lost datagrams and sent again by the retry timers
+        if ( errno == EAGAIN || errno == EWOULDBLOCK || errno == ENOBUFS )
+        {
+            writable = false;
+            break;
+        }
+
+        // anything else won't go away on a retry
+        failed.push_back( reqids[next] );
+        next ++;
+    }
+#endif
+
+    // only now, since the callbacks may change the requests the headers point to
+    for ( size_t idx = 0; idx < failed.size(); idx ++ )
+    {
+        complete( failed[idx], STAT_ERROR, NULL );
+    }
+
+    return writable;
+}
+
+
+size_t SNMPpp::SharedTransport::poll( const int milliseconds )
+{
+    const size_t before = completed;
+
+    // with io_uring, the requests are submitted together with the wait for replies
+    expireTimers();
+    sendQueued( false );
+
+    if ( pending.empty() && milliseconds < 0 )
+    {
+        // nothing to wait for, so waiting forever would never return
+        rethrowFailure();
+        return completed - before;
+    }
+
+    // wake up in time for the next retry or timeout
+    int wait = milliseconds;
+    if ( ! timers.empty() )
+    {
+        const int64_t next = timers.top().first - now();
+        if ( wait < 0 || next < wait )
+        {
+            wait = next < 0 ? 0 : static_cast< int >( next );
+        }
+    }
+
+    if ( backend == kIoUring )
+    {
+        waitRing( wait );
+    }
+    else
+    {
+        int count = -1;
+#ifdef __linux__
+        struct epoll_event ev[ 64 ];
+        count = epoll_wait( epfd, ev, 64, wait );
+#else
+        errno = ENOSYS;
+#endif
+        if ( count < 0 && errno != EINTR )
+        {
+            /// @throw std::runtime_error if epoll_wait() fails.
+            throw std::runtime_error( std::string( "Failed to wait for replies: " ) + strerror( errno ) );
+        }
+
+        for ( int idx = 0; idx < count; idx ++ )
+        {
+#ifdef __linux__
+            receive( ev[idx].data.u32 );
+#endif
+        }
+    }
+
+    // retries which are due, and requests sent by the callbacks
+    expireTimers();
+    flush();
+
+    return completed - before;
+}
+
+
+void SNMPpp::SharedTransport::receive( const uint32_t socket )
+{
+#ifdef __linux__
+    struct mmsghdr *msgs = reinterpret_cast< struct mmsghdr * >( headers.data() );
+    struct iovec *iov = reinterpret_cast< struct iovec * >( vectors.data() );
+    while ( true )
+    {
+        memset( msgs, 0, batchSize * sizeof(struct mmsghdr) );
+        for ( size_t idx = 0; idx < batchSize; idx ++ )
+        {
+            iov[idx].iov_base               = datagrams + idx * kMaxDatagram;
+            iov[idx].iov_len                = kMaxDatagram;
+            msgs[idx].msg_hdr.msg_name      = &sources[idx];
+            msgs[idx].msg_hdr.msg_namelen   = sizeof(struct sockaddr_storage);
+            msgs[idx].msg_hdr.msg_iov       = &iov[idx];
+            msgs[idx].msg_hdr.msg_iovlen    = 1;
+        }
+
+        const int count = recvmmsg( sockets[socket], msgs, batchSize, MSG_DONTWAIT, NULL );
+        for ( int idx = 0; idx < count; idx ++ )
+        {
+            handleDatagram( datagrams + idx * kMaxDatagram, msgs[idx].msg_len, reinterpret_cast< const struct sockaddr * >( &sources[idx] ), msgs[idx].msg_hdr.msg_namelen );
+        }
+
+        if ( count < static_cast< int >( batchSize ) )
+        {
+            // a partial batch means nothing is left to read, which saves a call that would fail with EAGAIN
+            break;
+        }
+    }
+#endif
+
+    return;
+}
+
+
+void SNMPpp::SharedTransport::handleDatagram( u_char *data, const size_t length, const struct sockaddr *from, const socklen_t fromLength )
+{
+    // net-snmp parses into a zeroed PDU, exactly as it does for its own sessions
+    netsnmp_pdu *pdu = static_cast< netsnmp_pdu * >( calloc( 1, sizeof(netsnmp_pdu) ) );
+    if ( pdu == NULL )
+    {
+        discarded ++;
+        return;
+    }
+
+    // without an internal session, only SNMPv1 and SNMPv2c messages can be parsed
+    std::unordered_map< int, Request >::const_iterator iter = pending.end();
+    if ( snmp_parse( NULL, &session, pdu, data, length ) == 0 && pdu->command == SNMP_MSG_RESPONSE )
+    {
+        iter = pending.find( pdu->reqid );
+    }
+
+    if ( iter == pending.end() || ! sameAddress( targets[ iter->second.target ], from, fromLength ) )
+    {
+        // garbage, a duplicate, a late reply to a request which already timed out, or someone else's reply
+        discarded ++;
+        snmp_free_pdu( pdu );
+        return;
+    }
+
+    complete( iter->first, STAT_SUCCESS, pdu );
+    snmp_free_pdu( pdu );
+
+    return;
+}
+
+
+void SNMPpp::SharedTransport::expireTimers( void )
+{
+    const int64_t t = now();
+    while ( ! timers.empty() && timers.top().first <= t )
+    {
+        const Timer timer = timers.top();
+        timers.pop();
+
+        std::unordered_map< int, Request >::iterator iter = pending.find( timer.second );
+        if ( iter == pending.end() || iter->second.deadline != timer.first )
+        {
+            // the request has completed, or has been rescheduled since
+            continue;
+        }
+
+        Request &r = iter->second;
+        if ( r.retries > 0 )
+        {
+            // the same bytes, so a late reply to an earlier attempt is just as good
+            r.retries --;
+            r.deadline = t + targets[ r.target ].timeout;
+            timers.push( Timer( r.deadline, timer.second ) );
+            outbox.push_back( timer.second );
+        }
+        else
+        {
+            complete( timer.second, STAT_TIMEOUT, NULL );
+        }
+    }
+
+    return;
+}
+
+
+void SNMPpp::SharedTransport::complete( const int reqid, const int status, netsnmp_pdu *pdu )
+{
+    std::unordered_map< int, Request >::iterator iter = pending.find( reqid );
+    if ( iter == pending.end() )
+    {
+        return;
+    }
+
+    // forget the request first, since the callback may send more requests
+    const size_t target = iter->second.target;
+    const Callback callback = std::move( iter->second.callback );
+    pending.erase( iter );
+    completed ++;
+
+    // exceptions are kept until poll() returns, so the replies already read are not lost
+    try
+    {
+        const SNMPpp::PDU response( pdu );
+        callback( status, target, response );
+    }
+    catch ( ... )
+    {
+        if ( ! failure )
+        {
+            failure = std::current_exception();
+        }
+    }
+
+    return;
+}
+
+
+void SNMPpp::SharedTransport::rethrowFailure( void )
+{
+    if ( failure )
+    {
+        std::exception_ptr e = failure;
+        failure = std::exception_ptr();
+        /// @throw Any exception thrown by a callback.
+        std::rethrow_exception( e );
+    }
+
+    return;
+}
+
+
+void SNMPpp::SharedTransport::run( void )
+{
+    while ( ! pending.empty() )
+    {
+        poll( -1 );
+    }
+
+    return;
+}
+
+
+int64_t SNMPpp::SharedTransport::now( void )
+{
+    return std::chrono::duration_cast< std::chrono::milliseconds >( std::chrono::steady_clock::now().time_since_epoch() ).count();
+}
+
+
+bool SNMPpp::SharedTransport::sameAddress( const Target &target, const struct sockaddr *from, const socklen_t fromLength )
+{
+    if ( from->sa_family != target.address.ss_family )
+    {
+        return false;
+    }
+
+#ifdef __linux__
+    if ( from->sa_family == AF_INET && fromLength >= static_cast< socklen_t >( sizeof(struct sockaddr_in) ) )
+    {
+        const struct sockaddr_in *a = reinterpret_cast< const struct sockaddr_in * >( &target.address );
+        const struct sockaddr_in *b = reinterpret_cast< const struct sockaddr_in * >( from );
+        return a->sin_port == b->sin_port && a->sin_addr.s_addr == b->sin_addr.s_addr;
+    }
+    if ( from->sa_family == AF_INET6 && fromLength >= static_cast< socklen_t >( sizeof(struct sockaddr_in6) ) )
+    {
+        const struct sockaddr_in6 *a = reinterpret_cast< const struct sockaddr_in6 * >( &target.address );
+        const struct sockaddr_in6 *b = reinterpret_cast< const struct sockaddr_in6 * >( from );
+        return a->sin6_port == b->sin6_port && memcmp( &a->sin6_addr, &b->sin6_addr, sizeof(a->sin6_addr) ) == 0;
+    }
+#endif
+
+    return false;
+}
+
+
+bool SNMPpp::SharedTransport::startRing( void )
+{
+#ifdef SNMPPP_HAVE_LIBURING
+    ring = new Ring;
+    if ( io_uring_queue_init( 1024, &ring->uring, 0 ) < 0 )
+    {
+        // too old a kernel, or io_uring disabled by the administrator
+        delete ring;
+        ring = NULL;
+        return false;
+    }
+
+    ring->count = 64;
+    while ( ring->count < batchSize && ring->count < 32768 )
+    {
+        ring->count *= 2;
+    }
+    ring->length    = sizeof(struct io_uring_recvmsg_out) + sizeof(struct sockaddr_storage) + kMaxDatagram;
+    ring->memory    = static_cast< u_char * >( malloc( ring->count * ring->length ) );
+    int result      = 0;
+    ring->buffers   = ring->memory == NULL ? NULL : io_uring_setup_buf_ring( &ring->uring, ring->count, kBufferGroup, 0, &result );
+    if ( ring->buffers == NULL )
+    {
+        // buffer rings are needed by the multishot receives
+        io_uring_queue_exit( &ring->uring );
+        ::free( ring->memory );
+        delete ring;
+        ring = NULL;
+        return false;
+    }
+
+    for ( unsigned idx = 0; idx < ring->count; idx ++ )
+    {
+        io_uring_buf_ring_add( ring->buffers, ring->memory + idx * ring->length, ring->length, idx, io_uring_buf_ring_mask( ring->count ), idx );
+    }
+    io_uring_buf_ring_advance( ring->buffers, ring->count );
+
+    memset( &ring->receive, 0, sizeof(ring->receive) );
+    ring->receive.msg_namelen = sizeof(struct sockaddr_storage);
+
+    return true;
+#else
+    return false;
+#endif
+}
+
+
+void SNMPpp::SharedTransport::stopRing( void )
+{
+#ifdef SNMPPP_HAVE_LIBURING
+    if ( ring != NULL )
+    {
+        io_uring_free_buf_ring( &ring->uring, ring->buffers, ring->count, kBufferGroup );
+        io_uring_queue_exit( &ring->uring );
+        ::free( ring->memory );
+        delete ring;
+        ring = NULL;
+    }
+#endif
+    backend = kEpoll;
+
+    return;
+}
+
+
+void SNMPpp::SharedTransport::armRing( const uint32_t socket )
+{
+#ifdef SNMPPP_HAVE_LIBURING
+    struct io_uring_sqe *sqe = nextSqe( &ring->uring );
+    io_uring_prep_recvmsg_multishot( sqe, sockets[socket], &ring->receive, 0 );
+    sqe->flags      |= IOSQE_BUFFER_SELECT;
+    sqe->buf_group  = kBufferGroup;
+    io_uring_sqe_set_data64( sqe, kReceiveTag | socket );
+#endif
+
+    return;
+}
+
+
+void SNMPpp::SharedTransport::transmitRing( const std::vector< int > &reqids, const bool submit )
+{
+#ifdef SNMPPP_HAVE_LIBURING
+    for ( size_t idx = 0; idx < reqids.size(); idx ++ )
+    {
+        std::unordered_map< int, Request >::const_iterator iter = pending.find( reqids[idx] );
+        if ( iter == pending.end() )
+        {
+            continue;
+        }
+        const Target &t = targets[ iter->second.target ];
+
+        // the request itself may complete before the kernel is done with a retry, so the send has a copy
+        size_t slot = ring->sends.size();
+        if ( ring->idle.empty() )
+        {
+            ring->sends.emplace_back();
+        }
+        else
+        {
+            slot = ring->idle.back();
+            ring->idle.pop_back();
+        }
+        Ring::Send &send = ring->sends[slot];
+        send.reqid  = reqids[idx];
+        send.packet = iter->second.packet;
+        memcpy( &send.address, &t.address, sizeof(send.address) );
+        send.vector.iov_base            = send.packet.data();
+        send.vector.iov_len             = send.packet.size();
+        memset( &send.header, 0, sizeof(send.header) );
+        send.header.msg_name            = &send.address;
+        send.header.msg_namelen         = t.addressLength;
+        send.header.msg_iov             = &send.vector;
+        send.header.msg_iovlen          = 1;
+
+        struct io_uring_sqe *sqe = nextSqe( &ring->uring );
+        io_uring_prep_sendmsg( sqe, sockets[t.socket], &send.header, 0 );
+        io_uring_sqe_set_data64( sqe, slot );
+    }
+
+    // a single system call for the whole burst
+    if ( submit )
+    {
+        io_uring_submit( &ring->uring );
+    }
+#endif
+
+    return;
+}
+
+
+void SNMPpp::SharedTransport::waitRing( const int milliseconds )
+{
+#ifdef SNMPPP_HAVE_LIBURING
+    struct __kernel_timespec ts;
+    ts.tv_sec   = milliseconds < 0 ? 0 : milliseconds / 1000;
+    ts.tv_nsec  = milliseconds < 0 ? 0 : milliseconds % 1000 * 1000000LL;
+    struct io_uring_cqe *cqe = NULL;
+    const int result = io_uring_submit_and_wait_timeout( &ring->uring, &cqe, 1, milliseconds < 0 ? NULL : &ts, NULL );
+    if ( result < 0 && result != -ETIME && result != -EINTR )
+    {
+        /// @throw std::runtime_error if waiting on io_uring fails.
+        throw std::runtime_error( std::string( "Failed to wait for replies: " ) + strerror( -result ) );
+    }
+
+    const unsigned mask = io_uring_buf_ring_mask( ring->count );
+    bool multishot = true;
+    while ( io_uring_peek_cqe( &ring->uring, &cqe ) == 0 )
+    {
+        const uint64_t data     = io_uring_cqe_get_data64( cqe );
+        const int res           = cqe->res;
+        const unsigned flags    = cqe->flags;
+        io_uring_cqe_seen( &ring->uring, cqe );
+
+        if ( ( data & kReceiveTag ) == 0 )
+        {
+            Ring::Send &send = ring->sends[ data ];
+            const int reqid = send.reqid;
+            ring->idle.push_back( data );
+
+            // as with sendmmsg(), a full socket buffer is handled like a lost datagram
+            if ( res < 0 && res != -EAGAIN && res != -ENOBUFS && res != -EINTR )
+            {
+                complete( reqid, STAT_ERROR, NULL );
+            }
+            continue;
+        }
+
+        const uint32_t socket = static_cast< uint32_t >( data & ~kReceiveTag );
+        if ( flags & IORING_CQE_F_BUFFER )
+        {
+            const unsigned bid = flags >> IORING_CQE_BUFFER_SHIFT;
+            u_char *buf = ring->memory + bid * ring->length;
+            struct io_uring_recvmsg_out *out = res > 0 ? io_uring_recvmsg_validate( buf, res, &ring->receive ) : NULL;
+            if ( out == NULL || ( out->flags & MSG_TRUNC ) )
+            {
+                discarded ++;
+            }
+            else
+            {
+                handleDatagram( static_cast< u_char * >( io_uring_recvmsg_payload( out, &ring->receive ) ), io_uring_recvmsg_payload_length( out, res, &ring->receive ), static_cast< const struct sockaddr * >( io_uring_recvmsg_name( out ) ), out->namelen );
+            }
+
+            // hand the buffer back to the kernel
+            io_uring_buf_ring_add( ring->buffers, buf, ring->length, bid, mask, 0 );
+            io_uring_buf_ring_advance( ring->buffers, 1 );
+        }
+
+        if ( ( flags & IORING_CQE_F_MORE ) == 0 && sockets[socket] >= 0 )
+        {
+            if ( res == -EINVAL || res == -EOPNOTSUPP )
+            {
+                // the kernel has io_uring, but not multishot receives
+                multishot = false;
+            }
+            else if ( multishot )
+            {
+                // the receive stops when it runs out of buffers, which have been handed back by now
+                armRing( socket );
+            }
+        }
+    }
+
+    if ( ! multishot )
+    {
+        // every completion has been handled, so the sends still holding a
+        // slot may never have been submitted: they go out again with sendmmsg()
+        std::vector< bool > inFlight( ring->sends.size(), true );
+        for ( size_t idx = 0; idx < ring->idle.size(); idx ++ )
+        {
+            inFlight[ ring->idle[idx] ] = false;
+        }
+        for ( size_t idx = 0; idx < inFlight.size(); idx ++ )
+        {
+            if ( inFlight[idx] && pending.count( ring->sends[idx].reqid ) )
+            {
+                outbox.push_back( ring->sends[idx].reqid );
+            }
+        }
+
+        // the sockets are also in epoll, where the datagrams are still waiting
+        stopRing();
+    }
+#endif
+
+    return;
+}
@@ -253,12 +253,10 @@ SNMPpp::Varlist SNMPpp::createV2TrapVarlist( const SNMPpp::OID &o, const long up
         throw std::invalid_argument( "Cannot create SNMPv2 trap without an OID." );
     }
 
-    const SNMPpp::OID sysUpTime ( OID::kSysUpTime   ); // set this to centiseconds
-    const SNMPpp::OID trap      ( OID::kTrap        ); // set this to the OID you want to send out
-
+    // sysUpTime is set to centiseconds, and snmpTrapOID is set to the OID we want to send out
     SNMPpp::Varlist varlist;
-    snmp_varlist_add_variable( varlist, sysUpTime, sysUpTime, ASN_TIMETICKS, (unsigned char*)&uptime, sizeof(uptime) );
-    snmp_varlist_add_variable( varlist, trap, trap, ASN_OBJECT_ID, o, o.size() * sizeof(unsigned long) );
+    snmp_varlist_add_variable( varlist, SysUpTimeOID::value, SysUpTimeOID::length, ASN_TIMETICKS, (unsigned char*)&uptime, sizeof(uptime) );
+    snmp_varlist_add_variable( varlist, SnmpTrapOID::value, SnmpTrapOID::length, ASN_OBJECT_ID, o, o.size() * sizeof(oid) );
 
     return varlist;
 }
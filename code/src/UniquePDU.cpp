@@ -0,0 +1,109 @@
+// SNMPpp: https://sourceforge.net/p/snmppp/
+// SNMPpp project uses the MIT license. See LICENSE for details.
+// Copyright (C) 2013 Stephane Charette <stephanecharette@gmail.com>
+
+#include <string.h>
+#include <stdlib.h>
+#include <utility>
+#include <SNMPpp/UniquePDU.hpp>
+
+
+SNMPpp::UniquePDU::~UniquePDU( void )
+{
+    free();
+
+    return;
+}
+
+
+SNMPpp::UniquePDU::UniquePDU( const SNMPpp::PDU::EType t ) :
+    PDU( t )
+{
+    return;
+}
+
+
+SNMPpp::UniquePDU::UniquePDU( netsnmp_pdu *p ) :
+    PDU( p )
+{
+    return;
+}
+
+
+SNMPpp::UniquePDU::UniquePDU( SNMPpp::PDU &&rhs ) :
+    PDU( std::move( rhs ) )
+{
+    return;
+}
+
+
+SNMPpp::UniquePDU::UniquePDU( SNMPpp::UniquePDU &&rhs ) noexcept :
+    PDU( std::move( rhs ) )
+{
+    return;
+}
+
+
+SNMPpp::UniquePDU &SNMPpp::UniquePDU::operator=( SNMPpp::UniquePDU &&rhs ) noexcept
+{
+    return operator=( static_cast< PDU && >( rhs ) );
+}
+
+
+SNMPpp::UniquePDU &SNMPpp::UniquePDU::operator=( SNMPpp::PDU &&rhs ) noexcept
+{
+    if ( &rhs != this )
+    {
+        free();
+        PDU::operator=( std::move( rhs ) );
+    }
+
+    return *this;
+}
+
+
+SNMPpp::PDU SNMPpp::UniquePDU::release( void )
+{
+    // moving keeps the remembered tail, and clears this object
+    PDU p( std::move( static_cast< PDU & >( *this ) ) );
+
+    return p;
+}
+
+
+SNMPpp::UniquePDU &SNMPpp::UniquePDU::recycle( const SNMPpp::PDU::EType t )
+{
+    if ( pdu == NULL || pdu->securityStateRef != NULL )
+    {
+        free();
+        PDU::operator=( PDU( t ) );
+
+        return *this;
+    }
+
+    // release everything snmp_free_pdu() would release, except for the PDU
+    // itself (the pointers don't need to be reset since memset() follows)
+    snmp_free_varbind( pdu->variables );
+    ::free( pdu->enterprise         );
+    ::free( pdu->community          );
+    ::free( pdu->contextEngineID    );
+    ::free( pdu->securityEngineID   );
+    ::free( pdu->contextName        );
+    ::free( pdu->securityName       );
+    ::free( pdu->transport_data     );
+
+    // ...and then initialize the header the same way snmp_pdu_create() does
+    memset( pdu, 0, sizeof(netsnmp_pdu) );
+    pdu->version        = SNMP_DEFAULT_VERSION;
+    pdu->command        = t;
+    pdu->errstat        = SNMP_DEFAULT_ERRSTAT;
+    pdu->errindex       = SNMP_DEFAULT_ERRINDEX;
+    pdu->securityModel  = SNMP_DEFAULT_SECMODEL;
+    pdu->reqid          = snmp_get_next_reqid();
+    pdu->msgid          = snmp_get_next_msgid();
+    type                = t;
+    tail                = NULL;
+    index.reset();
+
+    return *this;
+}
@@ -0,0 +1,188 @@
+// SNMPpp: https://sourceforge.net/p/snmppp/
+// SNMPpp project uses the MIT license. See LICENSE for details.
+// Copyright (C) 2013 Stephane Charette <stephanecharette@gmail.com>
+
+#include <stdexcept>
+#include <SNMPpp/Value.hpp>
+
+
+/// net-snmp stores 64-bit values as two 32-bit halves, each in an unsigned long.
+static uint64_t join( const struct counter64 *c )
+{
+    return ( static_cast<uint64_t>( c->high & 0xffffffff ) << 32 ) | static_cast<uint64_t>( c->low & 0xffffffff );
+}
+
+
+SNMPpp::Value::Value( void ) :
+    length  ( 0         ),
+    asn     ( ASN_NULL  ),
+    kind    ( kNone     )
+{
+    value.u = 0;
+
+    return;
+}
+
+
+SNMPpp::Value::Value( const netsnmp_variable_list *vl ) :
+    length  ( 0         ),
+    asn     ( ASN_NULL  ),
+    kind    ( kNone     )
+{
+    value.u = 0;
+
+    if ( vl == NULL )
+    {
+        return;
+    }
+
+    asn = vl->type;
+    if ( vl->val.integer == NULL )
+    {
+        // ASN_NULL, or one of the exceptions such as SNMP_NOSUCHINSTANCE
+        return;
+    }
+
+    switch ( vl->type )
+    {
+        case ASN_BOOLEAN:
+            // rfc1212 has true=1 and false=2, so testing for non-zero would read false as true
+            kind    = kSigned;
+            value.s = ( *vl->val.integer == 1 ? 1 : 0 );
+            break;
+
+        case ASN_INTEGER:
+            kind    = kSigned;
+            value.s = *vl->val.integer;
+            break;
+
+        case ASN_COUNTER:
+        case ASN_GAUGE:
+        case ASN_TIMETICKS:
+        case ASN_UINTEGER:
+            // these are all 32-bit unsigned values stored in a long
+            kind    = kUnsigned;
+            value.u = static_cast<uint32_t>( *vl->val.integer );
+            break;
+
+        case ASN_COUNTER64:
+            kind    = kUnsigned;
+            value.u = join( vl->val.counter64 );
+            break;
+
+        case ASN_OCTET_STR:
+        case ASN_IPADDRESS:
+        case ASN_OPAQUE:
+        case ASN_BIT_STR:
+        case ASN_NSAP:
+            kind        = kBytes;
+            value.bytes = vl->val.string;
+            length      = vl->val_len;
+            break;
+
+        case ASN_OBJECT_ID:
+            kind        = kObjectId;
+            value.objid = vl->val.objid;
+            length      = vl->val_len / sizeof(oid);
+            break;
+
+#ifdef NETSNMP_WITH_OPAQUE_SPECIAL_TYPES
+        case ASN_OPAQUE_COUNTER64:
+        case ASN_OPAQUE_U64:
+        case ASN_UNSIGNED64:
+            kind    = kUnsigned;
+            value.u = join( vl->val.counter64 );
+            break;
+
+        case ASN_OPAQUE_I64:
+        case ASN_INTEGER64:
+            kind    = kSigned;
+            value.s = static_cast<int64_t>( join( vl->val.counter64 ) );
+            break;
+
+        case ASN_OPAQUE_FLOAT:
+        case ASN_FLOAT:
+            kind    = kDouble;
+            value.d = *vl->val.floatVal;
+            break;
+
+        case ASN_OPAQUE_DOUBLE:
+        case ASN_DOUBLE:
+            kind    = kDouble;
+            value.d = *vl->val.doubleVal;
+            break;
+#endif
+
+        default:
+            // ASN_NULL and the exceptions such as SNMP_NOSUCHINSTANCE
+            break;
+    }
+
+    return;
+}
+
+
+int64_t SNMPpp::Value::asSigned( void ) const
+{
+    switch ( kind )
+    {
+        case kSigned:   return value.s;
+        case kUnsigned: return static_cast<int64_t>( value.u );
+        case kDouble:   return static_cast<int64_t>( value.d );
+    }
+
+    /// @throw std::logic_error if the value is not numeric.
+    throw std::logic_error( "Value is not numeric." );
+}
+
+
+uint64_t SNMPpp::Value::asUnsigned( void ) const
+{
+    switch ( kind )
+    {
+        case kSigned:   return static_cast<uint64_t>( value.s );
+        case kUnsigned: return value.u;
+        case kDouble:   return static_cast<uint64_t>( value.d );
+    }
+
+    /// @throw std::logic_error if the value is not numeric.
+    throw std::logic_error( "Value is not numeric." );
+}
+
+
+double SNMPpp::Value::asDouble( void ) const
+{
+    switch ( kind )
+    {
+        case kSigned:   return static_cast<double>( value.s );
+        case kUnsigned: return static_cast<double>( value.u );
+        case kDouble:   return value.d;
+    }
+
+    /// @throw std::logic_error if the value is not numeric.
+    throw std::logic_error( "Value is not numeric." );
+}
+
+
+std::string SNMPpp::Value::getBytes( void ) const
+{
+    if ( kind != kBytes )
+    {
+        /// @throw std::logic_error if the value is not a string of octets.
+        throw std::logic_error( "Value is not a string of octets." );
+    }
+
+    return std::string( reinterpret_cast<const char *>( value.bytes ), length );
+}
+
+
+SNMPpp::OIDView SNMPpp::Value::getOIDView( void ) const
+{
+    if ( kind != kObjectId )
+    {
+        /// @throw std::logic_error if the value is not an OID.
+        throw std::logic_error( "Value is not an OID." );
+    }
+
+    return SNMPpp::OIDView( value.objid, length );
+}
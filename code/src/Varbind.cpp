@@ -0,0 +1,212 @@
+// SNMPpp: https://sourceforge.net/p/snmppp/
+// SNMPpp project uses the MIT license. See LICENSE for details.
+// Copyright (C) 2013 Stephane Charette <stephanecharette@gmail.com>
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdexcept>
+#include <SNMPpp/Varbind.hpp>
+
+
+bool SNMPpp::Varbind::getBool( void ) const
+{
+    if ( ptr->type != ASN_BOOLEAN )
+    {
+        /// @throw std::invalid_argument if the varbind is not `ASN_BOOLEAN`.
+        throw std::invalid_argument( "OID " + name().to_str() + " is not a boolean type." );
+    }
+
+    return *ptr->val.integer == 1; // rfc1212, true=1, false=2
+}
+
+
+long SNMPpp::Varbind::getLong( void ) const
+{
+    if ( ptr->type != ASN_INTEGER )
+    {
+        /// @throw std::invalid_argument if the varbind is not `ASN_INTEGER`.
+        throw std::invalid_argument( "OID " + name().to_str() + " is not a numeric type." );
+    }
+
+    return *ptr->val.integer;
+}
+
+
+std::string SNMPpp::Varbind::getString( void ) const
+{
+    if ( ptr->type != ASN_OCTET_STR )
+    {
+        /// @throw std::invalid_argument if the varbind is not `ASN_OCTET_STR`.
+        throw std::invalid_argument( "OID " + name().to_str() + " is not a string." );
+    }
+
+    return std::string( (const char *)ptr->val.string, ptr->val_len );
+}
+
+
+SNMPpp::OID SNMPpp::Varbind::getOID( void ) const
+{
+    if ( ptr->type != ASN_OBJECT_ID )
+    {
+        /// @throw std::invalid_argument if the varbind is not `ASN_OBJECT_ID`.
+        throw std::invalid_argument( "OID " + name().to_str() + " is not a OID." );
+    }
+
+    return SNMPpp::OID( ptr->val.objid, ptr->val_len/sizeof(unsigned long) );
+}
+
+
+void SNMPpp::Varbind::verify( const bool isExpectedType, const char *description ) const
+{
+    if ( ! isExpectedType )
+    {
+        /// @throw std::invalid_argument if the varbind is not of the expected type.
+        throw std::invalid_argument( "OID " + name().to_str() + " is not " + description + "." );
+    }
+
+    return;
+}
+
+
+uint32_t SNMPpp::Varbind::getCounter32( void ) const
+{
+    verify( ptr->type == ASN_COUNTER, "a Counter32" );
+
+    return static_cast<uint32_t>( *ptr->val.integer );
+}
+
+
+uint32_t SNMPpp::Varbind::getGauge32( void ) const
+{
+    verify( ptr->type == ASN_GAUGE, "a Gauge32" );
+
+    return static_cast<uint32_t>( *ptr->val.integer );
+}
+
+
+uint32_t SNMPpp::Varbind::getTimeTicks( void ) const
+{
+    verify( ptr->type == ASN_TIMETICKS, "a TimeTicks" );
+
+    return static_cast<uint32_t>( *ptr->val.integer );
+}
+
+
+unsigned long SNMPpp::Varbind::getUnsigned( void ) const
+{
+    verify( ptr->type == ASN_COUNTER    ||
+            ptr->type == ASN_GAUGE      ||
+            ptr->type == ASN_TIMETICKS  ||
+            ptr->type == ASN_UINTEGER   , "an unsigned type" );
+
+    return static_cast<uint32_t>( *ptr->val.integer );
+}
+
+
+uint64_t SNMPpp::Varbind::getCounter64( void ) const
+{
+    bool isCounter64 = ( ptr->type == ASN_COUNTER64 );
+#ifdef NETSNMP_WITH_OPAQUE_SPECIAL_TYPES
+    isCounter64 =   isCounter64                         ||
+                    ptr->type == ASN_OPAQUE_COUNTER64   ||
+                    ptr->type == ASN_OPAQUE_U64         ||
+                    ptr->type == ASN_UNSIGNED64         ;
+#endif
+    verify( isCounter64, "a Counter64" );
+
+    return SNMPpp::Value( ptr ).asUnsigned();
+}
+
+
+int64_t SNMPpp::Varbind::getInteger64( void ) const
+{
+    bool isInteger64 = false;
+#ifdef NETSNMP_WITH_OPAQUE_SPECIAL_TYPES
+    isInteger64 =   ptr->type == ASN_INTEGER64          ||
+                    ptr->type == ASN_OPAQUE_I64         ;
+#endif
+    verify( isInteger64, "a 64-bit integer" );
+
+    return SNMPpp::Value( ptr ).asSigned();
+}
+
+
+uint32_t SNMPpp::Varbind::getIpAddress( void ) const
+{
+    verify( ptr->type == ASN_IPADDRESS && ptr->val_len == 4, "an IpAddress" );
+
+    uint32_t address = 0;
+    memcpy( &address, ptr->val.string, sizeof(address) );
+
+    return address;
+}
+
+
+double SNMPpp::Varbind::getDouble( void ) const
+{
+    const SNMPpp::Value v( ptr );
+    verify( v.getKind() == SNMPpp::Value::kDouble, "a floating point type" );
+
+    return v.asDouble();
+}
+
+
+std::string &SNMPpp::Varbind::appendTo( std::string &s, const char *hint ) const
+{
+    // most values easily fit in this buffer, in which case we only touch the string once
+    char buffer[256];
+    const size_t len = format( buffer, sizeof(buffer), hint );
+    if ( len <= sizeof(buffer) )
+    {
+        s.append( buffer, len );
+    }
+    else
+    {
+        const size_t pos = s.size();
+        s.resize( pos + len );
+        format( &s[pos], len, hint );
+    }
+
+    return s;
+}
+
+
+std::string SNMPpp::Varbind::asNetSnmpString( void ) const
+{
+    u_char *buf = NULL;
+    size_t buf_len = 0;
+    size_t out_len = 0;
+    sprint_realloc_value( &buf, &buf_len, &out_len, 1, ptr->name, ptr->name_length, ptr );
+
+    // The buffer should look something like one of these examples:
+    //
+    //      OID: iso.3.6.1.6.3.16.2.2.1
+    //      STRING: "The SNMP Management Architecture MIB."
+    //
+    // We need to extract the two parts -- the type followed by the value.
+
+    std::string asn( (char*) buf );
+    std::string txt( (char*) buf );
+
+    ::free( buf );
+
+    size_t pos = asn.find( ": " );
+    if ( pos != std::string::npos )
+    {
+        asn.erase( pos, std::string::npos );
+        txt.erase( 0, pos + 2 );
+
+        // strings start and end with double quotes -- get rid of those double quotes
+        const size_t len = txt.size();
+        if (    asn         == "STRING" &&
+                len         >= 2        &&
+                txt[0]      == '\"'     &&
+                txt[len-1]  == '\"'     )
+        {
+            txt.erase( len - 1 );   // erase trailing double quote
+            txt.erase( 0, 1 );      // erase leading double quote
+        }
+    }
+
+    return txt;
+}
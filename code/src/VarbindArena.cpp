@@ -0,0 +1,137 @@
+// SNMPpp: https://sourceforge.net/p/snmppp/
+// SNMPpp project uses the MIT license. See LICENSE for details.
+// Copyright (C) 2013 Stephane Charette <stephanecharette@gmail.com>
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdexcept>
+#include <SNMPpp/VarbindArena.hpp>
+
+
+/// Every allocation is rounded up to this, which is enough for any type net-snmp stores in a varbind.
+static const size_t kAlignment = 16;
+
+
+SNMPpp::VarbindArena::~VarbindArena( void )
+{
+    reset();
+    for ( size_t idx = 0; idx < blocks.size(); idx ++ )
+    {
+        ::free( blocks[idx] );
+    }
+
+    return;
+}
+
+
+SNMPpp::VarbindArena::VarbindArena( const size_t bytesPerBlock ) :
+    blockSize   ( bytesPerBlock < 16384 ? 16384 : bytesPerBlock ),
+    current     ( 0 ),
+    offset      ( 0 ),
+    used        ( 0 )
+{
+    return;
+}
+
+
+void *SNMPpp::VarbindArena::allocate( const size_t len )
+{
+    const size_t rounded = ( len + kAlignment - 1 ) / kAlignment * kAlignment;
+
+    char *p = NULL;
+    if ( rounded > blockSize / 4 )
+    {
+        p = static_cast< char * >( malloc( rounded ) );
+        if ( p != NULL )
+        {
+            large.push_back( p );
+        }
+    }
+    else
+    {
+        if ( current < blocks.size() && offset + rounded > blockSize )
+        {
+            // this block is full, so move on to the next one
+            current ++;
+            offset = 0;
+        }
+        if ( current == blocks.size() )
+        {
+            char *block = static_cast< char * >( malloc( blockSize ) );
+            if ( block != NULL )
+            {
+                blocks.push_back( block );
+            }
+        }
+        if ( current < blocks.size() )
+        {
+            p = blocks[current] + offset;
+            offset += rounded;
+        }
+    }
+
+    if ( p == NULL )
+    {
+        /// @throw std::runtime_error if the memory cannot be allocated.
+        throw std::runtime_error( "Failed to allocate memory for the varbind arena." );
+    }
+    used += rounded;
+
+    return p;
+}
+
+
+netsnmp_variable_list *SNMPpp::VarbindArena::create( const SNMPpp::OIDView &o, const u_char type, const void *value, const size_t len )
+{
+    netsnmp_variable_list *vl = static_cast< netsnmp_variable_list * >( allocate( sizeof(netsnmp_variable_list) ) );
+    memset( vl, 0, sizeof(netsnmp_variable_list) );
+
+    // same rules as snmp_set_var_objid(), but the long names come from the arena
+    vl->name = vl->name_loc;
+    if ( o.size() > MAX_OID_LEN )
+    {
+        vl->name = static_cast< oid * >( allocate( o.size() * sizeof(oid) ) );
+    }
+    if ( ! o.empty() )
+    {
+        memcpy( vl->name, o.data(), o.size() * sizeof(oid) );
+    }
+    vl->name_length = o.size();
+
+    if ( len <= sizeof(vl->buf) )
+    {
+        // net-snmp stores small values in vl->buf and converts the integer
+        // types to a long, so no memory is allocated and no rules are duplicated
+        if ( snmp_set_var_typed_value( vl, type, value, len ) != 0 )
+        {
+            /// @throw std::runtime_error if net-snmp rejects the value.
+            throw std::runtime_error( "Failed to set the value of " + o.to_str() + "." );
+        }
+    }
+    else
+    {
+        // only strings and OIDs are this long, and those are stored as-is
+        vl->type        = type;
+        vl->val.string  = static_cast< u_char * >( allocate( len ) );
+        vl->val_len     = len;
+        memcpy( vl->val.string, value, len );
+    }
+
+    return vl;
+}
+
+
+void SNMPpp::VarbindArena::reset( void )
+{
+    for ( size_t idx = 0; idx < large.size(); idx ++ )
+    {
+        ::free( large[idx] );
+    }
+    large.clear();
+
+    current = 0;
+    offset  = 0;
+    used    = 0;
+
+    return;
+}
@@ -3,6 +3,7 @@
 // Copyright (C) 2013 Stephane Charette <stephanecharette@gmail.com>
 
 #include <stdexcept>
+#include <utility>
 #include <SNMPpp/Varlist.hpp>
 
 
@@ -13,23 +14,104 @@ SNMPpp::Varlist::~Varlist( void )
 
 
 SNMPpp::Varlist::Varlist( void ) :
-    varlist( NULL )
+    varlist( NULL ),
+    tail( NULL ),
+    arena( NULL )
 {
     return;
 }
 
 
 SNMPpp::Varlist::Varlist( netsnmp_variable_list *vl ) :
-    varlist( vl )
+    varlist( vl ),
+    tail( NULL ),
+    arena( NULL )
 {
     return;
 }
 
 
+SNMPpp::Varlist::Varlist( netsnmp_variable_list *vl, const std::shared_ptr< const SNMPpp::VarlistIndex > &idx ) :
+    varlist( vl ),
+    tail( NULL ),
+    index( idx ),
+    arena( NULL )
+{
+    return;
+}
+
+
+SNMPpp::Varlist::Varlist( netsnmp_variable_list *vl, netsnmp_variable_list *last ) :
+    varlist( vl ),
+    tail( vl == NULL ? NULL : last ),
+    arena( NULL )
+{
+    return;
+}
+
+
+SNMPpp::Varlist::Varlist( SNMPpp::VarbindArena &a ) :
+    varlist( NULL ),
+    tail( NULL ),
+    arena( &a )
+{
+    return;
+}
+
+
+SNMPpp::Varlist::Varlist( const SNMPpp::Varlist &rhs ) :
+    varlist( rhs.varlist ),
+    tail( rhs.tail ),
+    index( rhs.index ),
+    arena( rhs.arena )
+{
+    return;
+}
+
+
+SNMPpp::Varlist::Varlist( SNMPpp::Varlist &&rhs ) noexcept :
+    varlist( rhs.varlist ),
+    tail( rhs.tail ),
+    index( std::move( rhs.index ) ),
+    arena( rhs.arena )
+{
+    rhs.clear();
+
+    return;
+}
+
+
+SNMPpp::Varlist &SNMPpp::Varlist::operator=( const SNMPpp::Varlist &rhs )
+{
+    varlist = rhs.varlist;
+    tail    = rhs.tail;
+    index   = rhs.index;
+    arena   = rhs.arena;
+
+    return *this;
+}
+
+
+SNMPpp::Varlist &SNMPpp::Varlist::operator=( SNMPpp::Varlist &&rhs ) noexcept
+{
+    if ( &rhs != this )
+    {
+        varlist = rhs.varlist;
+        tail    = rhs.tail;
+        index   = std::move( rhs.index );
+        arena   = rhs.arena;
+        rhs.clear();
+    }
+
+    return *this;
+}
+
+
 // free up the underlying net-snmp structure: snmp_free_varbind()
 void SNMPpp::Varlist::free( void )
 {
-    if ( varlist != NULL )
+    // varbinds from an arena are released by the arena itself
+    if ( varlist != NULL && arena == NULL )
     {
         snmp_free_varbind( varlist );
     }
@@ -78,61 +160,71 @@ SNMPpp::MapOidVarList SNMPpp::Varlist::getMap( void ) const
 }
 
 
-bool SNMPpp::Varlist::contains( const SNMPpp::OID &o ) const
+const SNMPpp::Varlist &SNMPpp::Varlist::getMap( SNMPpp::UnorderedMapOidVarList &m ) const
 {
-    bool result = false;
+    m.clear();
+    m.reserve( size() );
 
-    for ( netsnmp_variable_list *p = varlist; p != NULL; p  = p->next_variable )
+    for ( netsnmp_variable_list *p = varlist; p != NULL; p = p->next_variable )
     {
-        if ( o == SNMPpp::OID(p) )
-        {
-            // found it!
-            result = true;
-            break;
-        }
+        m[ SNMPpp::OID(p) ] = p;
     }
 
-    return result;
+    return *this;
 }
 
 
-SNMPpp::Varlist &SNMPpp::Varlist::addBooleanVar( const SNMPpp::OID &o, bool value )
+bool SNMPpp::Varlist::contains( const SNMPpp::OIDView &o ) const
 {
-    if ( o.empty() )
-    {
-        /// @throw std::invalid_argument if the OID is empty.
-        throw std::invalid_argument( "Cannot add an empty OID." );
-    }
+    return lookup( o ) != NULL;
+}
 
-    netsnmp_variable_list *p = snmp_varlist_add_variable( &varlist, o, o, ASN_BOOLEAN, &value, sizeof(value) );
-    if ( p == NULL )
+
+SNMPpp::Varlist &SNMPpp::Varlist::buildIndex( void )
+{
+    std::shared_ptr< SNMPpp::VarlistIndex > idx( new SNMPpp::VarlistIndex );
+    idx->head = varlist;
+    idx->tail = NULL;
+    idx->map.reserve( size() );
+
+    for ( netsnmp_variable_list *p = varlist; p != NULL; p = p->next_variable )
     {
-        /// @throw std::runtime_error if net-snmp failed to add the OID.
-        throw std::runtime_error( "Failed to add " + o.to_str() + " to the variable list." );
+        // emplace() keeps the first varbind when an OID is duplicated
+        idx->map.emplace( SNMPpp::OIDView(p), p );
+        idx->tail = p;
     }
 
+    index = idx;
+
     return *this;
 }
 
-SNMPpp::Varlist &SNMPpp::Varlist::addIntegerVar( const SNMPpp::OID &o, int value )
+
+netsnmp_variable_list *SNMPpp::Varlist::lookup( const SNMPpp::OIDView &o ) const
 {
-    if ( o.empty() )
+    if ( hasIndex() )
     {
-        /// @throw std::invalid_argument if the OID is empty.
-        throw std::invalid_argument( "Cannot add an empty OID." );
+        // the index still covers every varbind, so a miss really is a miss
+        std::unordered_map< SNMPpp::OIDView, netsnmp_variable_list * >::const_iterator iter = index->map.find( o );
+
+        return iter == index->map.end() ? NULL : iter->second;
     }
 
-    netsnmp_variable_list *p = snmp_varlist_add_variable( &varlist, o, o, ASN_INTEGER, &value, sizeof(value) );
-    if ( p == NULL )
+    netsnmp_variable_list *p = NULL;
+    for ( p = varlist; p != NULL; p = p->next_variable )
     {
-        /// @throw std::runtime_error if net-snmp failed to add the OID.
-        throw std::runtime_error( "Failed to add " + o.to_str() + " to the variable list." );
+        if ( o == SNMPpp::OIDView(p) )
+        {
+            // found it!
+            break;
+        }
     }
 
-    return *this;
+    return p;
 }
 
-SNMPpp::Varlist &SNMPpp::Varlist::addInteger64Var( const SNMPpp::OID &o, long value )
+
+netsnmp_variable_list *SNMPpp::Varlist::addVariable( const SNMPpp::OIDView &o, const u_char type, const void *value, const size_t len )
 {
     if ( o.empty() )
     {
@@ -140,66 +232,99 @@ SNMPpp::Varlist &SNMPpp::Varlist::addInteger64Var( const SNMPpp::OID &o, long va
         throw std::invalid_argument( "Cannot add an empty OID." );
     }
 
-    netsnmp_variable_list *p = snmp_varlist_add_variable( &varlist, o, o, ASN_INTEGER64, &value, sizeof(value) );
+    dropIndex();
+
+    netsnmp_variable_list *last = back();
+    netsnmp_variable_list *p = NULL;
+    if ( arena != NULL )
+    {
+        /// @see SNMPpp::VarbindArena::create() for the exceptions this may throw.
+        p = arena->create( o, type, value, len );
+        if ( last == NULL )
+        {
+            varlist = p;
+        }
+        else
+        {
+            last->next_variable = p;
+        }
+    }
+    else
+    {
+        // When net-snmp is given the address of the last varbind instead of
+        // the first one, it doesn't need to walk the entire list to find the end.
+        p = snmp_varlist_add_variable( last == NULL ? &varlist : &last, o.data(), o.size(), type, value, len );
+    }
     if ( p == NULL )
     {
         /// @throw std::runtime_error if net-snmp failed to add the OID.
         throw std::runtime_error( "Failed to add " + o.to_str() + " to the variable list." );
     }
+    tail = p;
 
-    return *this;
+    return p;
 }
 
-SNMPpp::Varlist &SNMPpp::Varlist::addGaugeVar( const SNMPpp::OID &o, unsigned int value )
+
+netsnmp_variable_list *SNMPpp::Varlist::back( void ) const
 {
-    if ( o.empty() )
+    /**
+     * @details Runs in O(1) when the varlist has only been appended to
+     * through this object, since the last varbind is remembered.  Otherwise
+     * the linked list is walked from the last known position.
+     */
+    netsnmp_variable_list *p = ( tail != NULL ? tail : varlist );
+    if ( p != NULL )
     {
-        /// @throw std::invalid_argument if the OID is empty.
-        throw std::invalid_argument( "Cannot add an empty OID." );
+        while ( p->next_variable != NULL )
+        {
+            p = p->next_variable;
+        }
     }
+    tail = p;
+
+    return p;
+}
 
-    netsnmp_variable_list *p = snmp_varlist_add_variable( &varlist, o, o, ASN_GAUGE, &value, sizeof(value) );
-    if ( p == NULL )
-    {
-        /// @throw std::runtime_error if net-snmp failed to add the OID.
-        throw std::runtime_error( "Failed to add " + o.to_str() + " to the variable list." );
-    }
+
+SNMPpp::Varlist &SNMPpp::Varlist::addBooleanVar( const SNMPpp::OID &o, bool value )
+{
+    addVariable( o.view(), ASN_BOOLEAN, &value, sizeof(value) );
 
     return *this;
 }
 
-SNMPpp::Varlist &SNMPpp::Varlist::addOctetStringVar( const SNMPpp::OID &o, unsigned char * value, long unsigned int size )
+SNMPpp::Varlist &SNMPpp::Varlist::addIntegerVar( const SNMPpp::OID &o, int value )
 {
-    if ( o.empty() )
-    {
-        /// @throw std::invalid_argument if the OID is empty.
-        throw std::invalid_argument( "Cannot add an empty OID." );
-    }
+    addVariable( o.view(), ASN_INTEGER, &value, sizeof(value) );
 
-    netsnmp_variable_list *p = snmp_varlist_add_variable( &varlist, o, o, ASN_OCTET_STR, value, size );
-    if ( p == NULL )
-    {
-        /// @throw std::runtime_error if net-snmp failed to add the OID.
-        throw std::runtime_error( "Failed to add " + o.to_str() + " to the variable list." );
-    }
+    return *this;
+}
+
+SNMPpp::Varlist &SNMPpp::Varlist::addInteger64Var( const SNMPpp::OID &o, long value )
+{
+    addVariable( o.view(), ASN_INTEGER64, &value, sizeof(value) );
 
     return *this;
 }
 
-SNMPpp::Varlist &SNMPpp::Varlist::addNullVar( const SNMPpp::OID &o )
+SNMPpp::Varlist &SNMPpp::Varlist::addGaugeVar( const SNMPpp::OID &o, unsigned int value )
 {
-    if ( o.empty() )
-    {
-        /// @throw std::invalid_argument if the OID is empty.
-        throw std::invalid_argument( "Cannot add an empty OID." );
-    }
+    addVariable( o.view(), ASN_GAUGE, &value, sizeof(value) );
 
-    netsnmp_variable_list *p = snmp_varlist_add_variable( &varlist, o, o, ASN_NULL, 0, 0 );
-    if ( p == NULL )
-    {
-        /// @throw std::runtime_error if net-snmp failed to add the OID.
-        throw std::runtime_error( "Failed to add " + o.to_str() + " to the variable list." );
-    }
+    return *this;
+}
+
+SNMPpp::Varlist &SNMPpp::Varlist::addOctetStringVar( const SNMPpp::OID &o, unsigned char * value, long unsigned int size )
+{
+    addVariable( o.view(), ASN_OCTET_STR, value, size );
+
+    return *this;
+}
+
+SNMPpp::Varlist &SNMPpp::Varlist::addNullVar( const SNMPpp::OID &o )
+{
+    addVariable( o.view(), ASN_NULL, 0, 0 );
 
     return *this;
 }
@@ -230,22 +355,34 @@ SNMPpp::Varlist &SNMPpp::Varlist::addNullVars( const SNMPpp::VecOID &v )
 }
 
 
-const netsnmp_variable_list *SNMPpp::Varlist::at( const SNMPpp::OID &o ) const
+SNMPpp::Varlist &SNMPpp::Varlist::addVarbind( const SNMPpp::Varbind &vb )
 {
-    netsnmp_variable_list *p = NULL;
-    for ( p = varlist; p != NULL; p = p->next_variable )
+    addVariable( vb.name(), vb.asnType(), vb.value().string, vb.valueLength() );
+
+    return *this;
+}
+
+
+SNMPpp::Varlist &SNMPpp::Varlist::addVarbinds( SNMPpp::Varlist::const_iterator first, const SNMPpp::Varlist::const_iterator &last )
+{
+    while ( first != last )
     {
-        if ( o == SNMPpp::OID(p) )
-        {
-            // found it!
-            break;
-        }
+        addVarbind( *first );
+        ++ first;
     }
 
+    return *this;
+}
+
+
+const netsnmp_variable_list *SNMPpp::Varlist::at( const SNMPpp::OIDView &o ) const
+{
+    const netsnmp_variable_list *p = lookup( o );
+
     if ( p == NULL )
     {
         /// @throw std::invalid_argument if the varlist does not contain the requested OID.
-        throw std::invalid_argument( "Varlist does not contain OID " + o.to_str() + "." );
+        throw std::invalid_argument( "Varlist does not contain OID " + SNMPpp::OID(o).to_str() + "." );
     }
 
     return p;
@@ -285,114 +422,84 @@ SNMPpp::OID SNMPpp::Varlist::firstOID( void ) const
 
 bool SNMPpp::Varlist::getBool( const SNMPpp::OID &o ) const
 {
-    const netsnmp_variable_list *vl = at( o );
-
-    if ( vl->type != ASN_BOOLEAN )
-    {
-        /// @throw std::invalid_argument if the requested OID is not `ASN_BOOLEAN`.
-        throw std::invalid_argument( "OID " + o.to_str() + " is not a boolean type." );
-    }
-
-    return *vl->val.integer == 1; // rfc1212, true=1, false=2
+    /// @see SNMPpp::Varbind::getBool() for the exceptions this may throw.
+    return SNMPpp::Varbind( at( o ) ).getBool();
 }
 
 
 long SNMPpp::Varlist::getLong( const SNMPpp::OID &o ) const
 {
-    const netsnmp_variable_list *vl = at( o );
-
-    if ( vl->type != ASN_INTEGER )
-    {
-        /// @throw std::invalid_argument if the requested OID is not `ASN_INTEGER`.
-        throw std::invalid_argument( "OID " + o.to_str() + " is not a numeric type." );
-    }
-
-    return *vl->val.integer;
+    /// @see SNMPpp::Varbind::getLong() for the exceptions this may throw.
+    return SNMPpp::Varbind( at( o ) ).getLong();
 }
 
 
 std::string SNMPpp::Varlist::getString( const SNMPpp::OID &o ) const
 {
-    const netsnmp_variable_list *vl = at( o );
-
-    if ( vl->type != ASN_OCTET_STR )
-    {
-        /// @throw std::invalid_argument if the requested OID is not `ASN_OCTET_STR`.
-        throw std::invalid_argument( "OID " + o.to_str() + " is not a string." );
-    }
-
-    return std::string( (const char *)vl->val.string, vl->val_len );
+    /// @see SNMPpp::Varbind::getString() for the exceptions this may throw.
+    return SNMPpp::Varbind( at( o ) ).getString();
 }
 
 
 SNMPpp::OID SNMPpp::Varlist::getOID( const SNMPpp::OID &o ) const
 {
-    const netsnmp_variable_list *vl = at( o );
+    /// @see SNMPpp::Varbind::getOID() for the exceptions this may throw.
+    return SNMPpp::Varbind( at( o ) ).getOID();
+}
 
-    if ( vl->type != ASN_OBJECT_ID )
-    {
-        /// @throw std::invalid_argument if the requested OID is not `ASN_OBJECT_ID`.
-        throw std::invalid_argument( "OID " + o.to_str() + " is not a OID." );
-    }
 
-    return SNMPpp::OID( vl->val.objid, vl->val_len/sizeof(unsigned long) );
+unsigned long SNMPpp::Varlist::getUnsigned( const SNMPpp::OID &o ) const
+{
+    /// @see SNMPpp::Varbind::getUnsigned() for the exceptions this may throw.
+    return SNMPpp::Varbind( at( o ) ).getUnsigned();
 }
 
 
-std::string SNMPpp::Varlist::asString( const SNMPpp::OID &o ) const
+uint64_t SNMPpp::Varlist::getCounter64( const SNMPpp::OID &o ) const
 {
-    const netsnmp_variable_list *vl = at( o );
+    /// @see SNMPpp::Varbind::getCounter64() for the exceptions this may throw.
+    return SNMPpp::Varbind( at( o ) ).getCounter64();
+}
 
-    u_char *buf = NULL;
-    size_t buf_len = 0;
-    size_t out_len = 0;
-    sprint_realloc_value( &buf, &buf_len, &out_len, 1, o, o, vl );
 
-    // The buffer should look something like one of these examples:
-    //
-    //      OID: iso.3.6.1.6.3.16.2.2.1
-    //      STRING: "The SNMP Management Architecture MIB."
-    //
-    // We need to extract the two parts -- the type followed by the value.
+double SNMPpp::Varlist::getDouble( const SNMPpp::OID &o ) const
+{
+    /// @see SNMPpp::Varbind::getDouble() for the exceptions this may throw.
+    return SNMPpp::Varbind( at( o ) ).getDouble();
+}
 
-    std::string asn( (char*) buf );
-    std::string txt( (char*) buf );
 
-    ::free( buf );
+SNMPpp::Value SNMPpp::Varlist::getValue( const SNMPpp::OID &o ) const
+{
+    return SNMPpp::Varbind( at( o ) ).getValue();
+}
 
-    size_t pos = asn.find( ": " );
-    if ( pos != std::string::npos )
-    {
-        asn.erase( pos, std::string::npos );
-        txt.erase( 0, pos + 2 );
-
-        // strings start and end with double quotes -- get rid of those double quotes
-        const size_t len = txt.size();
-        if (    asn         == "STRING" &&
-                len         >= 2        &&
-                txt[0]      == '\"'     &&
-                txt[len-1]  == '\"'     )
-        {
-            txt.erase( len - 1 );   // erase trailing double quote
-            txt.erase( 0, 1 );      // erase leading double quote
-        }
-    }
 
-    return txt;
+std::string SNMPpp::Varlist::asString( const SNMPpp::OID &o ) const
+{
+    return SNMPpp::Varbind( at( o ) ).asString();
 }
 
 
 std::ostream &operator<<( std::ostream &os, const SNMPpp::Varlist &varlist )
 {
-    SNMPpp::VecOID v;
-    varlist.getOids( v );
-
-    os << "Number of OIDs in the variable list: " << v.size() << std::endl;
+    os << "Number of OIDs in the variable list: " << varlist.size() << std::endl;
 
     // list all of the OIDs in the varlist
-    for ( size_t idx = 0; idx < v.size(); idx ++ )
+    char buffer[256];
+    for ( const SNMPpp::Varbind &vb : varlist )
     {
-        os << "\t" << v[idx] << ": ASN type=" << varlist.asnType( v[idx] ) << ", txt=" << varlist.asString( v[idx] ) << std::endl;
+        os << "\t" << vb.name() << ": ASN type=" << vb.asnType() << ", txt=";
+        const size_t len = vb.format( buffer, sizeof(buffer) );
+        if ( len <= sizeof(buffer) )
+        {
+            os.write( buffer, len );
+        }
+        else
+        {
+            os << vb.asString();
+        }
+        os << std::endl;
     }
 
     return os;
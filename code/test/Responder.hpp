@@ -0,0 +1,119 @@
+// SNMPpp: https://sourceforge.net/p/snmppp/
+// SNMPpp project uses the MIT license. See LICENSE for details.
+// Copyright (C) 2013 Stephane Charette <stephanecharette@gmail.com>
+
+#pragma once
+
+#include <assert.h>
+#include <netinet/in.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+#include <SNMPpp/net-snmppp.hpp>
+
+
+/** Agent on a loopback port which answers every request with the request
+ * itself, so the benchmark measures the transport and not the agent.
+ */
+class Responder
+{
+	public:
+
+		Responder( void ) :
+			done( false )
+		{
+			fd = socket( AF_INET, SOCK_DGRAM, 0 );
+			struct sockaddr_in address;
+			memset( &address, 0, sizeof(address) );
+			address.sin_family		= AF_INET;
+			address.sin_addr.s_addr	= htonl( INADDR_LOOPBACK );
+			address.sin_port		= 0;
+			int rc = bind( fd, reinterpret_cast< struct sockaddr * >( &address ), sizeof(address) );
+			assert( rc == 0 );
+			socklen_t length = sizeof(address);
+			getsockname( fd, reinterpret_cast< struct sockaddr * >( &address ), &length );
+			port = ntohs( address.sin_port );
+
+			// wake up regularly to notice when to stop, and keep up with bursts
+			struct timeval tv = { 0, 100000 };
+			setsockopt( fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv) );
+			const int size = 4 * 1024 * 1024;
+			setsockopt( fd, SOL_SOCKET, SO_RCVBUF, &size, sizeof(size) );
+
+			thread = std::thread( &Responder::serve, this );
+		}
+
+		~Responder( void )
+		{
+			done = true;
+			thread.join();
+			close( fd );
+		}
+
+		std::string server( void ) const
+		{
+			return "udp:127.0.0.1:" + std::to_string( port );
+		}
+
+	protected:
+
+		void serve( void )
+		{
+			netsnmp_session session;
+			snmp_sess_init( &session );
+			std::vector< u_char > datagram( 65536 );
+			size_t size = 65536;
+			u_char *buffer = static_cast< u_char * >( malloc( size ) );
+
+			while ( ! done )
+			{
+				struct sockaddr_storage from;
+				socklen_t fromLength = sizeof(from);
+				const ssize_t length = recvfrom( fd, datagram.data(), datagram.size(), 0, reinterpret_cast< struct sockaddr * >( &from ), &fromLength );
+				if ( length <= 0 )
+				{
+					continue;
+				}
+
+				netsnmp_pdu *pdu = static_cast< netsnmp_pdu * >( calloc( 1, sizeof(netsnmp_pdu) ) );
+				if ( snmp_parse( NULL, &session, pdu, datagram.data(), length ) == 0 )
+				{
+					pdu->command	= SNMP_MSG_RESPONSE;
+					pdu->errstat	= 0;
+					pdu->errindex	= 0;
+
+					size_t offset = 0;
+					size_t packetLength = size;
+					const u_char *packet = buffer;
+#ifdef NETSNMP_USE_REVERSE_ASNENCODING
+					if ( netsnmp_ds_get_boolean( NETSNMP_DS_LIBRARY_ID, NETSNMP_DS_LIB_REVERSE_ENCODE ) )
+					{
+						snmp_build( &buffer, &size, &offset, &session, pdu );
+						packet			= buffer + size - offset;
+						packetLength	= offset;
+					}
+					else
+#endif
+					{
+						snmp_build( &buffer, &packetLength, &offset, &session, pdu );
+						packet = buffer;
+					}
+					sendto( fd, packet, packetLength, 0, reinterpret_cast< struct sockaddr * >( &from ), fromLength );
+				}
+				snmp_free_pdu( pdu );
+			}
+
+			::free( buffer );
+		}
+
+		int fd;
+		int port;
+		std::atomic< bool > done;
+		std::thread thread;
+};
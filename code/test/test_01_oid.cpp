@@ -6,6 +6,7 @@
 #include <stdlib.h>
 #include <iostream>
 #include <iomanip>
+#include <stdexcept>
 #include <SNMPpp/OID.hpp>
 
 
@@ -21,9 +22,9 @@ void checkConstructor( const std::string &name, const SNMPpp::OID &oid1, const S
 	}
 	assert( oid1.size()			== oid2.size() );
 	assert( oid1.empty()			== oid2.empty() );
-	assert( oid1.str()			== oid2.str() );
-	assert( oid1.str()			== oid2.operator std::string() );
-	assert( oid1.str().empty()	== oid2.str().empty() );
+	assert( oid1.to_str()			== oid2.to_str() );
+	assert( oid1.to_str()			== oid2.operator std::string() );
+	assert( oid1.to_str().empty()	== oid2.to_str().empty() );
 	assert( (bool)oid1			== (bool)oid2 );
 	assert( (bool)oid1			== oid2.operator bool() );
 	assert( oid1					== oid2 );
@@ -188,6 +189,149 @@ void checkBasicFunctionality( void )
 	assert( oid3.isImmediateChildOf(  oid1 ) == false );
 	assert( oid1.isImmediateParentOf( oid3 ) == false );
 
+	// text does not need to be NUL-terminated
+	const char *txt = "1.2.3.4.5.6.7 = INTEGER: 1";
+	SNMPpp::OID oid4( txt, 9 );
+	std::cout << "\toid4: " << oid4 << std::endl;
+	assert( oid4 == oid1 );
+	oid4.append( txt + 9, 4 );
+	assert( oid4 == oid3 );
+
+	// numeric values larger than 32 bits are rejected rather than truncated
+	std::cout << "\tverifying overflow is detected" << std::endl;
+	assert( SNMPpp::OID( ".1.4294967295" ).size() == 2 );
+	bool caught = false;
+	try
+	{
+		oid4 += ".4294967296.1";
+	}
+	catch ( const std::invalid_argument &e )
+	{
+		caught = true;
+	}
+	assert( caught );
+	assert( oid4 == oid3 );
+
+	return;
+}
+
+
+void checkView( void )
+{
+	std::cout << "Checking OID views:" << std::endl;
+
+	const SNMPpp::OID oid1( ".1.3.6.1.2.1.1" );
+	const SNMPpp::OID oid2( ".1.3.6.1.2.1.1.3.0" );
+	const SNMPpp::OID oid3( ".1.3.6.1.2.1.2" );
+
+	netsnmp_variable_list *vl = NULL;
+	snmp_varlist_add_variable( &vl, oid2, oid2.size(), ASN_NULL, 0, 0 );
+
+	const SNMPpp::OIDView view1 = oid1.view();
+	const SNMPpp::OIDView view2( vl );
+	std::cout << "\tcomparing view of " << oid2 << " and view of varbind " << SNMPpp::OID(view2) << std::endl;
+	assert( view2.size()	== oid2.size() );
+	assert( view2.data()	== vl->name );
+	assert( view2			== oid2.view() );
+	assert( view2			!= view1 );
+	assert( view1			<  view2 );
+	assert( view2			<  oid3.view() );
+	assert( ( view1 < view2 ) == ( oid1 < oid2 ) );
+	assert( view2.isChildOf( view1 ) );
+	assert( view1.isParentOf( view2 ) );
+	assert( view1.isChildOf( view2 ) == false );
+	assert( view2.hash()	== oid2.view().hash() );
+	assert( view1.hash()	!= view2.hash() );
+	assert( SNMPpp::OID( view2 ) == oid2 );
+	assert( SNMPpp::OIDView().empty() );
+	assert( SNMPpp::OIDView( (const netsnmp_variable_list *)NULL ).empty() );
+
+	snmp_free_varbind( vl );
+
+	return;
+}
+
+
+void checkFormat( void )
+{
+	std::cout << "Checking OID formatting:" << std::endl;
+
+	const SNMPpp::OID o( ".1.3.6.1.4.1.4294967295.0.99.100" );
+	const std::string txt = ".1.3.6.1.4.1.4294967295.0.99.100";
+
+	char buffer[50];
+	size_t len = o.format( buffer, sizeof(buffer) );
+	std::cout << "\tformatted " << txt << " into " << std::string( buffer, len ) << std::endl;
+	assert( len == txt.size() );
+	assert( std::string( buffer, len ) == txt );
+	assert( o.to_str() == txt );
+
+	// a buffer which is too small returns the length it would have needed
+	len = o.format( buffer, 10 );
+	assert( len == txt.size() );
+	assert( std::string( buffer, 10 ) == txt.substr( 0, 10 ) );
+
+	std::string s = "OID=";
+	o.appendTo( s );
+	assert( s == "OID=" + txt );
+
+	assert( SNMPpp::OID().format( buffer, sizeof(buffer) ) == 0 );
+
+	return;
+}
+
+
+void checkLiterals( void )
+{
+	std::cout << "Checking compile-time OIDs:" << std::endl;
+
+	// the common locations must not have changed now that they are no longer parsed
+	assert( SNMPpp::OID( SNMPpp::OID::kInternet				) == SNMPpp::OID( ".1.3.6.1"				) );
+	assert( SNMPpp::OID( SNMPpp::OID::kPrivateEnterprise	) == SNMPpp::OID( ".1.3.6.1.4"				) );
+	assert( SNMPpp::OID( SNMPpp::OID::kSysUpTime			) == SNMPpp::OID( ".1.3.6.1.2.1.1.3.0"		) );
+	assert( SNMPpp::OID( SNMPpp::OID::kTrap					) == SNMPpp::OID( ".1.3.6.1.6.3.1.1.4.1.0"	) );
+	assert( SNMPpp::OID( SNMPpp::OID::kInvalid				).empty() );
+	assert( SNMPpp::OID( SNMPpp::OID::kEmpty				).empty() );
+
+	// the view returned for common locations is always the same static memory
+	assert( SNMPpp::OID::common( SNMPpp::OID::kSysUpTime ).data() == SNMPpp::SysUpTimeOID::value );
+	assert( SNMPpp::OID::common( SNMPpp::OID::kSysUpTime ).data() == SNMPpp::OID::common( SNMPpp::OID::kSysUpTime ).data() );
+	assert( SNMPpp::OID::common( SNMPpp::OID::kEmpty ).empty() );
+
+	typedef SNMPpp::OIDLiteral< 1, 3, 6, 1, 2, 1, 2, 2, 1, 10 > IfInOctets;
+	static_assert( IfInOctets::length == 10, "unexpected OIDLiteral length" );
+	static_assert( IfInOctets::value[9] == 10, "unexpected OIDLiteral value" );
+	const SNMPpp::OID o( IfInOctets::value );
+	assert( o == SNMPpp::OID( ".1.3.6.1.2.1.2.2.1.10" ) );
+	assert( o.view() == IfInOctets::view() );
+	assert( ( o + oid( 12 ) ).view().isChildOf( IfInOctets::view() ) );
+	assert( IfInOctets::view().isChildOf( SNMPpp::Mib2OID::view() ) );
+	assert( SNMPpp::OID( SNMPpp::EnterprisesOID::value ).isImmediateChildOf( SNMPpp::OID( SNMPpp::PrivateEnterpriseOID::value ) ) );
+
+	return;
+}
+
+
+void checkSmallVector( void )
+{
+	std::cout << "Checking the storage behind OIDs:" << std::endl;
+
+	// appending one of its own elements while it grows, first out of the inline buffer, then on the heap
+	SNMPpp::SmallVector< oid, 4 > v;
+	for ( oid idx = 1; idx <= 4; idx ++ )
+	{
+		v.push_back( idx );
+	}
+	v.push_back( v[0] );
+	for ( oid idx = 6; idx <= 8; idx ++ )
+	{
+		v.push_back( idx );
+	}
+	v.push_back( v[1] );
+	assert( v.size() == 9 );
+	assert( v[4] == 1 );
+	assert( v[8] == 2 );
+
 	return;
 }
 
@@ -199,6 +343,10 @@ int main( int argc, char *argv[] )
 	checkConstructor();
 	checkConstness();
 	checkBasicFunctionality();
+	checkView();
+	checkFormat();
+	checkLiterals();
+	checkSmallVector();
 
 	std::cout << "\t...done!" << std::endl;
 
@@ -38,6 +38,84 @@ void checkSession( const std::string &server, const bool expectThrow = false )
 }
 
 
+void checkLimits( void )
+{
+	std::cout << "Learning the limits of an agent." << std::endl;
+
+	// nothing known yet, so the requested values are used as-is
+	SNMPpp::SessionLimits limits;
+	assert( limits.messageSize( 1472 ) == 1472 );
+	assert( limits.messageSize( 0 ) == 0 );
+	assert( limits.repetitions( 50 ) == 50 );
+
+	// pretend an agent can only answer 1000 bytes and 37 repetitions
+	size_t attempts = 0;
+	size_t size = 0;
+	while ( attempts < 20 )
+	{
+		size = limits.messageSize( 1472 );
+		assert( size > 0 && size <= 1472 );
+		attempts ++;
+		if ( size <= 1000 && size == limits.goodMessageSize )
+		{
+			break;
+		}
+		limits.learnMessageSize( size, size > 1000 );
+	}
+	std::cout << "\tsettled on " << size << " bytes after " << attempts << " attempts" << std::endl;
+	assert( attempts < 20 );
+	assert( size <= 1000 && size > 1000 - 1000 / 32 - 1 );
+
+	int repetitions = 0;
+	for ( attempts = 0; attempts < 20; attempts ++ )
+	{
+		repetitions = limits.repetitions( 50 );
+		if ( repetitions <= 37 && repetitions == limits.goodRepetitions )
+		{
+			break;
+		}
+		limits.learnRepetitions( repetitions, repetitions > 37 );
+	}
+	assert( repetitions == 37 );
+
+	// never more than what the caller asks for
+	assert( limits.messageSize( 484 ) == 484 );
+	assert( limits.repetitions( 10 ) == 10 );
+
+	// the limit is in varbinds, so it scales with the width of the rows
+	SNMPpp::SessionLimits bulk;
+	bulk.learnRepetitions( 20, true, 10 );
+	bulk.learnRepetitions( 19, false, 10 );
+	assert( bulk.repetitions( 50, 10 ) == 19 );
+	assert( bulk.repetitions( 500, 1 ) >= 190 && bulk.repetitions( 500, 1 ) < 200 );
+	assert( bulk.repetitions( 50, 1000 ) == 1 );
+
+	// an agent which starts accepting more is no longer limited
+	limits.learnMessageSize( 1472, false );
+	assert( limits.tooBigMessageSize == 0 );
+	assert( limits.messageSize( 1472 ) == 1472 );
+
+	// limits are remembered for each session until it is closed
+	SNMPpp::SessionHandle sessionHandle = NULL;
+	SNMPpp::openSession( sessionHandle, "udp:127.0.0.1:161" );
+	assert( SNMPpp::getSessionLimits( sessionHandle ).goodRepetitions == 0 );
+	SNMPpp::setSessionLimits( sessionHandle, limits );
+	assert( SNMPpp::getSessionLimits( sessionHandle ).goodRepetitions == 37 );
+	SNMPpp::SessionHandle copy = sessionHandle;
+	SNMPpp::closeSession( sessionHandle );
+	assert( SNMPpp::getSessionLimits( copy ).goodRepetitions == 0 );
+
+	// a new session never inherits the limits of an old one at the same address
+	SNMPpp::setSessionLimits( copy, limits );
+	SNMPpp::openSession( sessionHandle, "udp:127.0.0.1:161" );
+	assert( SNMPpp::getSessionLimits( copy ).goodRepetitions == ( copy == sessionHandle ? 0 : 37 ) );
+	assert( SNMPpp::getSessionLimits( sessionHandle ).goodRepetitions == 0 );
+	SNMPpp::closeSession( sessionHandle );
+
+	return;
+}
+
+
 int main( int argc, char *argv[] )
 {
 	std::cout << "Test the session handle." << std::endl;
@@ -56,5 +134,7 @@ int main( int argc, char *argv[] )
 
 	checkSession( "udp6:[::1]:161" );	// loopback IPv6 address
 
+	checkLimits();
+
 	return 0;
 }
@@ -154,6 +154,86 @@ void testGetBulk( SNMPpp::SessionHandle &sessionHandle )
 }
 
 
+void testSplitting( SNMPpp::SessionHandle &sessionHandle )
+{
+	std::cout << "Test GET with more OIDs than fit in a single message:" << std::endl;
+
+	// .1.3.6.1.2.1.1.1.0 is encoded as 30 0C 06 08 2B 06 01 02 01 01 01 00 05 00
+	assert( SNMPpp::estimateVarbindSize( SNMPpp::OID( ".1.3.6.1.2.1.1.1.0" ).view() ) == 14 );
+	assert( SNMPpp::estimateVarbindSize( SNMPpp::OID( ".1.3.6.1.2.1.1.1.200" ).view() ) == 15 );
+
+	// the system group, followed by ifDescr for many interfaces
+	SNMPpp::VecOID oids;
+	for ( oid idx = 1; idx <= 8; idx ++ )
+	{
+		oids.push_back( SNMPpp::OID( ".1.3.6.1.2.1.1" ) + idx + oid( 0 ) );
+	}
+	for ( oid ifIndex = 1; ifIndex <= 292; ifIndex ++ )
+	{
+		oids.push_back( SNMPpp::OID( ".1.3.6.1.2.1.2.2.1.2" ) + ifIndex );
+	}
+
+	const std::vector< SNMPpp::VecOID > groups = SNMPpp::splitOids( oids, 484 );
+	assert( groups.size() > 1 );
+	SNMPpp::VecOID joined;
+	for ( size_t idx = 0; idx < groups.size(); idx ++ )
+	{
+		size_t len = 0;
+		for ( size_t n = 0; n < groups[idx].size(); n ++ )
+		{
+			len += SNMPpp::estimateVarbindSize( groups[idx][n].view(), 32 );
+		}
+		assert( len + SNMPpp::kMessageOverhead <= 484 );
+		joined.insert( joined.end(), groups[idx].begin(), groups[idx].end() );
+	}
+	assert( joined == oids );
+
+	// split up front, or only once the agent says the response is too big
+	const size_t sizes[] = { 484, SNMPpp::kDefaultMaxMessageSize, SNMPpp::kSessionMaxMessageSize, 0 };
+	for ( size_t idx = 0; idx < sizeof(sizes) / sizeof(sizes[0]); idx ++ )
+	{
+		SNMPpp::UniquePDU pdu( SNMPpp::get( sessionHandle, oids, sizes[idx] ) );
+		assert( pdu.size() == oids.size() );
+		SNMPpp::VecOID v;
+		pdu.varlist().getOids( v );
+		assert( v == oids );
+		assert( pdu.varlist().asnType( oids[0] ) == ASN_OCTET_STR );
+	}
+
+	// net-snmp's defaults allow far more than an Ethernet frame
+	assert( SNMPpp::sessionMaxMessageSize( sessionHandle ) > SNMPpp::kDefaultMaxMessageSize );
+
+	// the session remembers what the agent was able to answer
+	assert( SNMPpp::getSessionLimits( sessionHandle ).goodMessageSize > 0 );
+
+	return;
+}
+
+
+void testLimits( SNMPpp::SessionHandle &sessionHandle )
+{
+	std::cout << "Test GETBULK with more repetitions than the agent can answer:" << std::endl;
+
+	for ( size_t attempt = 0; attempt < 3; attempt ++ )
+	{
+		SNMPpp::UniquePDU pdu( SNMPpp::getBulk( sessionHandle, SNMPpp::OID( ".1.3.6.1.2.1.2.2.1.2" ), 200 ) );
+		assert( pdu.size() > 0 );
+
+		const SNMPpp::SessionLimits limits = SNMPpp::getSessionLimits( sessionHandle );
+		std::cout << "\tattempt #" << attempt << ": " << pdu.size() << " varbinds, good=" << limits.goodRepetitions << ", bad=" << limits.tooBigRepetitions << std::endl;
+		assert( limits.goodRepetitions > 0 );
+		assert( limits.goodRepetitions <= 200 );
+		assert( limits.tooBigRepetitions == 0 || limits.tooBigRepetitions > limits.goodRepetitions );
+	}
+
+	// a smaller request than what is known to work is sent as-is
+	SNMPpp::UniquePDU pdu( SNMPpp::getBulk( sessionHandle, SNMPpp::OID( ".1.3.6.1.2.1.2.2.1.2" ), 1 ) );
+	assert( pdu.size() == 1 );
+
+	return;
+}
+
+
 int main( int argc, char *argv[] )
 {
 	std::cout << "Test some of the net-snmp GET/GETNEXT/GETBULK functionality." << std::endl;
@@ -167,6 +247,8 @@ int main( int argc, char *argv[] )
 	testManyOidsAtOnce2	( sessionHandle );
 	testGetSingleOid		( sessionHandle );
 	testGetBulk			( sessionHandle );
+	testSplitting		( sessionHandle );
+	testLimits			( sessionHandle );
 	SNMPpp::closeSession	( sessionHandle );
 
 	assert( sessionHandle == NULL );
@@ -6,7 +6,11 @@
 #include <stdlib.h>
 #include <iostream>
 #include <iomanip>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
 #include <SNMPpp/Varlist.hpp>
+#include <SNMPpp/PDU.hpp>
 #include <SNMPpp/Trap.hpp>
 
 
@@ -46,6 +50,10 @@ void checkVarlist( const std::string &name, const SNMPpp::Varlist &varlist, cons
 		SNMPpp::MapOidVarList m = varlist.getMap();
 		assert( m.size() == 0 );
 		assert( m.empty() == true );
+
+		SNMPpp::UnorderedMapOidVarList u;
+		varlist.getMap( u );
+		assert( u.empty() == true );
 	}
 	else
 	{
@@ -71,6 +79,18 @@ void checkVarlist( const std::string &name, const SNMPpp::Varlist &varlist, cons
 		assert( m.empty() == false );
 		assert( m.size() == s.size() );
 
+		SNMPpp::UnorderedMapOidVarList u;
+		varlist.getMap( u );
+		assert( u.size() == m.size() );
+		for ( SNMPpp::MapOidVarList::const_iterator iter = m.begin(); iter != m.end(); iter ++ )
+		{
+			assert( u.at( iter->first ) == iter->second );
+		}
+
+		const SNMPpp::UnorderedSetOID hashed( s.begin(), s.end() );
+		assert( hashed.size() == s.size() );
+		assert( hashed.count( v[0] ) == 1 );
+
 		const SNMPpp::OID o1 = varlist.firstOID();
 		const SNMPpp::OID o2( p );
 		assert( o1.empty() == false );
@@ -92,6 +112,271 @@ void checkVarlist( const std::string &name, const SNMPpp::Varlist &varlist, cons
 }
 
 
+void checkIndex( void )
+{
+	std::cout << "\tverifying the varlist index" << std::endl;
+
+	SNMPpp::Varlist varlist;
+	for ( size_t idx = 1; idx <= 100; idx ++ )
+	{
+		varlist.addIntegerVar( SNMPpp::OID( ".1.3.6.1.2.1.2.2.1.8" ) + idx, idx );
+	}
+	varlist.addIntegerVar( ".1.3.6.1.2.1.2.2.1.8.50", 999 );
+	assert( varlist.hasIndex() == false );
+
+	varlist.buildIndex();
+	assert( varlist.hasIndex() );
+	assert( varlist.getIndex()->map.size() == 100 );
+	assert( varlist.getLong( SNMPpp::OID( ".1.3.6.1.2.1.2.2.1.8.7" ) ) == 7 );
+	assert( varlist.asnType( SNMPpp::OID( ".1.3.6.1.2.1.2.2.1.8.100" ) ) == ASN_INTEGER );
+	assert( varlist.contains( SNMPpp::OID( ".1.3.6.1.2.1.2.2.1.8.101" ) ) == false );
+
+	// duplicates resolve to the first varbind, same as without the index
+	assert( varlist.getLong( SNMPpp::OID( ".1.3.6.1.2.1.2.2.1.8.50" ) ) == 50 );
+
+	// copies share the index, and appending through a copy makes it stale for both
+	SNMPpp::Varlist copied( varlist );
+	assert( copied.hasIndex() );
+	assert( copied.getIndex() == varlist.getIndex() );
+	copied.addIntegerVar( ".1.3.6.1.2.1.2.2.1.8.101", 101 );
+	assert( copied.hasIndex() == false );
+	assert( varlist.hasIndex() == false );
+	assert( varlist.getLong( SNMPpp::OID( ".1.3.6.1.2.1.2.2.1.8.101" ) ) == 101 );
+
+	// a miss in an index which still matches is final: the list isn't walked
+	copied.buildIndex();
+	SNMPpp::Varlist extra;
+	extra.addIntegerVar( ".1.3.6.1.2.1.2.2.1.8.200", 200 );
+	netsnmp_variable_list *first = copied;
+	netsnmp_variable_list *inserted = extra;
+	inserted->next_variable = first->next_variable;
+	first->next_variable = inserted;
+	assert( copied.hasIndex() );
+	assert( copied.contains( SNMPpp::OID( ".1.3.6.1.2.1.2.2.1.8.200" ) ) == false );
+	copied.dropIndex();
+	assert( copied.contains( SNMPpp::OID( ".1.3.6.1.2.1.2.2.1.8.200" ) ) );
+	first->next_variable = inserted->next_variable;
+	inserted->next_variable = NULL;
+	extra.free();
+
+	// the PDU hands out its index with every varlist
+	SNMPpp::PDU pdu( SNMPpp::PDU::kResponse );
+	pdu.setVarlist( varlist );
+	assert( pdu.varlist().hasIndex() == false );
+	pdu.buildIndex();
+	assert( pdu.varlist().hasIndex() );
+	assert( pdu.contains( SNMPpp::OID( ".1.3.6.1.2.1.2.2.1.8.101" ) ) );
+	assert( pdu.varlist().getLong( SNMPpp::OID( ".1.3.6.1.2.1.2.2.1.8.42" ) ) == 42 );
+	SNMPpp::PDU copiedPdu( pdu );
+	assert( copiedPdu.varlist().hasIndex() );
+	pdu.addNullVar( ".1.3.6.1.2.1.2.2.1.8.102" );
+	assert( pdu.varlist().hasIndex() == false );
+	assert( pdu.contains( SNMPpp::OID( ".1.3.6.1.2.1.2.2.1.8.102" ) ) );
+
+	varlist.clear();
+	assert( varlist.hasIndex() == false );
+	pdu.free();
+	assert( copiedPdu.getType() == SNMPpp::PDU::kResponse );
+
+	return;
+}
+
+
+void checkIterator( void )
+{
+	std::cout << "\tverifying varlist iterators" << std::endl;
+
+	SNMPpp::Varlist varlist;
+	assert( varlist.begin() == varlist.end() );
+
+	varlist.addIntegerVar( ".1.3.6.1.2.1.2.2.1.8.1", 1 );
+	unsigned char descr[] = "eth0";
+	varlist.addOctetStringVar( ".1.3.6.1.2.1.2.2.1.2.1", descr, 4 );
+	varlist.addNullVar( ".1.3.6.1.2.1.2.2.1.10.1" );
+
+	SNMPpp::Varlist::const_iterator iter = varlist.begin();
+	assert( iter != varlist.end() );
+	assert( iter->name() == SNMPpp::OID( ".1.3.6.1.2.1.2.2.1.8.1" ).view() );
+	assert( iter->asnType() == ASN_INTEGER );
+	assert( iter->getLong() == 1 );
+	assert( (*iter).raw() == varlist.at( SNMPpp::OID( ".1.3.6.1.2.1.2.2.1.8.1" ) ) );
+	iter ++;
+	assert( iter->getString() == "eth0" );
+	assert( iter->valueLength() == 4 );
+	bool exceptionThrown = false;
+	try
+	{
+		iter->getLong();
+	}
+	catch ( const std::invalid_argument &e )
+	{
+		exceptionThrown = true;
+	}
+	assert( exceptionThrown );
+	++ iter;
+	assert( iter->asnType() == ASN_NULL );
+	++ iter;
+	assert( iter == varlist.end() );
+
+	// range-based for loops, and the same order as getOids()
+	SNMPpp::VecOID v;
+	varlist.getOids( v );
+	size_t idx = 0;
+	for ( const SNMPpp::Varbind &vb : varlist )
+	{
+		assert( vb.name() == v[idx].view() );
+		idx ++;
+	}
+	assert( idx == 3 );
+
+	// PDUs can be iterated as well, even when they are empty
+	SNMPpp::PDU pdu( SNMPpp::PDU::kResponse );
+	assert( pdu.begin() == pdu.end() );
+	pdu.setVarlist( varlist );
+	assert( std::distance( pdu.begin(), pdu.end() ) == 3 );
+	assert( pdu.begin()->getLong() == 1 );
+	SNMPpp::PDU nullPdu( (netsnmp_pdu *)NULL );
+	assert( nullPdu.begin() == nullPdu.end() );
+
+	pdu.free();
+
+	return;
+}
+
+
+void checkAppend( void )
+{
+	std::cout << "\tverifying appending to varlists" << std::endl;
+
+	SNMPpp::Varlist varlist;
+	assert( varlist.back() == NULL );
+	varlist.addNullVar( ".1.2.3.1" );
+	assert( varlist.back() == (netsnmp_variable_list *)varlist );
+	varlist.addNullVar( ".1.2.3.2" );
+	assert( SNMPpp::OIDView( varlist.back() ) == SNMPpp::OID( ".1.2.3.2" ).view() );
+
+	// appending through a copy, or directly through net-snmp, is still found
+	SNMPpp::Varlist copied( varlist );
+	copied.addNullVar( ".1.2.3.3" );
+	snmp_varlist_add_variable( copied, SNMPpp::OID( ".1.2.3.4" ), SNMPpp::OID( ".1.2.3.4" ).size(), ASN_NULL, 0, 0 );
+	varlist.addNullVar( ".1.2.3.5" );
+	assert( varlist.size() == 5 );
+	assert( SNMPpp::OIDView( varlist.back() ) == SNMPpp::OID( ".1.2.3.5" ).view() );
+	SNMPpp::VecOID v;
+	varlist.getOids( v );
+	for ( size_t idx = 0; idx < v.size(); idx ++ )
+	{
+		assert( v[idx] == SNMPpp::OID( ".1.2.3" ) + oid( idx + 1 ) );
+	}
+	varlist.free();
+
+	// same thing with a PDU, which remembers the end of its varlist between calls
+	SNMPpp::PDU pdu( SNMPpp::PDU::kGet );
+	for ( size_t idx = 1; idx <= 100; idx ++ )
+	{
+		pdu.addNullVar( SNMPpp::OID( ".1.2.3" ) + idx );
+	}
+	snmp_add_null_var( pdu, SNMPpp::OID( ".1.2.3.101" ), SNMPpp::OID( ".1.2.3.101" ).size() );
+	pdu.addNullVar( ".1.2.3.102" );
+	assert( pdu.size() == 102 );
+	assert( SNMPpp::OIDView( pdu.varlist().back() ) == SNMPpp::OID( ".1.2.3.102" ).view() );
+
+	// copies share the varbinds, and either one may replace them
+	SNMPpp::PDU copy( pdu );
+	copy.addNullVar( ".1.2.3.103" );
+	SNMPpp::Varlist replacement;
+	replacement.addNullVar( ".1.2.4.1" );
+	copy.setVarlist( replacement );
+	pdu.addNullVar( ".1.2.4.2" );
+	assert( pdu.size() == 2 );
+	SNMPpp::PDU assigned( SNMPpp::PDU::kGet );
+	assigned.free();
+	assigned = pdu;
+	replacement.clear();
+	replacement.addNullVar( ".1.2.5.1" );
+	pdu.setVarlist( replacement );
+	assigned.addNullVar( ".1.2.5.2" );
+	assert( copy.size() == 2 );
+	assert( SNMPpp::OIDView( copy.varlist().back() ) == SNMPpp::OID( ".1.2.5.2" ).view() );
+	pdu.free();
+
+	return;
+}
+
+
+void checkArena( void )
+{
+	std::cout << "\tverifying varlists allocated from an arena" << std::endl;
+
+	SNMPpp::VarbindArena arena;
+	SNMPpp::Varlist varlist( arena );
+	assert( varlist.getArena() == &arena );
+	varlist.addIntegerVar( ".1.2.3.1", -5 );
+	varlist.addGaugeVar( ".1.2.3.2", 4000000000U );
+	unsigned char text[] = "a string which is too long to fit in the buffer of a varbind";
+	varlist.addOctetStringVar( ".1.2.3.3", text, sizeof(text) - 1 );
+
+	// names longer than MAX_OID_LEN also come from the arena
+	SNMPpp::OID longOID( ".1.2.3.4" );
+	while ( longOID.size() <= MAX_OID_LEN )
+	{
+		longOID += oid( 7 );
+	}
+	varlist.addNullVar( longOID );
+
+	assert( varlist.size() == 4 );
+	assert( varlist.getLong( ".1.2.3.1" ) == -5 );
+	assert( varlist.getUnsigned( ".1.2.3.2" ) == 4000000000UL );
+	assert( varlist.getString( ".1.2.3.3" ) == std::string( (const char *)text ) );
+	assert( varlist.contains( longOID ) );
+	assert( arena.bytesUsed() > 4 * sizeof(netsnmp_variable_list) );
+
+	// copies made from a normal varlist are identical
+	SNMPpp::Varlist copied;
+	copied.addVarbinds( varlist.begin(), varlist.end() );
+	SNMPpp::Varlist::const_iterator lhs = varlist.begin();
+	for ( SNMPpp::Varlist::const_iterator rhs = copied.begin(); rhs != copied.end(); ++ rhs, ++ lhs )
+	{
+		assert( lhs->name() == rhs->name() );
+		assert( lhs->asString() == rhs->asString() );
+	}
+	assert( lhs == varlist.end() );
+
+	// and the other way around
+	SNMPpp::Varlist results( arena );
+	results.addVarbind( *copied.begin() );
+	assert( results.getLong() == -5 );
+	copied.free();
+
+	// net-snmp would free these varbinds, which it cannot do
+	SNMPpp::PDU pdu( SNMPpp::PDU::kSet );
+	bool exceptionThrown = false;
+	try
+	{
+		pdu.setVarlist( varlist );
+	}
+	catch ( const std::logic_error &e )
+	{
+		exceptionThrown = true;
+	}
+	assert( exceptionThrown );
+	pdu.free();
+
+	// free() only forgets the varbinds, and the arena can then be re-used
+	varlist.free();
+	results.free();
+	assert( varlist.empty() );
+	const size_t blocks = arena.blockCount();
+	arena.reset();
+	assert( arena.bytesUsed() == 0 );
+	varlist.addNullVar( ".1.2.3.5" );
+	assert( arena.blockCount() == blocks );
+	varlist.free();
+
+	return;
+}
+
+
 int main( int argc, char *argv[] )
 {
 	std::cout << "Testing Varlist:" << std::endl;
@@ -116,6 +401,35 @@ int main( int argc, char *argv[] )
 	varlist.addNullVar( "1.2.3.4.5.6.7" );
 	checkVarlist( "multiple OIDs", varlist, 7 );
 
+	// copies share the same net-snmp pointer, while moves hand it over
+	netsnmp_variable_list *p = varlist;
+	SNMPpp::Varlist copied( varlist );
+	assert( (netsnmp_variable_list *)copied == p );
+	assert( (netsnmp_variable_list *)varlist == p );
+	SNMPpp::Varlist moved( std::move( varlist ) );
+	assert( (netsnmp_variable_list *)moved == p );
+	assert( varlist.empty() );
+	checkVarlist( "moved varlist", moved, 7 );
+	varlist = std::move( moved );
+	assert( moved.empty() );
+	assert( (netsnmp_variable_list *)varlist == p );
+
+	SNMPpp::PDU pdu( SNMPpp::PDU::kGet );
+	pdu.addNullVar( "1.2.3.4" );
+	netsnmp_pdu *raw = pdu;
+	SNMPpp::PDU other( std::move( pdu ) );
+	assert( (netsnmp_pdu *)other == raw );
+	assert( (netsnmp_pdu *)pdu == NULL );
+	assert( other.getType() == SNMPpp::PDU::kGet );
+	assert( pdu.getType() == SNMPpp::PDU::kInvalid );
+	other.free();
+	varlist.free();
+
+	checkIndex();
+	checkIterator();
+	checkAppend();
+	checkArena();
+
 	std::cout << "\t...done!" << std::endl;
 
 	return 0;
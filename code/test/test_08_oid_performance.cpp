@@ -0,0 +1,688 @@
+// SNMPpp: https://sourceforge.net/p/snmppp/
+// SNMPpp project uses the MIT license. See LICENSE for details.
+// Copyright (C) 2013 Stephane Charette <stephanecharette@gmail.com>
+
+#include <assert.h>
+#include <stdlib.h>
+#include <ctype.h>
+#include <string.h>
+#include <time.h>
+#include <new>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <algorithm>
+#include <utility>
+#include <sstream>
+#include <SNMPpp/OID.hpp>
+#include <SNMPpp/Varlist.hpp>
+#include <SNMPpp/PDU.hpp>
+
+
+// count every heap allocation made by this process
+static size_t numberOfAllocations = 0;
+
+void *operator new( size_t size )
+{
+	numberOfAllocations ++;
+	void *p = malloc( size ? size : 1 );
+	if ( p == NULL )
+	{
+		throw std::bad_alloc();
+	}
+
+	return p;
+}
+
+
+void operator delete( void *p ) noexcept
+{
+	free( p );
+
+	return;
+}
+
+
+double secondsSince( const clock_t start )
+{
+	return double( clock() - start ) / CLOCKS_PER_SEC;
+}
+
+
+void report( const std::string &name, const size_t allocations, const size_t iterations, const clock_t start )
+{
+	std::cout	<< "\t" << std::left << std::setw(30) << name
+				<< ": " << std::fixed << std::setprecision(3) << double(allocations) / iterations << " allocations per OID"
+				<< ", " << secondsSince(start) << " seconds for " << iterations << " iterations"
+				<< std::endl;
+
+	return;
+}
+
+
+void checkAllocations( void )
+{
+	std::cout << "Checking the number of heap allocations per OID:" << std::endl;
+
+	const size_t iterations = 1000000;
+
+	// ifInOctets.12 and ifHCInOctets.12
+	const oid ifInOctets[]		= { 1, 3, 6, 1, 2, 1, 2, 2, 1, 10, 12 };
+	const oid ifHCInOctets[]	= { 1, 3, 6, 1, 2, 1, 31, 1, 1, 1, 6, 12 };
+	// tcpConnState.127.0.0.1.22.127.0.0.1.54321
+	const oid tcpConnState[]	= { 1, 3, 6, 1, 2, 1, 6, 13, 1, 1, 127, 0, 0, 1, 22, 127, 0, 0, 1, 54321 };
+
+	netsnmp_variable_list *vl = NULL;
+	snmp_varlist_add_variable( &vl, ifHCInOctets, OID_LENGTH(ifHCInOctets), ASN_NULL, 0, 0 );
+
+	size_t before = numberOfAllocations;
+	clock_t start = clock();
+	for ( size_t idx = 0; idx < iterations; idx ++ )
+	{
+		const SNMPpp::OID o( vl );
+		assert( o.size() == OID_LENGTH(ifHCInOctets) );
+	}
+	size_t allocations = numberOfAllocations - before;
+	report( "OID( netsnmp_variable_list * )", allocations, iterations, start );
+	assert( allocations == 0 );
+
+	const SNMPpp::OID column( ifInOctets, OID_LENGTH(ifInOctets) - 1 );
+	before = numberOfAllocations;
+	start = clock();
+	for ( size_t idx = 0; idx < iterations; idx ++ )
+	{
+		const SNMPpp::OID o = column + idx;
+		assert( o.size() == OID_LENGTH(ifInOctets) );
+	}
+	allocations = numberOfAllocations - before;
+	report( "OID::operator+( oid )", allocations, iterations, start );
+	assert( allocations == 0 );
+
+	const SNMPpp::OID conn( tcpConnState, OID_LENGTH(tcpConnState) );
+	before = numberOfAllocations;
+	start = clock();
+	for ( size_t idx = 0; idx < iterations; idx ++ )
+	{
+		const SNMPpp::OID o = conn.parent();
+		assert( o.size() == OID_LENGTH(tcpConnState) - 1 );
+	}
+	allocations = numberOfAllocations - before;
+	report( "OID::parent()", allocations, iterations, start );
+	assert( allocations == 0 );
+
+	// OIDs larger than the inline buffer are still supported, but need the heap
+	SNMPpp::OID longOid( conn );
+	for ( size_t idx = 0; idx < SNMPpp::OID::kInlineSize; idx ++ )
+	{
+		longOid += idx;
+	}
+	before = numberOfAllocations;
+	start = clock();
+	for ( size_t idx = 0; idx < iterations; idx ++ )
+	{
+		const SNMPpp::OID o( longOid );
+		assert( o == longOid );
+	}
+	allocations = numberOfAllocations - before;
+	report( "copy of a long OID", allocations, iterations, start );
+	assert( allocations == iterations );
+	assert( longOid.isChildOf( conn ) );
+
+	snmp_free_varbind( vl );
+
+	return;
+}
+
+
+void checkVarlistLookups( void )
+{
+	std::cout << "Checking the number of heap allocations when looking up OIDs in a varlist:" << std::endl;
+
+	// build something which looks like the response to a large GETBULK
+	const size_t len = 1000;
+	SNMPpp::Varlist varlist;
+	SNMPpp::VecOID oids;
+	const SNMPpp::OID ifDescr( ".1.3.6.1.2.1.2.2.1.2" );
+	for ( size_t idx = 0; idx < len; idx ++ )
+	{
+		oids.push_back( ifDescr + idx );
+		varlist.addNullVar( oids.back() );
+	}
+
+	size_t before = numberOfAllocations;
+	clock_t start = clock();
+	for ( size_t idx = 0; idx < len; idx ++ )
+	{
+		assert( varlist.contains( oids[idx] ) );
+		assert( varlist.at( oids[idx] ) != NULL );
+	}
+	assert( varlist.contains( ifDescr ) == false );
+	size_t allocations = numberOfAllocations - before;
+	report( "Varlist::contains() and at()", allocations, len, start );
+	assert( allocations == 0 );
+
+	// same thing, but with the index
+	varlist.buildIndex();
+	before = numberOfAllocations;
+	start = clock();
+	for ( size_t idx = 0; idx < len; idx ++ )
+	{
+		assert( varlist.contains( oids[idx] ) );
+		assert( varlist.at( oids[idx] ) != NULL );
+	}
+	assert( varlist.contains( ifDescr ) == false );
+	allocations = numberOfAllocations - before;
+	report( "...after Varlist::buildIndex()", allocations, len, start );
+	assert( allocations == 0 );
+
+	// OIDs which aren't there are answered by the index too, without walking the list
+	SNMPpp::VecOID absent;
+	for ( size_t idx = 0; idx < len; idx ++ )
+	{
+		absent.push_back( ifDescr + ( len + idx ) );
+	}
+	assert( varlist.hasIndex() );
+	before = numberOfAllocations;
+	start = clock();
+	for ( size_t idx = 0; idx < len; idx ++ )
+	{
+		assert( varlist.contains( absent[idx] ) == false );
+	}
+	allocations = numberOfAllocations - before;
+	report( "...absent OIDs after Varlist::buildIndex()", allocations, len, start );
+	assert( allocations == 0 );
+
+	varlist.free();
+
+	return;
+}
+
+
+void checkVarlistIteration( void )
+{
+	std::cout << "Checking the number of heap allocations when iterating through a varlist:" << std::endl;
+
+	// something which looks like a 5000-varbind walk
+	const size_t len = 5000;
+	SNMPpp::Varlist varlist;
+	const SNMPpp::OID ifInOctets( ".1.3.6.1.2.1.2.2.1.10" );
+	for ( size_t idx = 0; idx < len; idx ++ )
+	{
+		varlist.addIntegerVar( ifInOctets + idx, idx );
+	}
+
+	size_t before = numberOfAllocations;
+	clock_t start = clock();
+	long total = 0;
+	for ( size_t idx = 0; idx < len; idx ++ )
+	{
+		// the old way:  O(n) to find each varbind, then look it up again by OID
+		total += varlist.getLong( SNMPpp::OID( varlist[idx] ) );
+	}
+	size_t allocations = numberOfAllocations - before;
+	report( "Varlist::operator[]()", allocations, len, start );
+
+	before = numberOfAllocations;
+	start = clock();
+	long iterated = 0;
+	for ( SNMPpp::Varlist::const_iterator iter = varlist.begin(); iter != varlist.end(); ++ iter )
+	{
+		if ( iter->name().isChildOf( ifInOctets.view() ) )
+		{
+			iterated += iter->getLong();
+		}
+	}
+	allocations = numberOfAllocations - before;
+	report( "Varlist::begin() and end()", allocations, len, start );
+	assert( allocations == 0 );
+	assert( iterated == total );
+	assert( iterated == long( len * ( len - 1 ) / 2 ) );
+
+	varlist.free();
+
+	return;
+}
+
+
+void checkAppending( void )
+{
+	std::cout << "Checking the time needed to build large requests:" << std::endl;
+
+	const size_t sizes[] = { 10, 100, 10000 };
+	for ( size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s ++ )
+	{
+		const size_t len = sizes[s];
+		const size_t iterations = 20000 / len;
+		SNMPpp::SetOID oids;
+		for ( size_t idx = 0; idx < len; idx ++ )
+		{
+			oids.insert( SNMPpp::OID( ".1.3.6.1.2.1.2.2.1.10" ) + idx );
+		}
+
+		// this is what Varlist::addNullVar() used to do:  walk to the end of the list every time
+		clock_t start = clock();
+		for ( size_t i = 0; i < iterations; i ++ )
+		{
+			netsnmp_variable_list *vl = NULL;
+			for ( SNMPpp::SetOID::const_iterator iter = oids.begin(); iter != oids.end(); iter ++ )
+			{
+				snmp_varlist_add_variable( &vl, *iter, *iter, ASN_NULL, 0, 0 );
+			}
+			snmp_free_varbind( vl );
+		}
+		const clock_t walking = clock() - start;
+
+		SNMPpp::SetOID rest( oids );
+		rest.erase( rest.begin() );
+		start = clock();
+		for ( size_t i = 0; i < iterations; i ++ )
+		{
+			// a copy of the PDU, such as one kept by a callback, doesn't slow down appends
+			SNMPpp::PDU pdu( SNMPpp::PDU::kGet );
+			pdu.addNullVar( *oids.begin() );
+			const SNMPpp::PDU copy( pdu );
+			pdu.addNullVars( rest );
+			assert( pdu.size() == len );
+			assert( SNMPpp::OIDView( pdu.varlist().back() ) == oids.rbegin()->view() );
+			pdu.free();
+		}
+		const clock_t appending = clock() - start;
+
+		std::cout	<< "\t" << std::setw(5) << len << " varbinds x " << std::setw(5) << iterations << ": "
+					<< "walking=" << std::fixed << std::setprecision(3) << double(walking) / CLOCKS_PER_SEC << " seconds, "
+					<< "PDU::addNullVars()=" << double(appending) / CLOCKS_PER_SEC << " seconds" << std::endl;
+
+		if ( len >= 10000 )
+		{
+			assert( appending < walking );
+		}
+	}
+
+	return;
+}
+
+
+/// Encode the PDU the way net-snmp puts it on the wire.
+std::vector< u_char > encode( netsnmp_session &session, netsnmp_pdu *pdu )
+{
+	size_t size = 65536;
+	u_char *buffer = static_cast< u_char * >( malloc( size ) );
+	size_t offset = 0;
+	size_t length = size;
+	const u_char *packet = buffer;
+	int rc = -1;
+#ifdef NETSNMP_USE_REVERSE_ASNENCODING
+	if ( netsnmp_ds_get_boolean( NETSNMP_DS_LIBRARY_ID, NETSNMP_DS_LIB_REVERSE_ENCODE ) )
+	{
+		rc		= snmp_build( &buffer, &size, &offset, &session, pdu );
+		packet	= buffer + size - offset;
+		length	= offset;
+	}
+	else
+#endif
+	{
+		rc		= snmp_build( &buffer, &length, &offset, &session, pdu );
+		packet	= buffer;
+	}
+	assert( rc == 0 );
+	std::vector< u_char > v( packet, packet + length );
+	free( buffer );
+
+	return v;
+}
+
+
+void checkArena( void )
+{
+	std::cout << "Checking the time needed to decode a getBulk loop, and keep the results:" << std::endl;
+
+	// responses as they arrive from the agent, 50 repetitions of ifDescr and ifInOctets at a time
+	netsnmp_session session;
+	snmp_sess_init( &session );
+	std::vector< std::vector< u_char > > packets;
+	for ( oid ifIndex = 1; ifIndex <= 10000; ifIndex += 50 )
+	{
+		SNMPpp::PDU response( SNMPpp::PDU::kResponse );
+		netsnmp_pdu *p = response;
+		p->version			= SNMP_VERSION_2c;
+		p->community		= static_cast< u_char * >( malloc( 7 ) );
+		p->community_len	= 6;
+		memcpy( p->community, "public", 7 );
+		for ( oid idx = ifIndex; idx < ifIndex + 50; idx ++ )
+		{
+			long counter = idx * 1000;
+			const SNMPpp::OID d = SNMPpp::OID( ".1.3.6.1.2.1.2.2.1.2" ) + idx;
+			const SNMPpp::OID o = SNMPpp::OID( ".1.3.6.1.2.1.2.2.1.10" ) + idx;
+			snmp_varlist_add_variable( &p->variables, d, d, ASN_OCTET_STR, "GigabitEthernet0/1", 18 );
+			snmp_varlist_add_variable( &p->variables, o, o, ASN_COUNTER, &counter, sizeof(counter) );
+		}
+		packets.push_back( encode( session, p ) );
+		response.free();
+	}
+
+	// the response PDUs are always decoded and freed by net-snmp, the arena only holds the copies which are kept
+	const char *names[] = { "decode and free", "keep copies with malloc", "keep copies in VarbindArena" };
+	const size_t iterations = 20;
+	SNMPpp::VarbindArena arena;
+	size_t blocks = 0;
+	for ( size_t mode = 0; mode < 3; mode ++ )
+	{
+		const clock_t start = clock();
+		for ( size_t i = 0; i < iterations; i ++ )
+		{
+			SNMPpp::Varlist results = ( mode == 2 ? SNMPpp::Varlist( arena ) : SNMPpp::Varlist() );
+			for ( size_t idx = 0; idx < packets.size(); idx ++ )
+			{
+				netsnmp_pdu *p = static_cast< netsnmp_pdu * >( calloc( 1, sizeof(netsnmp_pdu) ) );
+				const int rc = snmp_parse( NULL, &session, p, packets[idx].data(), packets[idx].size() );
+				assert( rc == 0 );
+				SNMPpp::PDU response( p );
+				if ( mode > 0 )
+				{
+					results.addVarbinds( response.begin(), response.end() );
+				}
+				response.free();
+			}
+
+			if ( mode > 0 )
+			{
+				assert( results.size() == 20000 );
+				assert( *results.back()->val.integer == 10000000 );
+			}
+			results.free();
+			arena.reset();
+
+			// once the arena has grown, it no longer allocates anything
+			assert( mode < 2 || i == 0 || arena.blockCount() == blocks );
+			blocks = arena.blockCount();
+		}
+
+		std::cout	<< "\t" << iterations << " x 20000 varbinds, " << std::left << std::setw(28) << names[mode] << std::right << ": "
+					<< std::fixed << std::setprecision(3) << secondsSince( start ) << " seconds" << std::endl;
+	}
+	std::cout << "\tVarbindArena used " << blocks << " blocks" << std::endl;
+
+	return;
+}
+
+
+SNMPpp::OID legacyParse( const std::string &s )
+{
+	// this is how OID::operator+( std::string ) used to parse text
+	std::vector<oid> v;
+
+	size_t pos = 0;
+	while ( pos < std::string::npos )
+	{
+		if ( s[ pos ] == '.' )
+		{
+			pos ++;
+		}
+		if ( pos >= s.size() )
+		{
+			break;
+		}
+		const char * const p = &s[pos];
+		if ( isdigit( p[0] ) == false )
+		{
+			break;
+		}
+		v.push_back( atoi( p ) );
+		pos = s.find_first_not_of( "0123456789", pos );
+	}
+
+	return SNMPpp::OID( v.empty() ? NULL : &v[0], v.size() );
+}
+
+
+void checkParsing( void )
+{
+	std::cout << "Checking the OID parser:" << std::endl;
+
+	// the new parser must give the same results as the old one
+	const char *samples[] =
+	{
+		"", ".", "..", "junk", "1", ".1", "1.", ".1.", "1..2", ".1.3.6.1.2.1.1.3.0",
+		".1.2.3.4.5.6 followed by junk", ".1.2.3.4.5.6.followed by junk", "1.2.3a.4",
+		".1.3.6.1.4.1.8072.1.2.1.1.4.0.10.1.3.6.1.2.1.1.9.1.2.1", "2147483647.0"
+	};
+	for ( size_t idx = 0; idx < sizeof(samples) / sizeof(samples[0]); idx ++ )
+	{
+		assert( SNMPpp::OID( samples[idx] ) == legacyParse( samples[idx] ) );
+	}
+
+	// build something which looks like a walk dump read from a file at startup
+	std::vector<std::string> lines;
+	for ( size_t idx = 0; idx < 200000; idx ++ )
+	{
+		lines.push_back( ".1.3.6.1.2.1.31.1.1.1." + std::to_string( idx % 20 ) + "." + std::to_string( 100000 + idx ) );
+	}
+
+	size_t total = 0;
+	clock_t start = clock();
+	for ( size_t idx = 0; idx < lines.size(); idx ++ )
+	{
+		total += legacyParse( lines[idx] ).size();
+	}
+	const double legacySeconds = secondsSince( start );
+
+	start = clock();
+	for ( size_t idx = 0; idx < lines.size(); idx ++ )
+	{
+		total -= SNMPpp::OID( lines[idx] ).size();
+	}
+	const double newSeconds = secondsSince( start );
+	assert( total == 0 );
+
+	std::cout	<< "\tparsing " << lines.size() << " OIDs: "
+				<< "old=" << legacySeconds << " seconds, "
+				<< "new=" << newSeconds << " seconds" << std::endl;
+
+	return;
+}
+
+
+std::string legacyFormat( const SNMPpp::OID &o )
+{
+	// this is how OID::operator std::string() used to format OIDs
+	std::stringstream ss;
+	for ( size_t idx = 0; idx < o.size(); idx ++ )
+	{
+		ss << "." << o[ idx ];
+	}
+
+	return ss.str();
+}
+
+
+void checkFormatting( void )
+{
+	std::cout << "Checking the OID formatter:" << std::endl;
+
+	SNMPpp::VecOID oids;
+	for ( size_t idx = 0; idx < 200000; idx ++ )
+	{
+		oids.push_back( SNMPpp::OID( ".1.3.6.1.2.1.31.1.1.1" ) + ( idx % 20 ) + ( 100000 + idx ) );
+	}
+
+	size_t total = 0;
+	clock_t start = clock();
+	for ( size_t idx = 0; idx < oids.size(); idx ++ )
+	{
+		total += legacyFormat( oids[idx] ).size();
+	}
+	const double legacySeconds = secondsSince( start );
+
+	start = clock();
+	for ( size_t idx = 0; idx < oids.size(); idx ++ )
+	{
+		total -= oids[idx].to_str().size();
+	}
+	const double stringSeconds = secondsSince( start );
+	assert( total == 0 );
+
+	std::string dump;
+	start = clock();
+	for ( size_t idx = 0; idx < oids.size(); idx ++ )
+	{
+		oids[idx].appendTo( dump ) += '\n';
+	}
+	const double appendSeconds = secondsSince( start );
+
+	char buffer[100];
+	start = clock();
+	for ( size_t idx = 0; idx < oids.size(); idx ++ )
+	{
+		total += oids[idx].format( buffer, sizeof(buffer) ) + 1;
+	}
+	const double bufferSeconds = secondsSince( start );
+	assert( total == dump.size() );
+
+	std::cout	<< "\tformatting " << oids.size() << " OIDs: "
+				<< "stringstream=" << legacySeconds << " seconds, "
+				<< "to_str()=" << stringSeconds << " seconds, "
+				<< "appendTo()=" << appendSeconds << " seconds, "
+				<< "format()=" << bufferSeconds << " seconds" << std::endl;
+
+	return;
+}
+
+
+void checkHashing( void )
+{
+	std::cout << "Checking ordered and unordered OID containers:" << std::endl;
+
+	// something which looks like the OIDs of a large device
+	SNMPpp::VecOID oids;
+	for ( size_t idx = 0; idx < 200000; idx ++ )
+	{
+		oids.push_back( SNMPpp::OID( ".1.3.6.1.2.1.31.1.1.1" ) + ( idx % 20 ) + ( idx / 20 ) );
+	}
+
+	const SNMPpp::SetOID ordered( oids.begin(), oids.end() );
+	const SNMPpp::UnorderedSetOID hashed( oids.begin(), oids.end() );
+	assert( ordered.size() == oids.size() );
+	assert( hashed.size() == oids.size() );
+
+	size_t found = 0;
+	clock_t start = clock();
+	for ( size_t idx = 0; idx < oids.size(); idx ++ )
+	{
+		found += ordered.count( oids[idx] );
+	}
+	const double orderedSeconds = secondsSince( start );
+
+	start = clock();
+	for ( size_t idx = 0; idx < oids.size(); idx ++ )
+	{
+		found += hashed.count( oids[idx] );
+	}
+	const double hashedSeconds = secondsSince( start );
+	assert( found == 2 * oids.size() );
+
+	std::cout	<< "\tlooking up " << oids.size() << " OIDs: "
+				<< "SetOID=" << orderedSeconds << " seconds, "
+				<< "UnorderedSetOID=" << hashedSeconds << " seconds" << std::endl;
+
+	return;
+}
+
+
+void checkMoves( void )
+{
+	std::cout << "Checking the number of deep copies in a typical getNext loop:" << std::endl;
+
+	// use OIDs which are too long for the inline buffer, so every deep copy shows up as a heap allocation
+	SNMPpp::OID base( ".1.3.6.1.2.1.4.22.1.2" );
+	for ( size_t idx = 0; idx < SNMPpp::OID::kInlineSize; idx ++ )
+	{
+		base += idx;
+	}
+
+	const size_t iterations = 100000;
+
+	// the way a getNext loop had to be written before OIDs could be moved:
+	// every step copies the OID from one variable to the next
+	size_t before = numberOfAllocations;
+	clock_t start = clock();
+	{
+		SNMPpp::VecOID walked;
+		SNMPpp::OID current( base );
+		for ( size_t idx = 0; idx < iterations; idx ++ )
+		{
+			SNMPpp::OID next( current.parent() );
+			next += idx;
+			walked.push_back( next );
+			current = next;
+		}
+		std::sort( walked.rbegin(), walked.rend() );
+		assert( walked.front() == base.parent() + oid( iterations - 1 ) );
+	}
+	const size_t copyAllocations = numberOfAllocations - before;
+	report( "getNext loop with copies", copyAllocations, iterations, start );
+
+	// the same loop when temporaries are moved instead of copied
+	before = numberOfAllocations;
+	start = clock();
+	{
+		SNMPpp::VecOID walked;
+		SNMPpp::OID current( base );
+		for ( size_t idx = 0; idx < iterations; idx ++ )
+		{
+			SNMPpp::OID next = current.parent() + idx;
+			current = next;
+			walked.push_back( std::move( next ) );
+		}
+
+		// sorting (and growing the vector above) only moves the OIDs around, so nothing is allocated
+		const size_t beforeSort = numberOfAllocations;
+		std::sort( walked.rbegin(), walked.rend() );
+		assert( numberOfAllocations == beforeSort );
+		assert( walked.front() == base.parent() + oid( iterations - 1 ) );
+	}
+	const size_t moveAllocations = numberOfAllocations - before;
+	report( "getNext loop with moves", moveAllocations, iterations, start );
+
+	// moving means only 1 allocation per OID is left (plus the vector's own buffer)
+	assert( moveAllocations < iterations + 50 );
+	assert( copyAllocations >= 2 * iterations );
+
+	// a moved OID takes the heap buffer, and leaves the original empty
+	SNMPpp::OID o1( base );
+	const oid *p = o1;
+	before = numberOfAllocations;
+	SNMPpp::OID o2( std::move( o1 ) );
+	assert( numberOfAllocations == before );
+	assert( o1.empty() );
+	assert( o2 == base );
+	assert( (const oid *)o2 == p );
+
+	// short OIDs are copied into the inline buffer of the new object
+	SNMPpp::OID o3( ".1.3.6.1" );
+	SNMPpp::OID o4;
+	o4 = std::move( o3 );
+	assert( o3.empty() );
+	assert( o4 == SNMPpp::OID( ".1.3.6.1" ) );
+
+	return;
+}
+
+
+int main( int argc, char *argv[] )
+{
+	std::cout << "Test the performance of some of the OID functionality." << std::endl;
+
+	checkAllocations();
+	checkVarlistLookups();
+	checkVarlistIteration();
+	checkAppending();
+	checkArena();
+	checkParsing();
+	checkFormatting();
+	checkHashing();
+	checkMoves();
+
+	std::cout << "\t...done!" << std::endl;
+
+	return 0;
+}
@@ -0,0 +1,200 @@
+// SNMPpp: https://sourceforge.net/p/snmppp/
+// SNMPpp project uses the MIT license. See LICENSE for details.
+// Copyright (C) 2013 Stephane Charette <stephanecharette@gmail.com>
+
+#include <assert.h>
+#include <time.h>
+#include <iostream>
+#include <SNMPpp/OidTrie.hpp>
+
+
+void checkBasicFunctionality( void )
+{
+	std::cout << "Checking basic functionality of OidTrie:" << std::endl;
+
+	SNMPpp::OidTrie<int> trie;
+	assert( trie.empty() );
+	assert( trie.size() == 0 );
+	assert( trie.find( SNMPpp::OID( ".1.3.6.1" ) ) == NULL );
+	assert( trie.longestPrefix( SNMPpp::OID( ".1.3.6.1" ) ) == NULL );
+
+	trie.insert( SNMPpp::OID( ".1.3.6.1.2.1"		), 1 );
+	trie.insert( SNMPpp::OID( ".1.3.6.1.2.1.2"		), 2 );
+	trie.insert( SNMPpp::OID( ".1.3.6.1.2.1.2.2.1"	), 3 );
+	trie.insert( SNMPpp::OID( ".1.3.6.1.4.1"		), 4 );
+	assert( trie.size() == 4 );
+
+	// replacing a value does not change the size
+	assert( trie.insert( SNMPpp::OID( ".1.3.6.1.4.1" ), 5 ) == 5 );
+	assert( trie.size() == 4 );
+
+	// exact lookups
+	assert( trie.find( SNMPpp::OID( ".1.3.6.1.2.1.2" ) ) != NULL );
+	assert( *trie.find( SNMPpp::OID( ".1.3.6.1.2.1.2" ) ) == 2 );
+	assert( *trie.find( SNMPpp::OID( ".1.3.6.1.4.1" ) ) == 5 );
+	assert( trie.find( SNMPpp::OID( ".1.3.6.1.2" ) ) == NULL );
+	assert( trie.find( SNMPpp::OID( ".1.3.6.1.2.1.2.2" ) ) == NULL );
+	assert( trie.find( SNMPpp::OID( ".1.3.6.1.2.1.2.2.1.10" ) ) == NULL );
+
+	// longest prefix
+	size_t len = 999;
+	assert( *trie.longestPrefix( SNMPpp::OID( ".1.3.6.1.2.1.2.2.1.10.3" ), &len ) == 3 );
+	assert( len == 9 );
+	assert( *trie.longestPrefix( SNMPpp::OID( ".1.3.6.1.2.1.2.2.2" ), &len ) == 2 );
+	assert( len == 7 );
+	assert( *trie.longestPrefix( SNMPpp::OID( ".1.3.6.1.2.1.25.1.1.0" ), &len ) == 1 );
+	assert( len == 6 );
+	assert( *trie.longestPrefix( SNMPpp::OID( ".1.3.6.1.2.1" ), &len ) == 1 );
+	assert( len == 6 );
+	assert( trie.longestPrefix( SNMPpp::OID( ".1.3.6.1.2" ), &len ) == NULL );
+	assert( len == 0 );
+	assert( trie.longestPrefix( SNMPpp::OID( ".1.3.6.1.6.3" ), &len ) == NULL );
+	assert( len == 0 );
+
+	// lookups can also be done directly on the name of a varbind
+	const oid ifInOctets[] = { 1, 3, 6, 1, 2, 1, 2, 2, 1, 10, 12 };
+	assert( *trie.longestPrefix( SNMPpp::OIDView( ifInOctets, OID_LENGTH(ifInOctets) ) ) == 3 );
+
+	// values can be modified in place
+	*trie.find( SNMPpp::OID( ".1.3.6.1.2.1" ) ) = 10;
+	assert( *trie.longestPrefix( SNMPpp::OID( ".1.3.6.1.2.1.1.3.0" ) ) == 10 );
+
+	// erasing a parent does not affect the children
+	assert( trie.erase( SNMPpp::OID( ".1.3.6.1.2.1.2" ) ) );
+	assert( trie.erase( SNMPpp::OID( ".1.3.6.1.2.1.2" ) ) == false );
+	assert( trie.erase( SNMPpp::OID( ".1.3.6.1.2.1.2.2" ) ) == false );
+	assert( trie.size() == 3 );
+	assert( *trie.longestPrefix( SNMPpp::OID( ".1.3.6.1.2.1.2.2.1.10.3" ) ) == 3 );
+	assert( *trie.longestPrefix( SNMPpp::OID( ".1.3.6.1.2.1.2.2.2" ) ) == 10 );
+
+	// erasing a leaf prunes the branch, but not the parent value
+	assert( trie.erase( SNMPpp::OID( ".1.3.6.1.2.1.2.2.1" ) ) );
+	assert( trie.size() == 2 );
+	assert( *trie.longestPrefix( SNMPpp::OID( ".1.3.6.1.2.1.2.2.1.10.3" ) ) == 10 );
+
+	// an empty OID is the parent of everything
+	trie.insert( SNMPpp::OID(), -1 );
+	assert( trie.size() == 3 );
+	assert( *trie.longestPrefix( SNMPpp::OID( ".1.3.6.1.6.3" ), &len ) == -1 );
+	assert( len == 0 );
+
+	trie.clear();
+	assert( trie.empty() );
+	assert( trie.longestPrefix( SNMPpp::OID( ".1.3.6.1.2.1" ) ) == NULL );
+
+	return;
+}
+
+
+void checkSubtreeIteration( void )
+{
+	std::cout << "Checking OidTrie subtree iteration:" << std::endl;
+
+	// insert the OIDs in random-ish order, they must come back sorted
+	SNMPpp::OidTrie<size_t> trie;
+	SNMPpp::SetOID expected;
+	const SNMPpp::OID ifTable( ".1.3.6.1.2.1.2.2" );
+	for ( size_t idx = 0; idx < 100; idx ++ )
+	{
+		const SNMPpp::OID o = ifTable + oid( 1 ) + oid( 1 + ( idx * 7 ) % 22 ) + oid( 1 + ( idx * 13 ) % 50 );
+		trie.insert( o, idx );
+		expected.insert( o );
+	}
+	trie.insert( SNMPpp::OID( ".1.3.6.1.2.1.1.3.0" ), 1000 );
+	trie.insert( SNMPpp::OID( ".1.3.6.1.2.1.2.1.0" ), 1001 );
+	trie.insert( ifTable, 1002 );
+	expected.insert( ifTable );
+	assert( trie.size() == expected.size() + 2 );
+
+	SNMPpp::VecOID visited;
+	trie.forEach( ifTable, [&visited]( const SNMPpp::OID &o, const size_t & ) { visited.push_back( o ); } );
+	assert( visited.size() == expected.size() );
+	assert( SNMPpp::VecOID( expected.begin(), expected.end() ) == visited );
+
+	// the prefix itself does not have to be in the trie
+	visited.clear();
+	trie.forEach( SNMPpp::OID( ".1.3.6.1.2.1.2" ), [&visited]( const SNMPpp::OID &o, const size_t & ) { visited.push_back( o ); } );
+	assert( visited.size() == expected.size() + 1 );
+	assert( visited[0] == SNMPpp::OID( ".1.3.6.1.2.1.2.1.0" ) );
+
+	// an empty prefix visits everything
+	size_t total = 0;
+	trie.forEach( SNMPpp::OIDView(), [&total]( const SNMPpp::OID &, const size_t & ) { total ++; } );
+	assert( total == trie.size() );
+
+	// and a prefix which does not exist visits nothing
+	total = 0;
+	trie.forEach( SNMPpp::OID( ".1.3.6.1.2.1.3" ), [&total]( const SNMPpp::OID &, const size_t & ) { total ++; } );
+	assert( total == 0 );
+
+	return;
+}
+
+
+void checkPerformance( void )
+{
+	std::cout << "Checking OidTrie performance:" << std::endl;
+
+	// dispatch the varbinds of a large walk to handlers registered for a few hundred subtrees
+	SNMPpp::VecOID handlers;
+	SNMPpp::OidTrie<size_t> trie;
+	for ( size_t idx = 0; idx < 500; idx ++ )
+	{
+		handlers.push_back( SNMPpp::OID( ".1.3.6.1.4.1" ) + oid( 1000 + idx ) + oid( 1 ) );
+		trie.insert( handlers.back(), idx );
+	}
+
+	SNMPpp::VecOID walk;
+	for ( size_t idx = 0; idx < 120000; idx ++ )
+	{
+		walk.push_back( SNMPpp::OID( ".1.3.6.1.4.1" ) + oid( 1000 + idx % 600 ) + oid( 1 ) + oid( 2 ) + oid( idx ) );
+	}
+
+	size_t linearFound = 0;
+	clock_t start = clock();
+	for ( size_t idx = 0; idx < walk.size(); idx ++ )
+	{
+		for ( size_t h = 0; h < handlers.size(); h ++ )
+		{
+			if ( walk[idx].isChildOf( handlers[h] ) )
+			{
+				linearFound ++;
+				break;
+			}
+		}
+	}
+	const double linearSeconds = double( clock() - start ) / CLOCKS_PER_SEC;
+
+	size_t trieFound = 0;
+	start = clock();
+	for ( size_t idx = 0; idx < walk.size(); idx ++ )
+	{
+		if ( trie.longestPrefix( walk[idx] ) != NULL )
+		{
+			trieFound ++;
+		}
+	}
+	const double trieSeconds = double( clock() - start ) / CLOCKS_PER_SEC;
+	assert( linearFound == trieFound );
+	assert( trieFound == walk.size() * 500 / 600 );
+
+	std::cout	<< "\tdispatching " << walk.size() << " OIDs to " << handlers.size() << " handlers: "
+				<< "isChildOf()=" << linearSeconds << " seconds, "
+				<< "OidTrie=" << trieSeconds << " seconds" << std::endl;
+
+	return;
+}
+
+
+int main( int argc, char *argv[] )
+{
+	std::cout << "Test the OID trie." << std::endl;
+
+	checkBasicFunctionality();
+	checkSubtreeIteration();
+	checkPerformance();
+
+	std::cout << "\t...done!" << std::endl;
+
+	return 0;
+}
@@ -0,0 +1,199 @@
+// SNMPpp: https://sourceforge.net/p/snmppp/
+// SNMPpp project uses the MIT license. See LICENSE for details.
+// Copyright (C) 2013 Stephane Charette <stephanecharette@gmail.com>
+
+#include <assert.h>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+#include <SNMPpp/OIDPool.hpp>
+
+
+void checkBasicFunctionality( void )
+{
+	std::cout << "Checking basic functionality of OIDPool:" << std::endl;
+
+	SNMPpp::OIDPool pool;
+	assert( pool.size() == 1 );
+	assert( pool.length( SNMPpp::OIDPool::kEmpty ) == 0 );
+	assert( pool.resolve( SNMPpp::OIDPool::kEmpty ).empty() );
+	assert( pool.intern( SNMPpp::OID() ) == SNMPpp::OIDPool::kEmpty );
+
+	const SNMPpp::OID ifInOctets12( ".1.3.6.1.2.1.2.2.1.10.12" );
+	const SNMPpp::OIDPool::Handle h1 = pool.intern( ifInOctets12 );
+	assert( h1 != SNMPpp::OIDPool::kEmpty );
+	assert( pool.size() == 1 + ifInOctets12.size() );
+	assert( pool.length( h1 ) == ifInOctets12.size() );
+	assert( pool.resolve( h1 ) == ifInOctets12 );
+	assert( pool.find( ifInOctets12 ) == h1 );
+
+	// interning the same OID again, even from a different source, gives the same handle
+	const oid raw[] = { 1, 3, 6, 1, 2, 1, 2, 2, 1, 10, 12 };
+	assert( pool.intern( SNMPpp::OIDView( raw, OID_LENGTH(raw) ) ) == h1 );
+	assert( pool.intern( SNMPpp::OID( ".1.3.6.1.2.1.2.2.1.10.12" ) ) == h1 );
+	assert( pool.size() == 1 + ifInOctets12.size() );
+
+	// a sibling only costs a single new node
+	const SNMPpp::OIDPool::Handle h2 = pool.intern( SNMPpp::OID( ".1.3.6.1.2.1.2.2.1.10.13" ) );
+	assert( h2 != h1 );
+	assert( pool.size() == 2 + ifInOctets12.size() );
+	assert( pool.parent( h1 ) == pool.parent( h2 ) );
+	assert( pool.resolve( pool.parent( h1 ) ) == ifInOctets12.parent() );
+	assert( pool.parent( SNMPpp::OIDPool::kEmpty ) == SNMPpp::OIDPool::kEmpty );
+
+	// prefixes which were interned as part of a longer OID are found as well
+	const SNMPpp::OIDPool::Handle ifTable = pool.find( SNMPpp::OID( ".1.3.6.1.2.1.2.2" ) );
+	assert( ifTable != SNMPpp::OIDPool::kNotFound );
+	assert( pool.intern( SNMPpp::OID( ".1.3.6.1.2.1.2.2" ) ) == ifTable );
+	assert( pool.find( SNMPpp::OID( ".1.3.6.1.2.1.2.3" ) ) == SNMPpp::OIDPool::kNotFound );
+	assert( pool.find( SNMPpp::OID( ".1.3.6.1.2.1.2.2.1.10.12.0" ) ) == SNMPpp::OIDPool::kNotFound );
+
+	// relationships
+	assert( pool.isChildOf( h1, ifTable ) );
+	assert( pool.isChildOf( h2, ifTable ) );
+	assert( pool.isChildOf( ifTable, h1 ) == false );
+	assert( pool.isChildOf( h1, h2 ) == false );
+	assert( pool.isChildOf( h1, h1 ) == false );
+	assert( pool.isChildOf( h1, SNMPpp::OIDPool::kEmpty ) == false );
+
+	// resolving into a buffer
+	oid buffer[20];
+	assert( pool.resolve( h1, buffer, 5 ) == ifInOctets12.size() );
+	assert( pool.resolve( h1, buffer, 20 ) == ifInOctets12.size() );
+	assert( SNMPpp::OID( buffer, ifInOctets12.size() ) == ifInOctets12 );
+
+	// OIDs longer than SNMPpp::OID::kInlineSize
+	SNMPpp::OID longOid( ifInOctets12 );
+	for ( size_t idx = 0; idx < 50; idx ++ )
+	{
+		longOid += idx;
+	}
+	const SNMPpp::OIDPool::Handle h3 = pool.intern( longOid );
+	assert( pool.resolve( h3 ) == longOid );
+	assert( pool.isChildOf( h3, h1 ) );
+
+	// invalid handles and values
+	bool exceptionThrown = false;
+	try
+	{
+		pool.resolve( 12345678 );
+	}
+	catch ( const std::invalid_argument &e )
+	{
+		exceptionThrown = true;
+	}
+	assert( exceptionThrown );
+
+	if ( sizeof(oid) > 4 )
+	{
+		exceptionThrown = false;
+		const oid tooBig[] = { 1, 3, static_cast<oid>( MAX_SUBID ) + 1 };
+		try
+		{
+			pool.intern( SNMPpp::OIDView( tooBig, 3 ) );
+		}
+		catch ( const std::invalid_argument &e )
+		{
+			exceptionThrown = true;
+		}
+		assert( exceptionThrown );
+		assert( pool.find( SNMPpp::OIDView( tooBig, 3 ) ) == SNMPpp::OIDPool::kNotFound );
+	}
+
+	// the global pool is always the same object
+	assert( &SNMPpp::OIDPool::global() == &SNMPpp::OIDPool::global() );
+
+	return;
+}
+
+
+void checkThreads( void )
+{
+	std::cout << "Checking OIDPool with multiple threads:" << std::endl;
+
+	// several pollers interning the same columns for the same interfaces at the same time
+	SNMPpp::OIDPool pool;
+	const size_t numberOfThreads = 4;
+	std::vector< std::vector< SNMPpp::OIDPool::Handle > > results( numberOfThreads );
+	std::vector< std::thread > threads;
+	for ( size_t t = 0; t < numberOfThreads; t ++ )
+	{
+		threads.push_back( std::thread( [&pool, &results, t]( void )
+		{
+			for ( oid column = 1; column <= 22; column ++ )
+			{
+				for ( oid ifIndex = 1; ifIndex <= 500; ifIndex ++ )
+				{
+					const SNMPpp::OID o = SNMPpp::OID( ".1.3.6.1.2.1.2.2.1" ) + column + ifIndex;
+					results[t].push_back( pool.intern( o ) );
+				}
+			}
+		} ) );
+	}
+	for ( size_t t = 0; t < numberOfThreads; t ++ )
+	{
+		threads[t].join();
+	}
+
+	// every thread must have been given exactly the same handles
+	for ( size_t t = 1; t < numberOfThreads; t ++ )
+	{
+		assert( results[t] == results[0] );
+	}
+	// 1 empty + 9 for ifEntry + 22 columns + 22x500 instances
+	assert( pool.size() == 1 + 9 + 22 + 22 * 500 );
+
+	return;
+}
+
+
+void checkMemory( void )
+{
+	std::cout << "Checking OIDPool memory usage:" << std::endl;
+
+	// the same 22 columns x 48 ports for 2000 devices
+	const size_t devices = 2000;
+	SNMPpp::OIDPool pool;
+	std::vector< SNMPpp::OID > oids;
+	std::vector< SNMPpp::OIDPool::Handle > handles;
+	for ( size_t device = 0; device < devices; device ++ )
+	{
+		for ( oid column = 1; column <= 22; column ++ )
+		{
+			for ( oid ifIndex = 1; ifIndex <= 48; ifIndex ++ )
+			{
+				const SNMPpp::OID o = SNMPpp::OID( ".1.3.6.1.2.1.2.2.1" ) + column + ifIndex;
+				oids.push_back( o );
+				handles.push_back( pool.intern( o ) );
+			}
+		}
+	}
+
+	const size_t oidBytes		= oids.size() * sizeof( SNMPpp::OID );
+	const size_t handleBytes	= handles.size() * sizeof( SNMPpp::OIDPool::Handle ) + pool.memoryUsage();
+	std::cout	<< "\tstoring " << oids.size() << " OIDs: "
+				<< "OID=" << oidBytes << " bytes, "
+				<< "OIDPool=" << handleBytes << " bytes (" << pool.size() << " nodes)" << std::endl;
+	assert( handleBytes * 10 < oidBytes );
+
+	for ( size_t idx = 0; idx < handles.size(); idx += 997 )
+	{
+		assert( pool.resolve( handles[idx] ) == oids[idx] );
+	}
+
+	return;
+}
+
+
+int main( int argc, char *argv[] )
+{
+	std::cout << "Test the OID interning pool." << std::endl;
+
+	checkBasicFunctionality();
+	checkThreads();
+	checkMemory();
+
+	std::cout << "\t...done!" << std::endl;
+
+	return 0;
+}
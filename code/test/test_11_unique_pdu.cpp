@@ -0,0 +1,113 @@
+// SNMPpp: https://sourceforge.net/p/snmppp/
+// SNMPpp project uses the MIT license. See LICENSE for details.
+// Copyright (C) 2013 Stephane Charette <stephanecharette@gmail.com>
+
+#include <assert.h>
+#include <iostream>
+#include <utility>
+#include <SNMPpp/UniquePDU.hpp>
+
+
+void checkOwnership( void )
+{
+	std::cout << "Checking UniquePDU ownership:" << std::endl;
+
+	SNMPpp::UniquePDU pdu1( SNMPpp::PDU::kGet );
+	pdu1.addNullVar( ".1.3.6.1.2.1.1.3.0" );
+	netsnmp_pdu *raw = pdu1;
+	assert( raw != NULL );
+	assert( pdu1.size() == 1 );
+	assert( pdu1.getType() == SNMPpp::PDU::kGet );
+
+	// moving hands over ownership
+	SNMPpp::UniquePDU pdu2( std::move( pdu1 ) );
+	assert( (netsnmp_pdu *)pdu1 == NULL );
+	assert( (netsnmp_pdu *)pdu2 == raw );
+	assert( pdu2.size() == 1 );
+
+	// a plain PDU, such as the response from SNMPpp::get(), can be moved in as well
+	SNMPpp::PDU response( SNMPpp::PDU::kResponse );
+	netsnmp_pdu *rawResponse = response;
+	SNMPpp::UniquePDU pdu3( std::move( response ) );
+	assert( (netsnmp_pdu *)response == NULL );
+	assert( (netsnmp_pdu *)pdu3 == rawResponse );
+	assert( pdu3.getType() == SNMPpp::PDU::kResponse );
+
+	// assigning frees whatever the UniquePDU was holding before
+	pdu3 = std::move( pdu2 );
+	assert( (netsnmp_pdu *)pdu2 == NULL );
+	assert( (netsnmp_pdu *)pdu3 == raw );
+	pdu3 = SNMPpp::PDU( SNMPpp::PDU::kSet );
+	assert( pdu3.getType() == SNMPpp::PDU::kSet );
+
+	// release() gives up ownership, and the caller is responsible for freeing
+	SNMPpp::PDU released = pdu3.release();
+	assert( (netsnmp_pdu *)pdu3 == NULL );
+	assert( released.getType() == SNMPpp::PDU::kSet );
+	released.free();
+
+	// a UniquePDU can be passed wherever a PDU reference is expected
+	SNMPpp::UniquePDU pdu4( SNMPpp::PDU::kGetNext );
+	SNMPpp::PDU &ref = pdu4;
+	ref.addNullVar( ".1.3.6.1" );
+	assert( pdu4.contains( SNMPpp::OID( ".1.3.6.1" ) ) );
+
+	// an empty UniquePDU is perfectly valid
+	SNMPpp::UniquePDU pdu5( (netsnmp_pdu *)NULL );
+	assert( pdu5.empty() );
+
+	return;
+}
+
+
+void checkRecycle( void )
+{
+	std::cout << "Checking UniquePDU recycling:" << std::endl;
+
+	SNMPpp::UniquePDU pdu( SNMPpp::PDU::kGet );
+	netsnmp_pdu *raw = pdu;
+	long reqid = raw->reqid;
+
+	for ( size_t idx = 0; idx < 1000; idx ++ )
+	{
+		pdu.addNullVar( ".1.3.6.1.2.1.2.2.1.10" );
+		pdu.addNullVar( ".1.3.6.1.2.1.2.2.1.16" );
+		raw->errstat = 5;
+		assert( pdu.size() == 2 );
+
+		pdu.recycle( idx % 2 ? SNMPpp::PDU::kGet : SNMPpp::PDU::kGetNext );
+
+		// same memory, but the PDU looks brand new
+		assert( (netsnmp_pdu *)pdu == raw );
+		assert( pdu.size() == 0 );
+		assert( raw->variables == NULL );
+		assert( raw->errstat == SNMP_DEFAULT_ERRSTAT );
+		assert( raw->version == SNMP_DEFAULT_VERSION );
+		assert( raw->command == ( idx % 2 ? SNMP_MSG_GET : SNMP_MSG_GETNEXT ) );
+		assert( pdu.getType() == ( idx % 2 ? SNMPpp::PDU::kGet : SNMPpp::PDU::kGetNext ) );
+		assert( raw->reqid != reqid );
+		reqid = raw->reqid;
+	}
+
+	// recycling an empty PDU creates a new one
+	SNMPpp::PDU released = pdu.release();
+	released.free();
+	pdu.recycle( SNMPpp::PDU::kGetBulk );
+	assert( (netsnmp_pdu *)pdu != NULL );
+	assert( pdu.getType() == SNMPpp::PDU::kGetBulk );
+
+	return;
+}
+
+
+int main( int argc, char *argv[] )
+{
+	std::cout << "Test UniquePDU." << std::endl;
+
+	checkOwnership();
+	checkRecycle();
+
+	std::cout << "\t...done!" << std::endl;
+
+	return 0;
+}
@@ -0,0 +1,204 @@
+// SNMPpp: https://sourceforge.net/p/snmppp/
+// SNMPpp project uses the MIT license. See LICENSE for details.
+// Copyright (C) 2013 Stephane Charette <stephanecharette@gmail.com>
+
+#include <assert.h>
+#include <string.h>
+#include <iostream>
+#include <stdexcept>
+#include <SNMPpp/Varlist.hpp>
+
+
+void add( SNMPpp::Varlist &varlist, const oid n, const u_char type, const void *value, const size_t len )
+{
+	const SNMPpp::OID o = SNMPpp::OID( ".1.3.6.1.4.1.99999" ) + n;
+	snmp_varlist_add_variable( varlist, o, o, type, value, len );
+
+	return;
+}
+
+
+SNMPpp::Varlist createVarlist( void )
+{
+	// something which looks like a response from an agent, with one of each type
+	SNMPpp::Varlist varlist;
+
+	long integer	= -42;
+	long counter	= 4000000000;
+	long gauge		= 1000000000;
+	long ticks		= 360000;
+	long unsign		= 7;
+	struct counter64 c64;
+	c64.high		= 0x12;
+	c64.low			= 0x34567890;
+	const u_char address[] = { 192, 168, 1, 254 };
+	const oid objid[] = { 1, 3, 6, 1, 2, 1, 1 };
+	float f			= 1.5;
+	double d		= -2.25;
+
+	add( varlist,  1, ASN_INTEGER,			&integer,	sizeof(integer)	);
+	add( varlist,  2, ASN_COUNTER,			&counter,	sizeof(counter)	);
+	add( varlist,  3, ASN_GAUGE,			&gauge,		sizeof(gauge)	);
+	add( varlist,  4, ASN_TIMETICKS,		&ticks,		sizeof(ticks)	);
+	add( varlist,  5, ASN_UINTEGER,			&unsign,	sizeof(unsign)	);
+	add( varlist,  6, ASN_COUNTER64,		&c64,		sizeof(c64)		);
+	add( varlist,  7, ASN_IPADDRESS,		address,	sizeof(address)	);
+	add( varlist,  8, ASN_OBJECT_ID,		objid,		sizeof(objid)	);
+	add( varlist,  9, ASN_OCTET_STR,		"eth0",		4				);
+	add( varlist, 10, ASN_OPAQUE_FLOAT,		&f,			sizeof(f)		);
+	add( varlist, 11, ASN_OPAQUE_DOUBLE,	&d,			sizeof(d)		);
+	add( varlist, 12, ASN_NULL,				NULL,		0				);
+
+	return varlist;
+}
+
+
+void checkTypedAccessors( void )
+{
+	std::cout << "Checking typed accessors:" << std::endl;
+
+	SNMPpp::Varlist varlist = createVarlist();
+	const SNMPpp::OID base( ".1.3.6.1.4.1.99999" );
+
+	assert( varlist.getLong		( base + oid( 1 ) ) == -42 );
+	assert( varlist.getUnsigned	( base + oid( 2 ) ) == 4000000000UL );
+	assert( varlist.getUnsigned	( base + oid( 3 ) ) == 1000000000UL );
+	assert( varlist.getUnsigned	( base + oid( 4 ) ) == 360000UL );
+	assert( varlist.getUnsigned	( base + oid( 5 ) ) == 7UL );
+	assert( varlist.getCounter64( base + oid( 6 ) ) == 0x1234567890ULL );
+	assert( varlist.getDouble	( base + oid(10 ) ) == 1.5 );
+	assert( varlist.getDouble	( base + oid(11 ) ) == -2.25 );
+
+	SNMPpp::Varlist::const_iterator iter = varlist.begin();
+	iter ++;
+	assert( iter->getCounter32()	== 4000000000U );
+	iter ++;
+	assert( iter->getGauge32()		== 1000000000U );
+	iter ++;
+	assert( iter->getTimeTicks()	== 360000U );
+	iter ++;
+	iter ++;
+	assert( iter->getCounter64()	== 0x1234567890ULL );
+	iter ++;
+	const u_char expected[] = { 192, 168, 1, 254 };
+	const uint32_t address = iter->getIpAddress();
+	assert( memcmp( &address, expected, 4 ) == 0 );
+
+	// the strict accessors reject the other types
+	size_t exceptions = 0;
+	try { varlist.getLong		( base + oid( 2 ) ); } catch ( const std::invalid_argument &e ) { exceptions ++; }
+	try { varlist.getUnsigned	( base + oid( 1 ) ); } catch ( const std::invalid_argument &e ) { exceptions ++; }
+	try { varlist.getCounter64	( base + oid( 2 ) ); } catch ( const std::invalid_argument &e ) { exceptions ++; }
+	try { varlist.getDouble		( base + oid( 1 ) ); } catch ( const std::invalid_argument &e ) { exceptions ++; }
+	try { varlist.begin()->getCounter32();           } catch ( const std::invalid_argument &e ) { exceptions ++; }
+	assert( exceptions == 5 );
+
+	varlist.free();
+
+	return;
+}
+
+
+void checkValues( void )
+{
+	std::cout << "Checking tagged values:" << std::endl;
+
+	SNMPpp::Varlist varlist = createVarlist();
+	const SNMPpp::OID base( ".1.3.6.1.4.1.99999" );
+
+	assert( sizeof( SNMPpp::Value ) <= 16 );
+
+	const SNMPpp::Value empty;
+	assert( empty.empty() );
+	assert( empty.isNumeric() == false );
+
+	size_t numeric = 0;
+	double total = 0.0;
+	for ( const SNMPpp::Varbind &vb : varlist )
+	{
+		const SNMPpp::Value v = vb.getValue();
+		assert( v.asnType() == vb.asnType() );
+		if ( v.isNumeric() )
+		{
+			numeric ++;
+			total += v.asDouble();
+		}
+	}
+	assert( numeric == 8 );
+	assert( total == -42.0 + 4000000000.0 + 1000000000.0 + 360000.0 + 7.0 + double( 0x1234567890ULL ) + 1.5 - 2.25 );
+
+	SNMPpp::Value v = varlist.getValue( base + oid( 1 ) );
+	assert( v.getKind() == SNMPpp::Value::kSigned );
+	assert( v.asSigned() == -42 );
+
+	v = varlist.getValue( base + oid( 2 ) );
+	assert( v.getKind() == SNMPpp::Value::kUnsigned );
+	assert( v.asUnsigned() == 4000000000ULL );
+	assert( v.asSigned() == 4000000000LL );
+
+	v = varlist.getValue( base + oid( 6 ) );
+	assert( v.getKind() == SNMPpp::Value::kUnsigned );
+	assert( v.asUnsigned() == 0x1234567890ULL );
+
+	v = varlist.getValue( base + oid( 7 ) );
+	assert( v.getKind() == SNMPpp::Value::kBytes );
+	assert( v.asnType() == ASN_IPADDRESS );
+	assert( v.size() == 4 );
+	assert( v.data()[0] == 192 );
+
+	v = varlist.getValue( base + oid( 8 ) );
+	assert( v.getKind() == SNMPpp::Value::kObjectId );
+	assert( v.getOIDView() == SNMPpp::OID( ".1.3.6.1.2.1.1" ).view() );
+
+	v = varlist.getValue( base + oid( 9 ) );
+	assert( v.getKind() == SNMPpp::Value::kBytes );
+	assert( v.getBytes() == "eth0" );
+
+	v = varlist.getValue( base + oid(10 ) );
+	assert( v.getKind() == SNMPpp::Value::kDouble );
+	assert( v.asDouble() == 1.5 );
+	assert( v.asSigned() == 1 );
+
+	v = varlist.getValue( base + oid(12 ) );
+	assert( v.empty() );
+	assert( v.asnType() == ASN_NULL );
+
+	bool exceptionThrown = false;
+	try
+	{
+		v.asDouble();
+	}
+	catch ( const std::logic_error &e )
+	{
+		exceptionThrown = true;
+	}
+	assert( exceptionThrown );
+
+	// booleans are 1 and 0, instead of rfc1212's true=1 and false=2
+	long boolean = 2;
+	add( varlist, 13, ASN_BOOLEAN, &boolean, sizeof(boolean) );
+	boolean = 1;
+	add( varlist, 14, ASN_BOOLEAN, &boolean, sizeof(boolean) );
+	v = varlist.getValue( base + oid(13 ) );
+	assert( v.getKind() == SNMPpp::Value::kSigned );
+	assert( v.asSigned() == 0 );
+	v = varlist.getValue( base + oid(14 ) );
+	assert( v.asSigned() == 1 );
+
+	varlist.free();
+
+	return;
+}
+
+
+int main( int argc, char *argv[] )
+{
+	std::cout << "Test decoding of varbind values." << std::endl;
+
+	checkTypedAccessors();
+	checkValues();
+
+	std::cout << "\t...done!" << std::endl;
+
+	return 0;
+}
@@ -0,0 +1,202 @@
+// SNMPpp: https://sourceforge.net/p/snmppp/
+// SNMPpp project uses the MIT license. See LICENSE for details.
+// Copyright (C) 2013 Stephane Charette <stephanecharette@gmail.com>
+
+#include <assert.h>
+#include <string.h>
+#include <time.h>
+#include <iostream>
+#include <sstream>
+#include <SNMPpp/Varlist.hpp>
+
+
+std::string format( const u_char type, const void *value, const size_t len, const char *hint = NULL )
+{
+	SNMPpp::Varlist varlist;
+	const SNMPpp::OID o( ".1.3.6.1.4.1.99999.1" );
+	snmp_varlist_add_variable( varlist, o, o, type, value, len );
+
+	const std::string s = varlist.begin()->asString( hint );
+
+	// the buffer version must agree with the string version, and never write past the end
+	char buffer[8];
+	memset( buffer, '#', sizeof(buffer) );
+	const size_t needed = varlist.begin()->format( buffer, 4, hint );
+	assert( needed == s.size() );
+	assert( memcmp( buffer, s.c_str(), needed < 4 ? needed : 4 ) == 0 );
+	assert( buffer[4] == '#' );
+
+	varlist.free();
+
+	return s;
+}
+
+
+void checkTypes( void )
+{
+	std::cout << "Checking native formatting of each ASN type:" << std::endl;
+
+	long integer = -42;
+	assert( format( ASN_INTEGER, &integer, sizeof(integer) ) == "-42" );
+
+	long boolean = 1;
+	assert( format( ASN_BOOLEAN, &boolean, sizeof(boolean) ) == "true" );
+	boolean = 2;
+	assert( format( ASN_BOOLEAN, &boolean, sizeof(boolean) ) == "false" );
+
+	long counter = 4000000000;
+	assert( format( ASN_COUNTER, &counter, sizeof(counter) ) == "4000000000" );
+	assert( format( ASN_GAUGE, &counter, sizeof(counter) ) == "4000000000" );
+
+	long ticks = 360000;
+	assert( format( ASN_TIMETICKS, &ticks, sizeof(ticks) ) == "(360000) 1:00:00.00" );
+	ticks = 8640000 + 6000 * 61 + 1234;
+	assert( format( ASN_TIMETICKS, &ticks, sizeof(ticks) ) == "(9007234) 1 day, 1:01:12.34" );
+	ticks = 3 * 8640000 + 5;
+	assert( format( ASN_TIMETICKS, &ticks, sizeof(ticks) ) == "(25920005) 3 days, 0:00:00.05" );
+
+	struct counter64 c64;
+	c64.high = 1;
+	c64.low = 0;
+	assert( format( ASN_COUNTER64, &c64, sizeof(c64) ) == "4294967296" );
+
+	const u_char address[] = { 192, 168, 1, 254 };
+	assert( format( ASN_IPADDRESS, address, sizeof(address) ) == "192.168.1.254" );
+
+	const oid objid[] = { 1, 3, 6, 1, 2, 1, 1 };
+	assert( format( ASN_OBJECT_ID, objid, sizeof(objid) ) == ".1.3.6.1.2.1.1" );
+
+	assert( format( ASN_OCTET_STR, "eth0", 4 ) == "eth0" );
+	assert( format( ASN_OCTET_STR, "", 0 ) == "" );
+	const u_char mac[] = { 0x00, 0x1a, 0x2b, 0x3c, 0x4d, 0x5e };
+	assert( format( ASN_OCTET_STR, mac, sizeof(mac) ) == "00 1A 2B 3C 4D 5E" );
+	assert( format( ASN_OPAQUE, mac, 2 ) == "00 1A" );
+
+	float f = 1.5;
+	assert( format( ASN_OPAQUE_FLOAT, &f, sizeof(f) ) == "1.500000" );
+
+	assert( format( ASN_NULL, NULL, 0 ) == "NULL" );
+
+	// a type which needs a value, but without one
+	const u_char valueless[] = { ASN_BOOLEAN, ASN_TIMETICKS };
+	for ( size_t idx = 0; idx < sizeof(valueless); idx ++ )
+	{
+		SNMPpp::Varlist varlist;
+		const SNMPpp::OID o( ".1.3.6.1.4.1.99999.1" );
+		snmp_varlist_add_variable( varlist, o, o, valueless[idx], NULL, 0 );
+		netsnmp_variable_list *vl = varlist;
+		vl->val.integer	= NULL;
+		vl->val_len		= 0;
+		assert( varlist.begin()->asString() == "NULL" );
+		varlist.free();
+	}
+
+	return;
+}
+
+
+void checkDisplayHints( void )
+{
+	std::cout << "Checking display hints:" << std::endl;
+
+	// OCTET STRING hints from common textual conventions
+	const u_char mac[] = { 0x00, 0x1a, 0x2b, 0x3c, 0x4d, 0x5e };
+	assert( format( ASN_OCTET_STR, mac, sizeof(mac), "1x:" ) == "0:1a:2b:3c:4d:5e" );
+	const u_char ipv4[] = { 10, 0, 0, 1 };
+	assert( format( ASN_OCTET_STR, ipv4, sizeof(ipv4), "1d.1d.1d.1d" ) == "10.0.0.1" );
+	assert( format( ASN_OCTET_STR, "router1", 7, "255a" ) == "router1" );
+	assert( format( ASN_OCTET_STR, "router1", 7, "3a" ) == "router1" );
+	const u_char dateAndTime[] = { 0x07, 0xdd, 12, 25, 13, 30, 15, 0 };
+	assert( format( ASN_OCTET_STR, dateAndTime, sizeof(dateAndTime), "2d-1d-1d,1d:1d:1d.1d" ) == "2013-12-25,13:30:15.0" );
+
+	// a repeat count taken from the data, with a separator and a terminator
+	const u_char repeated[] = { 2, 1, 2, 3 };
+	assert( format( ASN_OCTET_STR, repeated, sizeof(repeated), "*1d./1d" ) == "1.2/3" );
+
+	// an invalid hint is ignored
+	assert( format( ASN_OCTET_STR, mac, 2, "zz" ) == "00 1A" );
+
+	// INTEGER hints
+	long temperature = 2345;
+	assert( format( ASN_INTEGER, &temperature, sizeof(temperature), "d-2" ) == "23.45" );
+	temperature = -5;
+	assert( format( ASN_INTEGER, &temperature, sizeof(temperature), "d-2" ) == "-0.05" );
+	long flags = 255;
+	assert( format( ASN_INTEGER, &flags, sizeof(flags), "x" ) == "ff" );
+	assert( format( ASN_INTEGER, &flags, sizeof(flags), "o" ) == "377" );
+	flags = 5;
+	assert( format( ASN_INTEGER, &flags, sizeof(flags), "b" ) == "101" );
+	assert( format( ASN_INTEGER, &flags, sizeof(flags), "d" ) == "5" );
+
+	// without MIBs there is no hint to be found
+	assert( SNMPpp::displayHint( SNMPpp::OIDView() ) == NULL );
+
+	return;
+}
+
+
+void checkPerformance( void )
+{
+	std::cout << "Checking formatting performance:" << std::endl;
+
+	// something which looks like a walk of the ifTable
+	SNMPpp::Varlist varlist;
+	for ( oid ifIndex = 1; ifIndex <= 1000; ifIndex ++ )
+	{
+		long counter = ifIndex * 1000;
+		const SNMPpp::OID o = SNMPpp::OID( ".1.3.6.1.2.1.2.2.1.10" ) + ifIndex;
+		snmp_varlist_add_variable( varlist, o, o, ASN_COUNTER, &counter, sizeof(counter) );
+		const SNMPpp::OID d = SNMPpp::OID( ".1.3.6.1.2.1.2.2.1.2" ) + ifIndex;
+		snmp_varlist_add_variable( varlist, d, d, ASN_OCTET_STR, "GigabitEthernet0/1", 18 );
+	}
+
+	const size_t iterations = 20;
+	size_t total = 0;
+	clock_t start = clock();
+	for ( size_t idx = 0; idx < iterations; idx ++ )
+	{
+		for ( const SNMPpp::Varbind &vb : varlist )
+		{
+			total += vb.asNetSnmpString().size();
+		}
+	}
+	const double netsnmp = double( clock() - start ) / CLOCKS_PER_SEC;
+
+	start = clock();
+	char buffer[256];
+	for ( size_t idx = 0; idx < iterations; idx ++ )
+	{
+		for ( const SNMPpp::Varbind &vb : varlist )
+		{
+			total += vb.format( buffer, sizeof(buffer) );
+		}
+	}
+	const double native = double( clock() - start ) / CLOCKS_PER_SEC;
+
+	std::cout << "\tformatting " << iterations * 2000 << " values: sprint_realloc_value=" << netsnmp << " seconds, format()=" << native << " seconds" << std::endl;
+	assert( total > 0 );
+
+	// operator<< uses the native formatter
+	std::stringstream ss;
+	ss << varlist;
+	assert( ss.str().find( "txt=GigabitEthernet0/1" ) != std::string::npos );
+	assert( ss.str().find( "txt=1000000" ) != std::string::npos );
+
+	varlist.free();
+
+	return;
+}
+
+
+int main( int argc, char *argv[] )
+{
+	std::cout << "Test the native value formatter." << std::endl;
+
+	checkTypes();
+	checkDisplayHints();
+	checkPerformance();
+
+	std::cout << "\t...done!" << std::endl;
+
+	return 0;
+}
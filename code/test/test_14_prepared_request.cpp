@@ -0,0 +1,182 @@
+// SNMPpp: https://sourceforge.net/p/snmppp/
+// SNMPpp project uses the MIT license. See LICENSE for details.
+// Copyright (C) 2013 Stephane Charette <stephanecharette@gmail.com>
+
+#include <assert.h>
+#include <time.h>
+#include <iostream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include <SNMPpp/PreparedRequest.hpp>
+
+
+SNMPpp::VecOID createOids( void )
+{
+	// what a typical interface poller would ask for, 10 counters for each of 20 interfaces
+	SNMPpp::VecOID v;
+	for ( oid ifIndex = 1; ifIndex <= 20; ifIndex ++ )
+	{
+		for ( oid column = 10; column < 20; column ++ )
+		{
+			v.push_back( SNMPpp::OID( ".1.3.6.1.2.1.2.2.1" ) + column + ifIndex );
+		}
+	}
+
+	return v;
+}
+
+
+void checkRequests( void )
+{
+	std::cout << "Checking prepared requests:" << std::endl;
+
+	const SNMPpp::VecOID oids = createOids();
+	const SNMPpp::PreparedRequest prepared( oids );
+	assert( prepared.getType() == SNMPpp::PDU::kGet );
+	assert( prepared.size() == oids.size() );
+
+	SNMPpp::UniquePDU request1( prepared.makeRequest() );
+	SNMPpp::UniquePDU request2( prepared.makeRequest() );
+	assert( request1.getType() == SNMPpp::PDU::kGet );
+	assert( request1.size() == oids.size() );
+	assert( request2.size() == oids.size() );
+
+	// every request is a separate PDU with its own IDs, and the OIDs in the same order
+	netsnmp_pdu *p1 = request1;
+	netsnmp_pdu *p2 = request2;
+	assert( p1 != p2 );
+	assert( p1->reqid != p2->reqid );
+	assert( p1->msgid != p2->msgid );
+	assert( p1->variables != p2->variables );
+	SNMPpp::VecOID v;
+	request1.varlist().getOids( v );
+	assert( v == oids );
+
+	// what net-snmp does to the request once it has been sent doesn't affect the next one
+	request1.free();
+	request2.free();
+	SNMPpp::UniquePDU request3( prepared.makeRequest() );
+	request3.varlist().getOids( v );
+	assert( v == oids );
+
+	// a SetOID is sorted and has no duplicates
+	SNMPpp::SetOID s( oids.rbegin(), oids.rend() );
+	s.insert( oids[0] );
+	const SNMPpp::PreparedRequest fromSet( s, SNMPpp::PDU::kGetNext );
+	assert( fromSet.getType() == SNMPpp::PDU::kGetNext );
+	assert( fromSet.size() == oids.size() );
+	assert( fromSet.varlist().firstOID() == *s.begin() );
+
+	size_t exceptions = 0;
+	try { SNMPpp::PreparedRequest( SNMPpp::VecOID() ); }		catch ( const std::invalid_argument &e ) { exceptions ++; }
+	try { SNMPpp::PreparedRequest( SNMPpp::PDU( NULL ) ); }		catch ( const std::invalid_argument &e ) { exceptions ++; }
+	assert( exceptions == 2 );
+
+	return;
+}
+
+
+void checkBulkAndSet( void )
+{
+	std::cout << "Checking prepared GETBULK and SET requests:" << std::endl;
+
+	SNMPpp::PreparedRequest bulk( SNMPpp::VecOID( 1, SNMPpp::OID( ".1.3.6.1.2.1.2.2.1.10" ) ), SNMPpp::PDU::kGetBulk );
+	bulk.setBulk( 50, 1 );
+	SNMPpp::UniquePDU request( bulk.makeRequest() );
+	netsnmp_pdu *p = request;
+	assert( request.getType() == SNMPpp::PDU::kGetBulk );
+	assert( p->errindex == 50 );
+	assert( p->errstat  == 1  );
+
+	SNMPpp::PDU pdu( SNMPpp::PDU::kSet );
+	pdu.addIntegerVar( ".1.3.6.1.2.1.2.2.1.7.1", 2 );
+	const SNMPpp::PreparedRequest set( pdu );
+	pdu.free();
+	request = set.makeRequest();
+	assert( request.getType() == SNMPpp::PDU::kSet );
+	assert( request.varlist().getLong() == 2 );
+
+	bool exceptionThrown = false;
+	try
+	{
+		SNMPpp::PreparedRequest get( SNMPpp::VecOID( 1, SNMPpp::OID( ".1.3.6.1.2.1.1.3.0" ) ) );
+		get.setBulk( 10 );
+	}
+	catch ( const std::logic_error &e )
+	{
+		exceptionThrown = true;
+	}
+	assert( exceptionThrown );
+
+	// moving leaves an empty request behind
+	SNMPpp::PreparedRequest moved( std::move( bulk ) );
+	assert( bulk.empty() );
+	assert( moved.size() == 1 );
+	exceptionThrown = false;
+	try
+	{
+		bulk.makeRequest();
+	}
+	catch ( const std::logic_error &e )
+	{
+		exceptionThrown = true;
+	}
+	assert( exceptionThrown );
+
+	return;
+}
+
+
+void checkPerformance( void )
+{
+	std::cout << "Checking the time needed to build polling requests:" << std::endl;
+
+	const SNMPpp::VecOID oids = createOids();
+	std::vector< std::string > names;
+	for ( size_t idx = 0; idx < oids.size(); idx ++ )
+	{
+		names.push_back( oids[idx].to_str() );
+	}
+	const size_t iterations = 2000;
+
+	// this is what a polling loop does without a prepared request
+	clock_t start = clock();
+	for ( size_t idx = 0; idx < iterations; idx ++ )
+	{
+		SNMPpp::PDU request( SNMPpp::PDU::kGet );
+		for ( size_t n = 0; n < names.size(); n ++ )
+		{
+			request.addNullVar( names[n] );
+		}
+		request.free();
+	}
+	const double rebuilding = double( clock() - start ) / CLOCKS_PER_SEC;
+
+	start = clock();
+	const SNMPpp::PreparedRequest prepared( oids );
+	for ( size_t idx = 0; idx < iterations; idx ++ )
+	{
+		SNMPpp::PDU request = prepared.makeRequest();
+		request.free();
+	}
+	const double cloning = double( clock() - start ) / CLOCKS_PER_SEC;
+
+	std::cout << "\t" << iterations << " requests of " << oids.size() << " OIDs: rebuilding=" << rebuilding << " seconds, PreparedRequest::makeRequest()=" << cloning << " seconds" << std::endl;
+
+	return;
+}
+
+
+int main( int argc, char *argv[] )
+{
+	std::cout << "Test prepared requests." << std::endl;
+
+	checkRequests();
+	checkBulkAndSet();
+	checkPerformance();
+
+	std::cout << "\t...done!" << std::endl;
+
+	return 0;
+}
@@ -0,0 +1,165 @@
+// SNMPpp: https://sourceforge.net/p/snmppp/
+// SNMPpp project uses the MIT license. See LICENSE for details.
+// Copyright (C) 2013 Stephane Charette <stephanecharette@gmail.com>
+
+#include <assert.h>
+#include <time.h>
+#include <iostream>
+#include <SNMPpp/ColumnarBatch.hpp>
+
+
+/// Same as snmp_varlist_add_variable(), but taking the OID as text.
+void add( SNMPpp::Varlist &varlist, const SNMPpp::OID &o, const u_char type, const void *value, const size_t len )
+{
+	snmp_varlist_add_variable( varlist, o, o, type, value, len );
+
+	return;
+}
+
+
+void checkColumns( void )
+{
+	std::cout << "Checking the columns of a batch:" << std::endl;
+
+	SNMPpp::Varlist varlist;
+	long integer = -42;
+	add( varlist, ".1.3.6.1.2.1.2.1.0", ASN_INTEGER, &integer, sizeof(integer) );
+	long counter = 4000000000;
+	add( varlist, ".1.3.6.1.2.1.2.2.1.10.1", ASN_COUNTER, &counter, sizeof(counter) );
+	add( varlist, ".1.3.6.1.2.1.2.2.1.2.1", ASN_OCTET_STR, "eth0", 4 );
+	const oid objid[] = { 1, 3, 6, 1, 4, 1, 8072, 3, 2, 10 };
+	add( varlist, ".1.3.6.1.2.1.1.2.0", ASN_OBJECT_ID, objid, sizeof(objid) );
+	struct counter64 c64;
+	c64.high = 1;
+	c64.low = 5;
+	add( varlist, ".1.3.6.1.2.1.31.1.1.1.6.1", ASN_COUNTER64, &c64, sizeof(c64) );
+	add( varlist, ".1.3.6.1.2.1.2.2.1.2.2", SNMP_NOSUCHINSTANCE, NULL, 0 );
+
+	SNMPpp::ColumnarBatch batch( varlist );
+	assert( batch.size() == 6 );
+	assert( batch.nameOffsets().size() == 7 );
+	assert( batch.valueOffsets().size() == 7 );
+	assert( batch.nameOffsets().back() == batch.nameBuffer().size() );
+
+	// every row has the same name, type and value as the varbind it came from
+	size_t row = 0;
+	for ( const SNMPpp::Varbind &vb : varlist )
+	{
+		assert( batch.name( row ) == vb.name() );
+		assert( batch.asnType( row ) == vb.asnType() );
+		assert( batch.kind( row ) == vb.getValue().getKind() );
+		row ++;
+	}
+
+	assert( batch.kind( 0 ) == SNMPpp::Value::kSigned );
+	assert( batch.asSigned( 0 ) == -42 );
+	assert( batch.asDouble( 0 ) == -42.0 );
+	assert( batch.numbers()[1] == 4000000000u );
+	assert( batch.asUnsigned( 1 ) == 4000000000u );
+	assert( batch.getBytes( 2 ) == "eth0" );
+	assert( batch.valueLength( 2 ) == 4 );
+	assert( batch.bytes( 1 ) == NULL );
+	assert( batch.getOIDView( 3 ) == SNMPpp::OIDView( objid, 10 ) );
+	assert( batch.getOIDView( 2 ).empty() );
+	assert( batch.asUnsigned( 4 ) == 4294967301ull );
+	assert( batch.kind( 5 ) == SNMPpp::Value::kNone );
+	assert( batch.asnType( 5 ) == SNMP_NOSUCHINSTANCE );
+	assert( batch.numbers()[5] == 0 );
+
+	// the strings go after the OID value without disturbing its alignment
+	add( varlist, ".1.3.6.1.2.1.2.2.1.2.3", ASN_OCTET_STR, "x", 1 );
+	add( varlist, ".1.3.6.1.2.1.1.2.0", ASN_OBJECT_ID, objid, sizeof(objid) );
+	batch.clear();
+	assert( batch.empty() );
+	batch.append( varlist );
+	assert( batch.size() == 8 );
+	assert( batch.getOIDView( 3 ) == SNMPpp::OIDView( objid, 10 ) );
+	assert( batch.getOIDView( 7 ) == SNMPpp::OIDView( objid, 10 ) );
+	assert( reinterpret_cast< uintptr_t >( batch.getOIDView( 7 ).data() ) % sizeof(oid) == 0 );
+
+	// the batch owns its copy, so the varbinds can be freed right away
+	varlist.free();
+	assert( batch.getBytes( 2 ) == "eth0" );
+
+	// responses from a walk are appended one after the other
+	SNMPpp::PDU pdu( SNMPpp::PDU::kResponse );
+	pdu.addNullVar( ".1.3.6.1.2.1.1.1.0" );
+	batch.append( pdu );
+	batch.append( pdu );
+	assert( batch.size() == 10 );
+	assert( batch.name( 9 ) == SNMPpp::OID( ".1.3.6.1.2.1.1.1.0" ).view() );
+	pdu.free();
+
+	return;
+}
+
+
+void checkPerformance( void )
+{
+	std::cout << "Checking aggregation over a batch:" << std::endl;
+
+	// something which looks like a walk of ifInOctets and ifDescr
+	SNMPpp::Varlist varlist;
+	for ( oid ifIndex = 1; ifIndex <= 5000; ifIndex ++ )
+	{
+		long counter = ifIndex * 1000;
+		add( varlist, SNMPpp::OID( ".1.3.6.1.2.1.2.2.1.10" ) + ifIndex, ASN_COUNTER, &counter, sizeof(counter) );
+		add( varlist, SNMPpp::OID( ".1.3.6.1.2.1.2.2.1.2" ) + ifIndex, ASN_OCTET_STR, "GigabitEthernet0/1", 18 );
+	}
+
+	const size_t iterations = 50;
+	uint64_t expected = 0;
+	clock_t start = clock();
+	for ( size_t idx = 0; idx < iterations; idx ++ )
+	{
+		for ( const SNMPpp::Varbind &vb : varlist )
+		{
+			if ( vb.asnType() == ASN_COUNTER )
+			{
+				expected += vb.getCounter32();
+			}
+		}
+	}
+	const double linked = double( clock() - start ) / CLOCKS_PER_SEC;
+
+	start = clock();
+	const SNMPpp::ColumnarBatch batch( varlist );
+	const double convert = double( clock() - start ) / CLOCKS_PER_SEC;
+	assert( batch.size() == 10000 );
+
+	start = clock();
+	uint64_t total = 0;
+	const std::vector< uint8_t > &kinds = batch.kinds();
+	const std::vector< uint64_t > &numbers = batch.numbers();
+	for ( size_t idx = 0; idx < iterations; idx ++ )
+	{
+		for ( size_t row = 0; row < kinds.size(); row ++ )
+		{
+			if ( kinds[row] == SNMPpp::Value::kUnsigned )
+			{
+				total += numbers[row];
+			}
+		}
+	}
+	const double columnar = double( clock() - start ) / CLOCKS_PER_SEC;
+
+	std::cout << "\tsumming " << iterations * 5000 << " counters: varlist=" << linked << " seconds, batch=" << columnar << " seconds (plus " << convert << " seconds to convert)" << std::endl;
+	assert( total == expected );
+
+	varlist.free();
+
+	return;
+}
+
+
+int main( int argc, char *argv[] )
+{
+	std::cout << "Test the columnar export of varbinds." << std::endl;
+
+	checkColumns();
+	checkPerformance();
+
+	std::cout << "\t...done!" << std::endl;
+
+	return 0;
+}
@@ -0,0 +1,196 @@
+// SNMPpp: https://sourceforge.net/p/snmppp/
+// SNMPpp project uses the MIT license. See LICENSE for details.
+// Copyright (C) 2013 Stephane Charette <stephanecharette@gmail.com>
+
+#include <assert.h>
+#include <sys/time.h>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+#include <SNMPpp/AsyncEngine.hpp>
+#include <SNMPpp/Get.hpp>
+
+
+double now( void )
+{
+	struct timeval tv;
+	gettimeofday( &tv, NULL );
+
+	return tv.tv_sec + tv.tv_usec / 1000000.0;
+}
+
+
+void testManySessions( void )
+{
+	std::cout << "Test many requests outstanding across several sessions:" << std::endl;
+
+	std::vector< SNMPpp::SessionHandle > sessions( 5, NULL );
+	for ( size_t idx = 0; idx < sessions.size(); idx ++ )
+	{
+		SNMPpp::openSession( sessions[idx], "udp:localhost:161" );
+	}
+
+	SNMPpp::AsyncEngine engine;
+	size_t replies = 0;
+	for ( size_t idx = 0; idx < 100; idx ++ )
+	{
+		SNMPpp::PDU request( SNMPpp::PDU::kGet );
+		request.addNullVar( ".1.3.6.1.2.1.1.1.0" );
+		SNMPpp::SessionHandle &session = sessions[ idx % sessions.size() ];
+		const int reqid = engine.sendAsync( session, request,
+			[ &replies, &session ]( const int status, SNMPpp::SessionHandle handle, const SNMPpp::PDU &response )
+			{
+				assert( status == STAT_SUCCESS );
+				assert( handle == session );
+				assert( response.size() == 1 );
+				assert( response.varlist().asnType( SNMPpp::OID( ".1.3.6.1.2.1.1.1.0" ) ) == ASN_OCTET_STR );
+				replies ++;
+			} );
+		assert( reqid != 0 );
+		assert( request.empty() );
+	}
+	assert( engine.outstanding() == 100 );
+	assert( engine.activeSessions() == sessions.size() );
+	assert( replies == 0 );
+
+	engine.run();
+	std::cout << "\treceived " << replies << " replies" << std::endl;
+	assert( replies == 100 );
+	assert( engine.outstanding() == 0 );
+	assert( engine.activeSessions() == 0 );
+
+	// nothing left to wait for
+	assert( engine.poll( -1 ) == 0 );
+
+	for ( size_t idx = 0; idx < sessions.size(); idx ++ )
+	{
+		SNMPpp::closeSession( sessions[idx] );
+	}
+
+	return;
+}
+
+
+void testChaining( void )
+{
+	std::cout << "Test sending the next request from within a callback:" << std::endl;
+
+	SNMPpp::SessionHandle sessionHandle = NULL;
+	SNMPpp::openSession( sessionHandle, "udp:localhost:161" );
+
+	// walk the system group one GETNEXT at a time, without blocking
+	SNMPpp::AsyncEngine engine;
+	size_t steps = 0;
+	SNMPpp::AsyncEngine::Callback next = [ & ]( const int status, SNMPpp::SessionHandle handle, const SNMPpp::PDU &response )
+	{
+		assert( status == STAT_SUCCESS );
+		steps ++;
+		if ( steps < 5 )
+		{
+			SNMPpp::PDU request( SNMPpp::PDU::kGetNext );
+			request.addNullVar( response.firstOID() );
+			engine.sendAsync( handle, request, next );
+		}
+	};
+	SNMPpp::PDU request( SNMPpp::PDU::kGetNext );
+	request.addNullVar( ".1.3.6.1.2.1.1" );
+	engine.sendAsync( sessionHandle, request, next );
+	engine.run();
+	assert( steps == 5 );
+
+	// exceptions from a callback come out of poll()
+	request = SNMPpp::PDU( SNMPpp::PDU::kGet );
+	request.addNullVar( ".1.3.6.1.2.1.1.1.0" );
+	engine.sendAsync( sessionHandle, request,
+		[]( const int, SNMPpp::SessionHandle, const SNMPpp::PDU & )
+		{
+			throw std::logic_error( "from the callback" );
+		} );
+	bool caught = false;
+	try
+	{
+		engine.run();
+	}
+	catch ( const std::logic_error & )
+	{
+		caught = true;
+	}
+	assert( caught );
+	assert( engine.outstanding() == 0 );
+
+	SNMPpp::closeSession( sessionHandle );
+
+	return;
+}
+
+
+void testDeadAgents( void )
+{
+	std::cout << "Test agents which never reply:" << std::endl;
+
+	// nothing listens on this port, so every request times out after 200ms and one retry
+	const size_t count = 10;
+	std::vector< SNMPpp::SessionHandle > sessions( count, NULL );
+	for ( size_t idx = 0; idx < count; idx ++ )
+	{
+		SNMPpp::openSession( sessions[idx], "udp:127.0.0.1:1", "public", SNMP_VERSION_2c, 1, 200000 );
+	}
+
+	SNMPpp::AsyncEngine engine;
+	size_t timeouts = 0;
+	const double start = now();
+	for ( size_t idx = 0; idx < count; idx ++ )
+	{
+		SNMPpp::PDU request( SNMPpp::PDU::kGet );
+		request.addNullVar( ".1.3.6.1.2.1.1.1.0" );
+		engine.sendAsync( sessions[idx], request,
+			[ &timeouts ]( const int status, SNMPpp::SessionHandle, const SNMPpp::PDU &response )
+			{
+				assert( status == STAT_TIMEOUT );
+				assert( response.empty() );
+				timeouts ++;
+			} );
+	}
+	engine.run();
+	const double elapsed = now() - start;
+
+	// one after the other, this would have taken count x 2 x 200ms
+	std::cout << "\t" << timeouts << " timeouts in " << elapsed << " seconds" << std::endl;
+	assert( timeouts == count );
+	assert( elapsed < count * 0.4 / 2 );
+
+	// closing a session completes its outstanding requests
+	SNMPpp::PDU request( SNMPpp::PDU::kGet );
+	request.addNullVar( ".1.3.6.1.2.1.1.1.0" );
+	engine.sendAsync( sessions[0], request,
+		[ &timeouts ]( const int status, SNMPpp::SessionHandle, const SNMPpp::PDU & )
+		{
+			assert( status == STAT_TIMEOUT );
+			timeouts ++;
+		} );
+	assert( engine.outstanding() == 1 );
+	SNMPpp::closeSession( sessions[0] );
+	assert( engine.outstanding() == 0 );
+	assert( timeouts == count + 1 );
+
+	for ( size_t idx = 1; idx < count; idx ++ )
+	{
+		SNMPpp::closeSession( sessions[idx] );
+	}
+
+	return;
+}
+
+
+int main( int argc, char *argv[] )
+{
+	std::cout << "Test the asynchronous request engine." << std::endl;
+
+	testManySessions();
+	testChaining();
+	testDeadAgents();
+
+	std::cout << "\t...done!" << std::endl;
+
+	return 0;
+}
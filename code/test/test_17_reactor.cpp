@@ -0,0 +1,211 @@
+// SNMPpp: https://sourceforge.net/p/snmppp/
+// SNMPpp project uses the MIT license. See LICENSE for details.
+// Copyright (C) 2013 Stephane Charette <stephanecharette@gmail.com>
+
+#include <assert.h>
+#include <sys/resource.h>
+#include <sys/select.h>
+#include <sys/time.h>
+#include <iostream>
+#include <vector>
+#include <SNMPpp/Reactor.hpp>
+#include <SNMPpp/Get.hpp>
+
+
+double now( void )
+{
+	struct timeval tv;
+	gettimeofday( &tv, NULL );
+
+	return tv.tv_sec + tv.tv_usec / 1000000.0;
+}
+
+
+/// Send a chain of GET requests on a single session while many other sessions wait for agents which never reply.
+double busyAmongIdle( SNMPpp::AsyncEngine &engine, const size_t idle, const size_t requests )
+{
+	std::vector< SNMPpp::SessionHandle > dead( idle, NULL );
+	size_t timeouts = 0;
+	for ( size_t idx = 0; idx < idle; idx ++ )
+	{
+		SNMPpp::openSession( dead[idx], "udp:127.0.0.1:1", "public", SNMP_VERSION_2c, 0, 60000000 );
+		SNMPpp::PDU request( SNMPpp::PDU::kGet );
+		request.addNullVar( ".1.3.6.1.2.1.1.1.0" );
+		engine.sendAsync( dead[idx], request,
+			[ &timeouts ]( const int status, SNMPpp::SessionHandle, const SNMPpp::PDU & )
+			{
+				assert( status == STAT_TIMEOUT );
+				timeouts ++;
+			} );
+	}
+
+	SNMPpp::SessionHandle sessionHandle = NULL;
+	SNMPpp::openSession( sessionHandle, "udp:localhost:161" );
+
+	size_t replies = 0;
+	SNMPpp::AsyncEngine::Callback next = [ & ]( const int status, SNMPpp::SessionHandle handle, const SNMPpp::PDU &response )
+	{
+		assert( status == STAT_SUCCESS );
+		replies ++;
+		if ( replies < requests )
+		{
+			SNMPpp::PDU request( SNMPpp::PDU::kGet );
+			request.addNullVar( ".1.3.6.1.2.1.1.1.0" );
+			engine.sendAsync( handle, request, next );
+		}
+	};
+
+	const double start = now();
+	SNMPpp::PDU request( SNMPpp::PDU::kGet );
+	request.addNullVar( ".1.3.6.1.2.1.1.1.0" );
+	engine.sendAsync( sessionHandle, request, next );
+	while ( replies < requests )
+	{
+		engine.poll( -1 );
+	}
+	const double elapsed = now() - start;
+	assert( engine.outstanding() == idle );
+
+	// closing the sessions completes the requests which were never answered
+	SNMPpp::closeSession( sessionHandle );
+	for ( size_t idx = 0; idx < idle; idx ++ )
+	{
+		SNMPpp::closeSession( dead[idx] );
+	}
+	assert( timeouts == idle );
+	assert( engine.outstanding() == 0 );
+	assert( engine.activeSessions() == 0 );
+
+	return elapsed;
+}
+
+
+void testIdleSessions( void )
+{
+	std::cout << "Test replies to one session while many others are waiting:" << std::endl;
+
+	const size_t idle = 500;
+	const size_t requests = 500;
+
+	SNMPpp::AsyncEngine engine;
+	const double selected = busyAmongIdle( engine, idle, requests );
+
+	SNMPpp::Reactor reactor;
+	const double reacted = busyAmongIdle( reactor, idle, requests );
+
+	std::cout << "\t" << requests << " replies with " << idle << " sessions waiting: select()=" << selected << " seconds, epoll=" << reacted << " seconds" << std::endl;
+
+	return;
+}
+
+
+void testManySessions( void )
+{
+	std::cout << "Test more sessions than select() can handle:" << std::endl;
+
+	// every session has a socket of its own
+	struct rlimit limit;
+	getrlimit( RLIMIT_NOFILE, &limit );
+	if ( limit.rlim_cur < 4096 && limit.rlim_cur < limit.rlim_max )
+	{
+		limit.rlim_cur = limit.rlim_max < 4096 ? limit.rlim_max : 4096;
+		setrlimit( RLIMIT_NOFILE, &limit );
+		getrlimit( RLIMIT_NOFILE, &limit );
+	}
+	const size_t count = limit.rlim_cur > 2100 ? 2000 : limit.rlim_cur - 100;
+
+	std::vector< SNMPpp::SessionHandle > sessions( count, NULL );
+	int highest = 0;
+	for ( size_t idx = 0; idx < count; idx ++ )
+	{
+		SNMPpp::openSession( sessions[idx], "udp:localhost:161" );
+		const int fd = snmp_sess_transport( sessions[idx] )->sock;
+		highest = fd > highest ? fd : highest;
+	}
+
+	SNMPpp::Reactor reactor;
+	size_t replies = 0;
+	const double start = now();
+	for ( size_t idx = 0; idx < count; idx ++ )
+	{
+		SNMPpp::PDU request( SNMPpp::PDU::kGet );
+		request.addNullVar( ".1.3.6.1.2.1.1.3.0" );
+		reactor.sendAsync( sessions[idx], request,
+			[ &replies ]( const int status, SNMPpp::SessionHandle, const SNMPpp::PDU &response )
+			{
+				assert( status == STAT_SUCCESS );
+				assert( response.size() == 1 );
+				replies ++;
+			} );
+	}
+	assert( reactor.activeSessions() == count );
+	reactor.run();
+
+	std::cout << "\t" << replies << " replies from " << count << " sessions in " << now() - start << " seconds, highest socket=" << highest << ", FD_SETSIZE=" << FD_SETSIZE << std::endl;
+	assert( replies == count );
+	assert( reactor.activeSessions() == 0 );
+
+	for ( size_t idx = 0; idx < count; idx ++ )
+	{
+		SNMPpp::closeSession( sessions[idx] );
+	}
+
+	return;
+}
+
+
+void testTimeouts( void )
+{
+	std::cout << "Test retries and timeouts driven by the reactor:" << std::endl;
+
+	// nothing listens on this port, so each request is sent twice and times out after 2 x 200ms
+	const size_t count = 50;
+	std::vector< SNMPpp::SessionHandle > sessions( count, NULL );
+	for ( size_t idx = 0; idx < count; idx ++ )
+	{
+		SNMPpp::openSession( sessions[idx], "udp:127.0.0.1:1", "public", SNMP_VERSION_2c, 1, 200000 );
+	}
+
+	SNMPpp::Reactor reactor;
+	size_t timeouts = 0;
+	const double start = now();
+	for ( size_t idx = 0; idx < count; idx ++ )
+	{
+		SNMPpp::PDU request( SNMPpp::PDU::kGet );
+		request.addNullVar( ".1.3.6.1.2.1.1.1.0" );
+		reactor.sendAsync( sessions[idx], request,
+			[ &timeouts ]( const int status, SNMPpp::SessionHandle, const SNMPpp::PDU &response )
+			{
+				assert( status == STAT_TIMEOUT );
+				assert( response.empty() );
+				timeouts ++;
+			} );
+	}
+	reactor.run();
+	const double elapsed = now() - start;
+
+	std::cout << "\t" << timeouts << " timeouts in " << elapsed << " seconds" << std::endl;
+	assert( timeouts == count );
+	assert( elapsed < 2.0 );
+
+	for ( size_t idx = 0; idx < count; idx ++ )
+	{
+		SNMPpp::closeSession( sessions[idx] );
+	}
+
+	return;
+}
+
+
+int main( int argc, char *argv[] )
+{
+	std::cout << "Test the epoll reactor." << std::endl;
+
+	testIdleSessions();
+	testTimeouts();
+	testManySessions();
+
+	std::cout << "\t...done!" << std::endl;
+
+	return 0;
+}
@@ -0,0 +1,279 @@
+// SNMPpp: https://sourceforge.net/p/snmppp/
+// SNMPpp project uses the MIT license. See LICENSE for details.
+// Copyright (C) 2013 Stephane Charette <stephanecharette@gmail.com>
+
+#include <assert.h>
+#include <sys/resource.h>
+#include <sys/time.h>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+#include <SNMPpp/SharedTransport.hpp>
+#include <SNMPpp/Reactor.hpp>
+
+
+double now( void )
+{
+	struct timeval tv;
+	gettimeofday( &tv, NULL );
+
+	return tv.tv_sec + tv.tv_usec / 1000000.0;
+}
+
+
+void testTargets( void )
+{
+	std::cout << "Test describing agents:" << std::endl;
+
+	SNMPpp::SharedTransport transport;
+	assert( transport.socketCount() == 0 );
+
+	transport.addTarget( "udp:127.0.0.1:161" );
+	transport.addTarget( "localhost" );
+	transport.addTarget( "127.0.0.1:1161", "private", SNMP_VERSION_1 );
+	assert( transport.socketCount() == 1 );
+
+	transport.addTarget( "udp6:[::1]:161" );
+	transport.addTarget( "udp6:::1" );
+	assert( transport.socketCount() == 2 );
+	assert( transport.targetCount() == 5 );
+
+	bool thrown = false;
+	try
+	{
+		transport.addTarget( "tcp:localhost:161" );
+	}
+	catch ( const std::invalid_argument &e )
+	{
+		thrown = true;
+	}
+	assert( thrown );
+
+	thrown = false;
+	try
+	{
+		transport.addTarget( "localhost", "public", SNMP_VERSION_3 );
+	}
+	catch ( const std::invalid_argument &e )
+	{
+		thrown = true;
+	}
+	assert( thrown );
+	assert( transport.targetCount() == 5 );
+
+	// the request is freed even though it cannot be sent
+	SNMPpp::PDU pdu( SNMPpp::PDU::kGet );
+	thrown = false;
+	try
+	{
+		transport.sendAsync( 99, pdu, []( const int, const size_t, const SNMPpp::PDU & ) {} );
+	}
+	catch ( const std::invalid_argument &e )
+	{
+		thrown = true;
+	}
+	assert( thrown );
+	assert( pdu.empty() );
+
+	return;
+}
+
+
+void testManyTargets( void )
+{
+	std::cout << "Test many agents sharing a single socket:" << std::endl;
+
+	// sessions each have a socket of their own
+	struct rlimit limit;
+	getrlimit( RLIMIT_NOFILE, &limit );
+	if ( limit.rlim_cur < 4096 && limit.rlim_cur < limit.rlim_max )
+	{
+		limit.rlim_cur = limit.rlim_max < 4096 ? limit.rlim_max : 4096;
+		setrlimit( RLIMIT_NOFILE, &limit );
+		getrlimit( RLIMIT_NOFILE, &limit );
+	}
+	const size_t count = limit.rlim_cur > 2100 ? 2000 : limit.rlim_cur - 100;
+
+	SNMPpp::SharedTransport transport;
+	for ( size_t idx = 0; idx < count; idx ++ )
+	{
+		transport.addTarget( "udp:localhost:161" );
+	}
+	assert( transport.socketCount() == 1 );
+
+	std::vector< size_t > answered( count, 0 );
+	double start = now();
+	for ( size_t idx = 0; idx < count; idx ++ )
+	{
+		SNMPpp::PDU request( SNMPpp::PDU::kGet );
+		request.addNullVar( ".1.3.6.1.2.1.1.3.0" );
+		transport.sendAsync( idx, request,
+			[ &answered ]( const int status, const size_t target, const SNMPpp::PDU &response )
+			{
+				assert( status == STAT_SUCCESS );
+				assert( response.size() == 1 );
+				answered[target] ++;
+			} );
+	}
+	assert( transport.outstanding() == count );
+	transport.run();
+	const double shared = now() - start;
+	for ( size_t idx = 0; idx < count; idx ++ )
+	{
+		assert( answered[idx] == 1 );
+	}
+
+	// the same requests with a session for every agent
+	std::vector< SNMPpp::SessionHandle > sessions( count, NULL );
+	start = now();
+	for ( size_t idx = 0; idx < count; idx ++ )
+	{
+		SNMPpp::openSession( sessions[idx], "udp:localhost:161" );
+	}
+	SNMPpp::Reactor reactor;
+	size_t replies = 0;
+	for ( size_t idx = 0; idx < count; idx ++ )
+	{
+		SNMPpp::PDU request( SNMPpp::PDU::kGet );
+		request.addNullVar( ".1.3.6.1.2.1.1.3.0" );
+		reactor.sendAsync( sessions[idx], request,
+			[ &replies ]( const int status, SNMPpp::SessionHandle, const SNMPpp::PDU & )
+			{
+				assert( status == STAT_SUCCESS );
+				replies ++;
+			} );
+	}
+	reactor.run();
+	for ( size_t idx = 0; idx < count; idx ++ )
+	{
+		SNMPpp::closeSession( sessions[idx] );
+	}
+	const double separate = now() - start;
+	assert( replies == count );
+
+	std::cout << "\t" << count << " agents: 1 shared socket=" << shared << " seconds, " << count << " sessions=" << separate << " seconds, " << transport.dropped() << " datagrams dropped" << std::endl;
+
+	return;
+}
+
+
+void testTimeouts( void )
+{
+	std::cout << "Test retries and timeouts of agents which never reply:" << std::endl;
+
+	// nothing listens on this port, so each request is sent twice and times out after 2 x 200ms
+	const size_t count = 50;
+	SNMPpp::SharedTransport transport;
+	for ( size_t idx = 0; idx < count; idx ++ )
+	{
+		transport.addTarget( "udp:127.0.0.1:1", "public", SNMP_VERSION_2c, 1, 200000 );
+	}
+	const size_t live = transport.addTarget( "udp:localhost:161" );
+
+	size_t timeouts = 0;
+	size_t replies = 0;
+	const double start = now();
+	for ( size_t idx = 0; idx <= count; idx ++ )
+	{
+		SNMPpp::PDU request( SNMPpp::PDU::kGet );
+		request.addNullVar( ".1.3.6.1.2.1.1.1.0" );
+		transport.sendAsync( idx, request,
+			[ &, live ]( const int status, const size_t target, const SNMPpp::PDU &response )
+			{
+				if ( target == live )
+				{
+					assert( status == STAT_SUCCESS );
+					replies ++;
+				}
+				else
+				{
+					assert( status == STAT_TIMEOUT );
+					assert( response.empty() );
+					timeouts ++;
+				}
+			} );
+	}
+	transport.run();
+	const double elapsed = now() - start;
+
+	std::cout << "\t" << timeouts << " timeouts in " << elapsed << " seconds" << std::endl;
+	assert( replies == 1 );
+	assert( timeouts == count );
+	assert( elapsed >= 0.39 );
+	assert( elapsed < 2.0 );
+
+	return;
+}
+
+
+void testCallbacks( void )
+{
+	std::cout << "Test sending from callbacks, and exceptions thrown by callbacks:" << std::endl;
+
+	SNMPpp::SharedTransport transport( 4 );
+	std::vector< size_t > targets;
+	for ( size_t idx = 0; idx < 8; idx ++ )
+	{
+		targets.push_back( transport.addTarget( "udp:localhost:161" ) );
+	}
+	assert( transport.socketCount() == 4 );
+
+	// each reply sends the next request to the next target
+	size_t replies = 0;
+	SNMPpp::SharedTransport::Callback next = [ & ]( const int status, const size_t target, const SNMPpp::PDU &response )
+	{
+		assert( status == STAT_SUCCESS );
+		replies ++;
+		if ( replies == 5 )
+		{
+			throw std::runtime_error( "fifth reply" );
+		}
+		if ( replies < 20 )
+		{
+			SNMPpp::PDU request( SNMPpp::PDU::kGet );
+			request.addNullVar( ".1.3.6.1.2.1.1.5.0" );
+			transport.sendAsync( targets[ ( target + 1 ) % targets.size() ], request, next );
+		}
+	};
+
+	SNMPpp::PDU request( SNMPpp::PDU::kGet );
+	request.addNullVar( ".1.3.6.1.2.1.1.5.0" );
+	transport.sendAsync( targets[0], request, next );
+
+	bool thrown = false;
+	try
+	{
+		transport.run();
+	}
+	catch ( const std::runtime_error &e )
+	{
+		thrown = true;
+	}
+	assert( thrown );
+	assert( replies == 5 );
+
+	// the chain stopped with the exception, so start it again
+	SNMPpp::PDU again( SNMPpp::PDU::kGet );
+	again.addNullVar( ".1.3.6.1.2.1.1.5.0" );
+	transport.sendAsync( targets[0], again, next );
+	transport.run();
+	assert( replies == 20 );
+	assert( transport.outstanding() == 0 );
+
+	return;
+}
+
+
+int main( int argc, char *argv[] )
+{
+	std::cout << "Test many agents through shared UDP sockets." << std::endl;
+
+	testTargets();
+	testTimeouts();
+	testCallbacks();
+	testManyTargets();
+
+	std::cout << "\t...done!" << std::endl;
+
+	return 0;
+}
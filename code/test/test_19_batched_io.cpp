@@ -0,0 +1,193 @@
+// SNMPpp: https://sourceforge.net/p/snmppp/
+// SNMPpp project uses the MIT license. See LICENSE for details.
+// Copyright (C) 2013 Stephane Charette <stephanecharette@gmail.com>
+
+#include <assert.h>
+#include <sys/resource.h>
+#include <sys/time.h>
+#include <iostream>
+#include <vector>
+#include <SNMPpp/SharedTransport.hpp>
+#include <SNMPpp/Reactor.hpp>
+#include "Responder.hpp"
+
+
+double now( void )
+{
+	struct timeval tv;
+	gettimeofday( &tv, NULL );
+
+	return tv.tv_sec + tv.tv_usec / 1000000.0;
+}
+
+
+/// Send the given number of requests to the agents, never more than `window` at a time, and return the datagrams per second.
+double throughputShared( const std::string &server, const size_t agents, const size_t requests, const size_t window, const size_t datagramsPerCall )
+{
+	SNMPpp::SharedTransport transport( 1, datagramsPerCall );
+	for ( size_t idx = 0; idx < agents; idx ++ )
+	{
+		transport.addTarget( server );
+	}
+
+	size_t sent = 0;
+	size_t replies = 0;
+	SNMPpp::SharedTransport::Callback next = [ & ]( const int status, const size_t target, const SNMPpp::PDU &response )
+	{
+		assert( status == STAT_SUCCESS );
+		assert( response.size() == 1 );
+		replies ++;
+		if ( sent < requests )
+		{
+			SNMPpp::PDU request( SNMPpp::PDU::kGet );
+			request.addNullVar( ".1.3.6.1.2.1.1.3.0" );
+			transport.sendAsync( sent ++ % agents, request, next );
+		}
+	};
+
+	const double start = now();
+	while ( sent < window && sent < requests )
+	{
+		SNMPpp::PDU request( SNMPpp::PDU::kGet );
+		request.addNullVar( ".1.3.6.1.2.1.1.3.0" );
+		transport.sendAsync( sent ++ % agents, request, next );
+	}
+	transport.run();
+	const double elapsed = now() - start;
+	assert( replies == requests );
+
+	return 2.0 * requests / elapsed;
+}
+
+
+/// Same as throughputShared(), but with a session and a socket for every agent.
+double throughputSessions( const std::string &server, const size_t agents, const size_t requests, const size_t window )
+{
+	std::vector< SNMPpp::SessionHandle > sessions( agents, NULL );
+	for ( size_t idx = 0; idx < agents; idx ++ )
+	{
+		SNMPpp::openSession( sessions[idx], server );
+	}
+
+	SNMPpp::Reactor reactor;
+	size_t sent = 0;
+	size_t replies = 0;
+	SNMPpp::AsyncEngine::Callback next = [ & ]( const int status, SNMPpp::SessionHandle, const SNMPpp::PDU &response )
+	{
+		assert( status == STAT_SUCCESS );
+		assert( response.size() == 1 );
+		replies ++;
+		if ( sent < requests )
+		{
+			SNMPpp::PDU request( SNMPpp::PDU::kGet );
+			request.addNullVar( ".1.3.6.1.2.1.1.3.0" );
+			reactor.sendAsync( sessions[ sent ++ % agents ], request, next );
+		}
+	};
+
+	const double start = now();
+	while ( sent < window && sent < requests )
+	{
+		SNMPpp::PDU request( SNMPpp::PDU::kGet );
+		request.addNullVar( ".1.3.6.1.2.1.1.3.0" );
+		reactor.sendAsync( sessions[ sent ++ % agents ], request, next );
+	}
+	reactor.run();
+	const double elapsed = now() - start;
+	assert( replies == requests );
+
+	for ( size_t idx = 0; idx < agents; idx ++ )
+	{
+		SNMPpp::closeSession( sessions[idx] );
+	}
+
+	return 2.0 * requests / elapsed;
+}
+
+
+void testThroughput( void )
+{
+	std::cout << "Test datagrams per second against a loopback agent:" << std::endl;
+
+	struct rlimit limit;
+	getrlimit( RLIMIT_NOFILE, &limit );
+	if ( limit.rlim_cur < 2048 && limit.rlim_cur < limit.rlim_max )
+	{
+		limit.rlim_cur = limit.rlim_max < 2048 ? limit.rlim_max : 2048;
+		setrlimit( RLIMIT_NOFILE, &limit );
+		getrlimit( RLIMIT_NOFILE, &limit );
+	}
+
+	// every session needs a descriptor, and a few more are needed for everything else
+	const size_t spare = limit.rlim_cur < 200 ? limit.rlim_cur / 2 : 100;
+	const size_t agents = limit.rlim_cur - spare > 1000 ? 1000 : limit.rlim_cur - spare;
+
+	// small enough for the agent's receive buffer, so nothing is dropped and retried
+	const size_t window = 128;
+	const size_t requests = 20000;
+
+	Responder responder;
+	const double batched = throughputShared( responder.server(), agents, requests, window, 64 );
+	const double single = throughputShared( responder.server(), agents, requests, window, 1 );
+	const double sessions = throughputSessions( responder.server(), agents, requests, window );
+
+	std::cout << "\t" << requests << " requests to " << agents << " agents, " << window << " at a time:" << std::endl
+		<< "\tshared socket, sendmmsg/recvmmsg:  " << static_cast< size_t >( batched ) << " datagrams/second" << std::endl
+		<< "\tshared socket, 1 datagram per call: " << static_cast< size_t >( single ) << " datagrams/second" << std::endl
+		<< "\ta socket per session:               " << static_cast< size_t >( sessions ) << " datagrams/second" << std::endl;
+
+	return;
+}
+
+
+void testBursts( void )
+{
+	std::cout << "Test a burst of requests larger than a batch:" << std::endl;
+
+	// more than one batch is needed both to send the burst, and to read the replies
+	Responder responder;
+	SNMPpp::SharedTransport transport( 2, 16 );
+	std::vector< size_t > answered( 100, 0 );
+	for ( size_t idx = 0; idx < answered.size(); idx ++ )
+	{
+		transport.addTarget( responder.server() );
+	}
+
+	for ( size_t idx = 0; idx < answered.size(); idx ++ )
+	{
+		SNMPpp::PDU request( SNMPpp::PDU::kGet );
+		request.addNullVar( ".1.3.6.1.2.1.1.1.0" );
+		transport.sendAsync( idx, request,
+			[ &answered ]( const int status, const size_t target, const SNMPpp::PDU & )
+			{
+				assert( status == STAT_SUCCESS );
+				answered[target] ++;
+			} );
+	}
+
+	// the requests are only queued, until they are all sent together
+	assert( transport.outstanding() == answered.size() );
+	transport.flush();
+	transport.run();
+
+	for ( size_t idx = 0; idx < answered.size(); idx ++ )
+	{
+		assert( answered[idx] == 1 );
+	}
+	assert( transport.dropped() == 0 );
+
+	return;
+}
+
+
+int main( int argc, char *argv[] )
+{
+	std::cout << "Test batched datagram I/O." << std::endl;
+
+	testBursts();
+	testThroughput();
+
+	std::cout << "\t...done!" << std::endl;
+
+	return 0;
+}
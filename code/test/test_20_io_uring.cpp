@@ -0,0 +1,168 @@
+// SNMPpp: https://sourceforge.net/p/snmppp/
+// SNMPpp project uses the MIT license. See LICENSE for details.
+// Copyright (C) 2013 Stephane Charette <stephanecharette@gmail.com>
+
+#include <assert.h>
+#include <sys/time.h>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <SNMPpp/SharedTransport.hpp>
+#include "Responder.hpp"
+
+
+double now( void )
+{
+	struct timeval tv;
+	gettimeofday( &tv, NULL );
+
+	return tv.tv_sec + tv.tv_usec / 1000000.0;
+}
+
+
+void testBackend( void )
+{
+	std::cout << "Test choosing the backend:" << std::endl;
+
+	SNMPpp::SharedTransport polled;
+	assert( polled.getBackend() == SNMPpp::SharedTransport::kEpoll );
+
+	// io_uring may not be compiled in, or not be supported by the kernel
+	SNMPpp::SharedTransport transport( 1, 64, SNMPpp::SharedTransport::kIoUring );
+	std::cout << "\tio_uring is " << ( transport.getBackend() == SNMPpp::SharedTransport::kIoUring ? "available" : "not available, using epoll" ) << std::endl;
+
+	return;
+}
+
+
+void testRequests( void )
+{
+	std::cout << "Test replies, retries and timeouts with io_uring:" << std::endl;
+
+	Responder responder;
+	SNMPpp::SharedTransport transport( 2, 16, SNMPpp::SharedTransport::kIoUring );
+	std::vector< size_t > live;
+	for ( size_t idx = 0; idx < 200; idx ++ )
+	{
+		live.push_back( transport.addTarget( responder.server() ) );
+	}
+	std::vector< size_t > dead;
+	for ( size_t idx = 0; idx < 20; idx ++ )
+	{
+		dead.push_back( transport.addTarget( "udp:127.0.0.1:1", "public", SNMP_VERSION_2c, 1, 100000 ) );
+	}
+
+	// each reply sends another request to the same agent, three times over
+	size_t replies = 0;
+	size_t timeouts = 0;
+	SNMPpp::SharedTransport::Callback callback = [ & ]( const int status, const size_t target, const SNMPpp::PDU &response )
+	{
+		if ( target >= live.size() )
+		{
+			assert( status == STAT_TIMEOUT );
+			timeouts ++;
+			return;
+		}
+
+		assert( status == STAT_SUCCESS );
+		assert( response.size() == 2 );
+		if ( ++ replies < 3 * live.size() )
+		{
+			SNMPpp::PDU request( SNMPpp::PDU::kGet );
+			request.addNullVar( ".1.3.6.1.2.1.1.1.0" );
+			request.addNullVar( ".1.3.6.1.2.1.1.3.0" );
+			transport.sendAsync( target, request, callback );
+		}
+	};
+
+	for ( size_t idx = 0; idx < live.size() + dead.size(); idx ++ )
+	{
+		SNMPpp::PDU request( SNMPpp::PDU::kGet );
+		request.addNullVar( ".1.3.6.1.2.1.1.1.0" );
+		request.addNullVar( ".1.3.6.1.2.1.1.3.0" );
+		transport.sendAsync( idx, request, callback );
+	}
+	transport.run();
+
+	assert( replies >= 3 * live.size() );
+	assert( timeouts == dead.size() );
+	assert( transport.outstanding() == 0 );
+
+	return;
+}
+
+
+/// Send the given number of requests to the responder, never more than `window` at a time, and return the datagrams per second.
+double throughput( const std::string &server, const SNMPpp::SharedTransport::EBackend backend, const size_t requests, const size_t window )
+{
+	SNMPpp::SharedTransport transport( 1, 64, backend );
+	const size_t agents = 1000;
+	for ( size_t idx = 0; idx < agents; idx ++ )
+	{
+		transport.addTarget( server );
+	}
+
+	size_t sent = 0;
+	size_t replies = 0;
+	SNMPpp::SharedTransport::Callback next = [ & ]( const int status, const size_t target, const SNMPpp::PDU &response )
+	{
+		assert( status == STAT_SUCCESS );
+		replies ++;
+		if ( sent < requests )
+		{
+			SNMPpp::PDU request( SNMPpp::PDU::kGet );
+			request.addNullVar( ".1.3.6.1.2.1.1.3.0" );
+			transport.sendAsync( sent ++ % agents, request, next );
+		}
+	};
+
+	const double start = now();
+	while ( sent < window && sent < requests )
+	{
+		SNMPpp::PDU request( SNMPpp::PDU::kGet );
+		request.addNullVar( ".1.3.6.1.2.1.1.3.0" );
+		transport.sendAsync( sent ++ % agents, request, next );
+	}
+	transport.run();
+	const double elapsed = now() - start;
+	assert( replies == requests );
+
+	return 2.0 * requests / elapsed;
+}
+
+
+void testThroughput( void )
+{
+	std::cout << "Test datagrams per second against a loopback responder:" << std::endl;
+
+	Responder responder;
+	const size_t requests = 50000;
+	const size_t window = 256;
+
+	const double polled = throughput( responder.server(), SNMPpp::SharedTransport::kEpoll, requests, window );
+	std::cout << "\t" << requests << " requests, " << window << " at a time:" << std::endl
+		<< "\tepoll with sendmmsg/recvmmsg: " << static_cast< size_t >( polled ) << " datagrams/second" << std::endl;
+
+	SNMPpp::SharedTransport probe( 1, 64, SNMPpp::SharedTransport::kIoUring );
+	if ( probe.getBackend() == SNMPpp::SharedTransport::kIoUring )
+	{
+		const double ring = throughput( responder.server(), SNMPpp::SharedTransport::kIoUring, requests, window );
+		std::cout << "\tio_uring:                     " << static_cast< size_t >( ring ) << " datagrams/second" << std::endl;
+	}
+
+	return;
+}
+
+
+int main( int argc, char *argv[] )
+{
+	std::cout << "Test the io_uring backend of the shared transport." << std::endl;
+
+	testBackend();
+	testRequests();
+	testThroughput();
+
+	std::cout << "\t...done!" << std::endl;
+
+	return 0;
+}